@@ -0,0 +1,189 @@
+#include "AUI/BVHLocatorBackend.h"
+#include "AUI/Internal/AUIAssert.h"
+#include <algorithm>
+
+namespace AUI
+{
+/** The max depth of the tree. Since we split each node at its median, this
+    is far more than we'll ever reach. */
+static constexpr std::size_t MAX_TREE_DEPTH{64};
+
+BVHLocatorBackend::BVHLocatorBackend()
+: items{}
+, itemIndices{}
+, treeItems{}
+, nodes{}
+, treeIsDirty{false}
+{
+}
+
+void BVHLocatorBackend::setExtent(const SDL_FRect&)
+{
+    // Our tree fits itself to the items, so we only need to clear.
+    clear();
+}
+
+void BVHLocatorBackend::clear()
+{
+    items.clear();
+    itemIndices.clear();
+    treeIsDirty = true;
+}
+
+void BVHLocatorBackend::addWidget(const Widget* widget,
+                                  const SDL_FRect& extent)
+{
+    itemIndices.emplace(widget, items.size());
+    items.push_back({widget, extent});
+    treeIsDirty = true;
+}
+
+void BVHLocatorBackend::moveWidget(const Widget* widget, const SDL_FRect&,
+                                   const SDL_FRect& newExtent)
+{
+    auto indexIt{itemIndices.find(widget)};
+    AUI_ASSERT(indexIt != itemIndices.end(),
+               "Tried to move a widget that isn't tracked.");
+
+    items[indexIt->second].extent = newExtent;
+    treeIsDirty = true;
+}
+
+void BVHLocatorBackend::removeWidget(const Widget* widget, const SDL_FRect&)
+{
+    auto indexIt{itemIndices.find(widget)};
+    if (indexIt == itemIndices.end()) {
+        return;
+    }
+
+    // Swap the last item into the removed item's spot.
+    std::size_t index{indexIt->second};
+    itemIndices.erase(indexIt);
+    if (index != (items.size() - 1)) {
+        items[index] = items.back();
+        itemIndices[items[index].widget] = index;
+    }
+    items.pop_back();
+    treeIsDirty = true;
+}
+
+void BVHLocatorBackend::getCandidates(
+    const SDL_FPoint& point, std::vector<const Widget*>& outCandidates,
+    QueryRegion& region) const
+{
+    if (treeIsDirty) {
+        rebuild();
+    }
+    if (nodes.empty()) {
+        return;
+    }
+
+    // Walk the tree, collecting the items in each leaf that contains the
+    // point.
+    std::uint32_t nodeStack[MAX_TREE_DEPTH * 2];
+    std::size_t stackSize{0};
+    nodeStack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node{nodes[nodeStack[--stackSize]]};
+
+        // If the node doesn't contain the point, none of its items can.
+        // Exclude it from the region, since we aren't returning its items.
+        if (!SDL_PointInRectFloat(&point, &(node.bounds))) {
+            region.exclude(node.bounds, point);
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (std::uint32_t i = node.first; i < (node.first + node.count);
+                 ++i) {
+                outCandidates.push_back(treeItems[i].widget);
+            }
+        }
+        else {
+            nodeStack[stackSize++] = node.first;
+            nodeStack[stackSize++] = node.first + 1;
+        }
+    }
+}
+
+void BVHLocatorBackend::rebuild() const
+{
+    treeItems = items;
+    nodes.clear();
+    treeIsDirty = false;
+    if (treeItems.empty()) {
+        return;
+    }
+
+    nodes.emplace_back();
+    buildNode(0, 0, static_cast<std::uint32_t>(treeItems.size()));
+}
+
+void BVHLocatorBackend::buildNode(std::uint32_t nodeIndex,
+                                  std::uint32_t begin,
+                                  std::uint32_t end) const
+{
+    // Calc the bounds of the items, and the bounds of their centers.
+    // Note: We don't use SDL_GetRectUnionFloat() since it skips empty rects.
+    const SDL_FRect& firstExtent{treeItems[begin].extent};
+    float minX{firstExtent.x};
+    float minY{firstExtent.y};
+    float maxX{minX};
+    float maxY{minY};
+    float minCenterX{firstExtent.x + (firstExtent.w / 2)};
+    float minCenterY{firstExtent.y + (firstExtent.h / 2)};
+    float maxCenterX{minCenterX};
+    float maxCenterY{minCenterY};
+    for (std::uint32_t i = begin; i < end; ++i) {
+        const SDL_FRect& extent{treeItems[i].extent};
+        float centerX{extent.x + (extent.w / 2)};
+        float centerY{extent.y + (extent.h / 2)};
+
+        minX = std::min(minX, extent.x);
+        minY = std::min(minY, extent.y);
+        maxX = std::max(maxX, (extent.x + extent.w));
+        maxY = std::max(maxY, (extent.y + extent.h));
+        minCenterX = std::min(minCenterX, centerX);
+        minCenterY = std::min(minCenterY, centerY);
+        maxCenterX = std::max(maxCenterX, centerX);
+        maxCenterY = std::max(maxCenterY, centerY);
+    }
+    nodes[nodeIndex].bounds = {minX, minY, (maxX - minX), (maxY - minY)};
+
+    // If there are few enough items, make this a leaf.
+    std::uint32_t count{end - begin};
+    if (count <= MAX_LEAF_SIZE) {
+        nodes[nodeIndex].first = begin;
+        nodes[nodeIndex].count = count;
+        return;
+    }
+
+    // Split the items at the median of the axis that their centers are most
+    // spread out along.
+    bool splitOnX{(maxCenterX - minCenterX) >= (maxCenterY - minCenterY)};
+    std::uint32_t middle{begin + (count / 2)};
+    std::nth_element(
+        (treeItems.begin() + begin), (treeItems.begin() + middle),
+        (treeItems.begin() + end),
+        [splitOnX](const Item& lhs, const Item& rhs) {
+            if (splitOnX) {
+                return ((lhs.extent.x + (lhs.extent.w / 2))
+                        < (rhs.extent.x + (rhs.extent.w / 2)));
+            }
+            return ((lhs.extent.y + (lhs.extent.h / 2))
+                    < (rhs.extent.y + (rhs.extent.h / 2)));
+        });
+
+    // Build the children.
+    // Note: We can't hold a reference to our node while building, since
+    //       adding nodes may re-allocate the vector.
+    std::uint32_t firstChild{static_cast<std::uint32_t>(nodes.size())};
+    nodes[nodeIndex].first = firstChild;
+    nodes[nodeIndex].count = 0;
+    nodes.emplace_back();
+    nodes.emplace_back();
+    buildNode(firstChild, begin, middle);
+    buildNode((firstChild + 1), middle, end);
+}
+
+} // End namespace AUI
@@ -10,6 +10,7 @@ SDL_Renderer* Core::sdlRenderer{nullptr};
 ScreenResolution Core::logicalScreenSize{};
 ScreenResolution Core::actualScreenSize{};
 std::unique_ptr<AssetCache> Core::assetCache{nullptr};
+std::unique_ptr<RenderCommandList> Core::renderCommandList{nullptr};
 float Core::dragTriggerDistance{10};
 float Core::squaredDragTriggerDistance{dragTriggerDistance
                                        * dragTriggerDistance};
@@ -22,6 +23,7 @@ void Core::initialize(SDL_Renderer* inSdlRenderer,
 {
     sdlRenderer = inSdlRenderer;
     assetCache = std::make_unique<AssetCache>();
+    renderCommandList = std::make_unique<RenderCommandList>();
 
     // Set the screen sizes.
     logicalScreenSize = inLogicalScreenSize;
@@ -46,6 +48,7 @@ void Core::quit()
 
     sdlRenderer = nullptr;
     assetCache = nullptr;
+    renderCommandList = nullptr;
 
     TTF_Quit();
 }
@@ -86,6 +89,11 @@ AssetCache& Core::getAssetCache()
     return *assetCache;
 }
 
+RenderCommandList& Core::getRenderCommandList()
+{
+    return *renderCommandList;
+}
+
 float Core::getSquaredDragTriggerDistance()
 {
     return squaredDragTriggerDistance;
@@ -0,0 +1,154 @@
+#include "AUI/GridLocatorBackend.h"
+#include "AUI/ScalingHelpers.h"
+#include <cmath>
+#include <algorithm>
+
+namespace AUI
+{
+
+GridLocatorBackend::GridLocatorBackend()
+: cellWidth{ScalingHelpers::logicalToActual(LOGICAL_DEFAULT_CELL_WIDTH)}
+, gridExtent{}
+, gridCellExtent{}
+, widgetGrid{}
+{
+}
+
+void GridLocatorBackend::setExtent(const SDL_FRect& inExtent)
+{
+    gridExtent = inExtent;
+
+    // Set our grid size to match the extent.
+    gridCellExtent = toCellExtent(gridExtent);
+
+    // Clear out the old widget locations (they're now invalid) and resize
+    // the grid to fit our new extent.
+    clear();
+    widgetGrid.resize(gridCellExtent.w * gridCellExtent.h);
+}
+
+void GridLocatorBackend::clear()
+{
+    for (auto& widgetVector : widgetGrid) {
+        widgetVector.clear();
+    }
+}
+
+void GridLocatorBackend::addWidget(const Widget* widget,
+                                   const SDL_FRect& extent)
+{
+    setWidgetLocation(widget, toCellExtent(extent));
+}
+
+void GridLocatorBackend::moveWidget(const Widget* widget,
+                                    const SDL_FRect& oldExtent,
+                                    const SDL_FRect& newExtent)
+{
+    // If the widget is still in the same cells, there's nothing to do.
+    SDL_Rect oldCellExtent{toCellExtent(oldExtent)};
+    SDL_Rect newCellExtent{toCellExtent(newExtent)};
+    if (SDL_RectsEqual(&oldCellExtent, &newCellExtent)) {
+        return;
+    }
+
+    clearWidgetLocation(widget, oldCellExtent);
+    setWidgetLocation(widget, newCellExtent);
+}
+
+void GridLocatorBackend::removeWidget(const Widget* widget,
+                                      const SDL_FRect& extent)
+{
+    clearWidgetLocation(widget, toCellExtent(extent));
+}
+
+void GridLocatorBackend::getCandidates(
+    const SDL_FPoint& point, std::vector<const Widget*>& outCandidates,
+    QueryRegion& region) const
+{
+    if (widgetGrid.empty()) {
+        return;
+    }
+
+    // Get the cell that contains the given point.
+    int hitCellX{static_cast<int>(point.x / cellWidth)};
+    int hitCellY{static_cast<int>(point.y / cellWidth)};
+    const std::vector<const Widget*>& widgetVec{
+        widgetGrid[linearizeCellIndex(hitCellX, hitCellY)]};
+    outCandidates.insert(outCandidates.end(), widgetVec.begin(),
+                         widgetVec.end());
+
+    // Any widget that overlaps the cell is in the cell's vector.
+    region.intersect({(hitCellX * cellWidth), (hitCellY * cellWidth),
+                      cellWidth, cellWidth});
+}
+
+void GridLocatorBackend::setCellWidth(float inCellWidth)
+{
+    cellWidth = inCellWidth;
+    setExtent(gridExtent);
+}
+
+SDL_Rect GridLocatorBackend::getGridCellExtent() const
+{
+    return gridCellExtent;
+}
+
+void GridLocatorBackend::setWidgetLocation(const Widget* widget,
+                                           const SDL_Rect& cellExtent)
+{
+    // Add the widget to all the cells that it occupies.
+    int xMax{cellExtent.x + cellExtent.w - 1};
+    int yMax{cellExtent.y + cellExtent.h - 1};
+    for (int x = cellExtent.x; x <= xMax; ++x) {
+        for (int y = cellExtent.y; y <= yMax; ++y) {
+            std::size_t linearizedIndex{linearizeCellIndex(x, y)};
+            widgetGrid[linearizedIndex].push_back(widget);
+        }
+    }
+}
+
+void GridLocatorBackend::clearWidgetLocation(const Widget* widget,
+                                             const SDL_Rect& cellClearExtent)
+{
+    // Iterate through all the cells that the widget occupies.
+    int xMax{cellClearExtent.x + cellClearExtent.w - 1};
+    int yMax{cellClearExtent.y + cellClearExtent.h - 1};
+    for (int x = cellClearExtent.x; x <= xMax; ++x) {
+        for (int y = cellClearExtent.y; y <= yMax; ++y) {
+            // Find the widget's location in this cell's widget vector.
+            // Note: We don't need to check the widget's validity here since
+            //       we're just comparing addresses.
+            std::size_t linearizedIndex{linearizeCellIndex(x, y)};
+            std::vector<const Widget*>& widgetVec{widgetGrid[linearizedIndex]};
+            auto widgetIt{
+                std::find(widgetVec.begin(), widgetVec.end(), widget)};
+
+            // Remove the widget from this cell's widget vector.
+            // Note: Cells are unordered, so we can swap and pop.
+            if (widgetIt != widgetVec.end()) {
+                *widgetIt = widgetVec.back();
+                widgetVec.pop_back();
+            }
+        }
+    }
+}
+
+SDL_Rect GridLocatorBackend::toCellExtent(const SDL_FRect& extent) const
+{
+    // Find the top left and bottom right cell coordinates for the extent.
+    // Note: Widgets contain the points on their edges, so an extent that
+    //       ends exactly on a cell boundary also occupies the next cell.
+    int topLeftX{static_cast<int>(std::floor(extent.x / cellWidth))};
+    int topLeftY{static_cast<int>(std::floor(extent.y / cellWidth))};
+
+    int bottomRightX{
+        static_cast<int>(std::floor((extent.x + extent.w) / cellWidth)) + 1};
+    int bottomRightY{
+        static_cast<int>(std::floor((extent.y + extent.h) / cellWidth)) + 1};
+
+    // Use the top left and bottom right to build the total cell extent.
+    return {topLeftX, topLeftY, (bottomRightX - topLeftX),
+            (bottomRightY - topLeftY)};
+}
+
+} // End namespace AUI
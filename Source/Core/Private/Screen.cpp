@@ -1,8 +1,12 @@
 #include "AUI/Screen.h"
 #include "AUI/Core.h"
 #include "AUI/Image.h"
+#include "AUI/ScalingHelpers.h"
+#include "AUI/SDLHelpers.h"
 #include "AUI/Internal/Log.h"
 #include <SDL3/SDL_rect.h>
+#include <algorithm>
+#include <cmath>
 
 namespace AUI
 {
@@ -10,6 +14,19 @@ Screen::Screen(const std::string& inDebugName)
 : debugName{inDebugName}
 , eventRouter{*this}
 , pendingFocusTarget{}
+, lastUsedScreenSize{0, 0}
+, coalescedEventCount{0}
+, dirtyRectRenderingEnabled{false}
+, dirtyRectClearColor{0, 0, 0, 0}
+, needsFullRedraw{true}
+, damage{}
+, damagedRects{}
+, lastDragDropExtent{}
+, occludedLayoutSkippingEnabled{false}
+, occluders{}
+, windowOcclusion{}
+, lastWindowOcclusion{}
+, occlusionStats{}
 {
 }
 
@@ -97,6 +114,15 @@ bool Screen::handleOSEvent(SDL_Event& event)
         case SDL_EVENT_TEXT_INPUT: {
             return eventRouter.handleTextInput(event.text);
         }
+        case SDL_EVENT_RENDER_TARGETS_RESET:
+        case SDL_EVENT_RENDER_DEVICE_RESET: {
+            // Render target contents were lost, re-render any cached windows.
+            // Note: We don't consume this, the app may need it too.
+            for (Window& window : windows) {
+                window.invalidateRender();
+            }
+            break;
+        }
         default:
             break;
     }
@@ -104,11 +130,75 @@ bool Screen::handleOSEvent(SDL_Event& event)
     return false;
 }
 
+void Screen::handleOSEvents(std::span<SDL_Event> events,
+                            std::vector<SDL_Event>* unconsumedEvents)
+{
+    coalescedEventCount = 0;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        // If this is the start of a run of motion events, skip to the end of
+        // the run.
+        if (events[i].type == SDL_EVENT_MOUSE_MOTION) {
+            std::size_t lastIndex{coalesceMouseMotion(events, i)};
+            coalescedEventCount += (lastIndex - i);
+            i = lastIndex;
+        }
+
+        // Handle the event.
+        SDL_Event& event{events[i]};
+        if (!handleOSEvent(event) && (unconsumedEvents != nullptr)) {
+            unconsumedEvents->push_back(event);
+        }
+    }
+}
+
+std::size_t Screen::getCoalescedEventCount() const
+{
+    return coalescedEventCount;
+}
+
+const EventRouter::HitTestStats& Screen::getHitTestStats() const
+{
+    return eventRouter.getHitTestStats();
+}
+
 bool Screen::onKeyDown(SDL_Keycode)
 {
     return false;
 }
 
+std::size_t Screen::coalesceMouseMotion(std::span<SDL_Event> events,
+                                        std::size_t firstIndex)
+{
+    std::size_t lastIndex{firstIndex};
+    float totalXRel{events[firstIndex].motion.xrel};
+    float totalYRel{events[firstIndex].motion.yrel};
+    while ((lastIndex + 1) < events.size()) {
+        // If this event would start a drag, it needs to be handled before
+        // any further motion.
+        const SDL_MouseMotionEvent& motion{events[lastIndex].motion};
+        if (eventRouter.wouldMouseMoveStartDrag({motion.x, motion.y})) {
+            break;
+        }
+
+        // If the next event isn't motion from the same mouse and window, the
+        // run is over.
+        const SDL_Event& nextEvent{events[lastIndex + 1]};
+        if ((nextEvent.type != SDL_EVENT_MOUSE_MOTION)
+            || (nextEvent.motion.which != motion.which)
+            || (nextEvent.motion.windowID != motion.windowID)) {
+            break;
+        }
+
+        totalXRel += nextEvent.motion.xrel;
+        totalYRel += nextEvent.motion.yrel;
+        lastIndex++;
+    }
+
+    events[lastIndex].motion.xrel = totalXRel;
+    events[lastIndex].motion.yrel = totalYRel;
+    return lastIndex;
+}
+
 void Screen::tick(double timestepS)
 {
     // Call every visible window's onTick().
@@ -123,35 +213,344 @@ void Screen::tick(double timestepS)
 
 void Screen::render()
 {
-    // Update our visible window's layouts.
-    for (Window& window : windows) {
-        if (window.getIsVisible()) {
-            window.measure();
-            window.arrange();
+    // Upload any async textures that have finished decoding, so images can
+    // swap them in this frame.
+    Core::getAssetCache().processAsyncLoads();
+
+    // If the UI scaling has changed, every window needs to be re-laid out.
+    if (lastUsedScreenSize != Core::getActualScreenSize()) {
+        for (Window& window : windows) {
+            window.invalidateMeasure();
         }
+        lastUsedScreenSize = Core::getActualScreenSize();
+        needsFullRedraw = true;
     }
 
+    // Update the layouts of any visible windows that have been invalidated,
+    // and find out which windows are hidden.
+    updateLayoutsAndOcclusion();
+
     // If we have a pending focus target, set it.
     if (pendingFocusTarget && pendingFocusTarget.value().isValid()) {
         setFocus(&(pendingFocusTarget.value().get()));
         pendingFocusTarget.reset();
     }
 
+    // If we're dragging a widget, its drag drop image will be rendered at
+    // the current mouse position.
+    Image* dragDropImage{eventRouter.getDragDropImage()};
+    SDL_FPoint cursorPosition{};
+    if (dragDropImage != nullptr) {
+        SDL_GetMouseState(&(cursorPosition.x), &(cursorPosition.y));
+    }
+
+    // Figure out which parts of the screen need to be re-drawn.
+    // Note: We do this even if dirty rect rendering is disabled, so that
+    //       our windows' damage doesn't pile up.
+    collectDamage(dragDropImage, cursorPosition);
+
+    // If dirty rect rendering is enabled, only re-draw the damaged rects.
+    if (dirtyRectRenderingEnabled) {
+        for (const SDL_Rect& damagedRect : damagedRects) {
+            renderDamagedRect(damagedRect, dragDropImage, cursorPosition);
+        }
+        return;
+    }
+
     // Render our visible windows.
+    for (std::size_t i = 0; i < windows.size(); ++i) {
+        renderWindow(i);
+    }
+
+    // If we're dragging a widget, render its drag drop image.
+    if (dragDropImage != nullptr) {
+        dragDropImage->render(cursorPosition);
+    }
+
+    // Submit any batched draw calls.
+    Core::getRenderCommandList().flush();
+}
+
+void Screen::setDirtyRectRenderingEnabled(bool inDirtyRectRenderingEnabled)
+{
+    // We don't know what's currently in the render target, so the first
+    // dirty rect frame needs to draw everything.
+    if (!dirtyRectRenderingEnabled && inDirtyRectRenderingEnabled) {
+        needsFullRedraw = true;
+    }
+
+    dirtyRectRenderingEnabled = inDirtyRectRenderingEnabled;
+}
+
+bool Screen::getDirtyRectRenderingEnabled() const
+{
+    return dirtyRectRenderingEnabled;
+}
+
+void Screen::setDirtyRectClearColor(const SDL_Color& inDirtyRectClearColor)
+{
+    dirtyRectClearColor = inDirtyRectClearColor;
+
+    // Everything that was cleared with the old color needs to be re-drawn.
+    needsFullRedraw = true;
+}
+
+const std::vector<SDL_Rect>& Screen::getDamagedRects() const
+{
+    return damagedRects;
+}
+
+void Screen::setOccludedLayoutSkippingEnabled(
+    bool inOccludedLayoutSkippingEnabled)
+{
+    occludedLayoutSkippingEnabled = inOccludedLayoutSkippingEnabled;
+}
+
+bool Screen::getOccludedLayoutSkippingEnabled() const
+{
+    return occludedLayoutSkippingEnabled;
+}
+
+const Screen::OcclusionStats& Screen::getOcclusionStats() const
+{
+    return occlusionStats;
+}
+
+void Screen::resetOcclusionStats()
+{
+    occlusionStats = {};
+}
+
+void Screen::updateLayoutsAndOcclusion()
+{
+    // Note: We go from the top window to the bottom, so that each window's
+    //       occluders are laid out by the time we reach it.
+    // Note: We keep last frame's results, so that hidden windows are only
+    //       counted in our stats when they become hidden.
+    occluders.clear();
+    lastWindowOcclusion.swap(windowOcclusion);
+    windowOcclusion.assign(windows.size(), {});
+    for (std::size_t i = windows.size(); i > 0; --i) {
+        Window& window{windows[i - 1].get()};
+        WindowOcclusion& occlusion{windowOcclusion[i - 1]};
+        occlusion.window = &window;
+        if (!(window.getIsVisible())) {
+            continue;
+        }
+
+        // Check if we're fully within an opaque extent above us.
+        // Note: Our scaledExtent may be stale until we're measured, so we
+        //       use the extent that measure() will give us.
+        SDL_FRect windowExtent{
+            ScalingHelpers::logicalToActual(window.getLogicalExtent())};
+        occlusion.occluderCount = occluders.size();
+        occlusion.isOccluded = std::any_of(
+            occluders.begin(), occluders.end(),
+            [&](const SDL_FRect& occluder) {
+                return SDLHelpers::rectContainsRect(occluder, windowExtent);
+            });
+        bool wasOccluded{(i <= lastWindowOcclusion.size())
+                         && (lastWindowOcclusion[i - 1].window == &window)
+                         && lastWindowOcclusion[i - 1].isOccluded};
+        if (occlusion.isOccluded && !wasOccluded) {
+            occlusionStats.occludedWindowCount++;
+            occlusionStats.culledWidgetCount += window.getWidgetCount();
+        }
+
+        // If we're hidden and allowed to, skip our layout. It'll be updated
+        // once we're uncovered.
+        bool layoutIsDirty{window.getIsMeasureDirty()
+                           || window.getIsArrangeDirty()};
+        if (occlusion.isOccluded && occludedLayoutSkippingEnabled) {
+            if (layoutIsDirty) {
+                occlusionStats.skippedLayoutCount++;
+            }
+            continue;
+        }
+
+        // Note: Clean windows are skipped entirely, so a static UI costs
+        //       nothing here.
+        if (window.getIsMeasureDirty()) {
+            window.measure();
+        }
+        if (window.getIsArrangeDirty()) {
+            window.arrange();
+        }
+
+        // Add our opaque extents, to hide things in the windows below us.
+        // Note: If we're hidden, anything we'd hide is already hidden.
+        if (!(occlusion.isOccluded)) {
+            window.getOpaqueExtents(occluders);
+        }
+    }
+}
+
+void Screen::renderWindow(std::size_t windowIndex)
+{
+    Window& window{windows[windowIndex].get()};
+    const WindowOcclusion& occlusion{windowOcclusion[windowIndex]};
+    if (!(window.getIsVisible()) || occlusion.isOccluded) {
+        return;
+    }
+
+    // Render the window, skipping any widgets that are hidden by the
+    // windows above it.
+    RenderCommandList& renderCommandList{Core::getRenderCommandList()};
+    std::size_t oldOccludedCount{renderCommandList.getStats().occludedCount};
+    renderCommandList.setOccluders({occluders.data(), occlusion.occluderCount});
+    window.render();
+    renderCommandList.setOccluders({});
+
+    occlusionStats.culledWidgetCount
+        += (renderCommandList.getStats().occludedCount - oldOccludedCount);
+}
+
+void Screen::collectDamage(Image* dragDropImage,
+                           const SDL_FPoint& cursorPosition)
+{
+    // Gather our windows' damage.
+    // Note: We include invisible windows, since a window that was just
+    //       hidden needs its old extent re-drawn.
+    damage.clear();
     for (Window& window : windows) {
-        if (window.getIsVisible()) {
-            window.render();
+        window.takeDamage(damage);
+    }
+
+    // If the drag drop image moved (or appeared, or disappeared), its old
+    // and new extents need to be re-drawn.
+    std::optional<SDL_FRect> dragDropExtent{};
+    if (dragDropImage != nullptr) {
+        dragDropExtent = dragDropImage->getClippedExtent();
+        dragDropExtent->x += cursorPosition.x;
+        dragDropExtent->y += cursorPosition.y;
+    }
+    bool dragDropMoved{
+        (dragDropExtent.has_value() != lastDragDropExtent.has_value())
+        || (dragDropExtent
+            && !SDL_RectsEqualFloat(&(dragDropExtent.value()),
+                                    &(lastDragDropExtent.value())))};
+    if (dragDropMoved) {
+        if (dragDropExtent) {
+            damage.push_back(dragDropExtent.value());
+        }
+        if (lastDragDropExtent) {
+            damage.push_back(lastDragDropExtent.value());
         }
     }
+    lastDragDropExtent = dragDropExtent;
 
-    // If we're dragging a widget, render its drag drop image at the current
-    // mouse position.
-    if (Image * dragDropImage{eventRouter.getDragDropImage()}) {
-        SDL_FPoint cursorPosition{};
-        SDL_GetMouseState(&(cursorPosition.x), &(cursorPosition.y));
+    // If we're drawing everything, we don't need to merge anything.
+    ScreenResolution screenSize{Core::getActualScreenSize()};
+    SDL_Rect screenRect{0, 0, screenSize.width, screenSize.height};
+    damagedRects.clear();
+    if (!dirtyRectRenderingEnabled || needsFullRedraw) {
+        damagedRects.push_back(screenRect);
+        needsFullRedraw = false;
+        return;
+    }
+
+    // Round each extent outwards to whole pixels, clip it to the screen, and
+    // merge it in.
+    for (const SDL_FRect& extent : damage) {
+        int left{static_cast<int>(std::floor(extent.x))};
+        int top{static_cast<int>(std::floor(extent.y))};
+        int right{static_cast<int>(std::ceil(extent.x + extent.w))};
+        int bottom{static_cast<int>(std::ceil(extent.y + extent.h))};
+        SDL_Rect rect{left, top, (right - left), (bottom - top)};
+        if (SDL_GetRectIntersection(&rect, &screenRect, &rect)) {
+            addDamagedRect(rect);
+        }
+    }
+
+    // If we ended up with too many rects, the per-rect overhead would
+    // outweigh what we save. Collapse them.
+    if (damagedRects.size() > MAX_DAMAGED_RECTS) {
+        SDL_Rect unionRect{damagedRects[0]};
+        for (const SDL_Rect& rect : damagedRects) {
+            SDL_GetRectUnion(&unionRect, &rect, &unionRect);
+        }
+        damagedRects.clear();
+        damagedRects.push_back(unionRect);
+    }
+}
+
+void Screen::addDamagedRect(const SDL_Rect& rect)
+{
+    // Absorb any rects that overlap the new rect. Since the new rect grows
+    // as it absorbs them, start over after each one.
+    SDL_Rect newRect{rect};
+    for (std::size_t i = 0; i < damagedRects.size();) {
+        if (SDL_HasRectIntersection(&newRect, &(damagedRects[i]))) {
+            SDL_GetRectUnion(&newRect, &(damagedRects[i]), &newRect);
+            damagedRects[i] = damagedRects.back();
+            damagedRects.pop_back();
+            i = 0;
+        }
+        else {
+            ++i;
+        }
+    }
+
+    damagedRects.push_back(newRect);
+}
+
+void Screen::renderDamagedRect(const SDL_Rect& rect, Image* dragDropImage,
+                               const SDL_FPoint& cursorPosition)
+{
+    SDL_Renderer* renderer{Core::getRenderer()};
+    RenderCommandList& renderCommandList{Core::getRenderCommandList()};
+
+    // Clip to the rect, respecting any clip rect that's already set.
+    SDL_Rect finalClipRect{rect};
+    SDL_Rect oldClipRect{};
+    bool hadClipRect{SDL_RenderClipEnabled(renderer)};
+    if (hadClipRect) {
+        SDL_GetRenderClipRect(renderer, &oldClipRect);
+        if (!SDL_GetRectIntersection(&rect, &oldClipRect, &finalClipRect)) {
+            return;
+        }
+    }
+    SDL_SetRenderClipRect(renderer, &finalClipRect);
+
+    // Cull any widgets that don't intersect the rect.
+    SDL_FRect cullExtent{};
+    SDL_RectToFRect(&finalClipRect, &cullExtent);
+    renderCommandList.setCullExtent(&cullExtent);
+
+    // Clear the rect, since everything in it is about to be re-drawn.
+    // Note: We re-apply the draw color and blend mode after, since they're
+    //       owned by the app.
+    SDL_Color originalColor{};
+    SDL_GetRenderDrawColor(renderer, &originalColor.r, &originalColor.g,
+                           &originalColor.b, &originalColor.a);
+    SDL_BlendMode originalBlendMode{};
+    SDL_GetRenderDrawBlendMode(renderer, &originalBlendMode);
+    SDL_SetRenderDrawColor(renderer, dirtyRectClearColor.r,
+                           dirtyRectClearColor.g, dirtyRectClearColor.b,
+                           dirtyRectClearColor.a);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_RenderFillRect(renderer, &cullExtent);
+    SDL_SetRenderDrawBlendMode(renderer, originalBlendMode);
+    SDL_SetRenderDrawColor(renderer, originalColor.r, originalColor.g,
+                           originalColor.b, originalColor.a);
 
+    // Render our windows that intersect the rect.
+    for (std::size_t i = 0; i < windows.size(); ++i) {
+        if (SDL_HasRectIntersectionFloat(&(windows[i].get().getScaledExtent()),
+                                         &cullExtent)) {
+            renderWindow(i);
+        }
+    }
+
+    // If we're dragging a widget, render its drag drop image.
+    if (dragDropImage != nullptr) {
         dragDropImage->render(cursorPosition);
     }
+
+    // Submit this rect's draw calls before changing the clip rect.
+    renderCommandList.flush();
+    renderCommandList.setCullExtent(nullptr);
+    SDL_SetRenderClipRect(renderer, (hadClipRect ? &oldClipRect : nullptr));
 }
 
 } // namespace AUI
@@ -1,7 +1,8 @@
 #include "AUI/Widget.h"
 #include "AUI/Core.h"
+#include "AUI/RenderCommandList.h"
 #include "AUI/ScalingHelpers.h"
-#include "AUI/WidgetWeakRef.h"
+#include "AUI/WidgetRegistry.h"
 #include "AUI/WidgetLocator.h"
 #include "AUI/Image.h"
 #include "AUI/DragDropData.h"
@@ -23,16 +24,18 @@ Widget::Widget(const SDL_FRect& inLogicalExtent, const std::string& inDebugName)
 , isFocusable{false}
 , dragDropData{nullptr}
 , children{}
-, trackedRefs{}
+, parent{nullptr}
+, measureIsDirty{true}
+, arrangeIsDirty{true}
+, renderIsDirty{true}
+, registryIndex{WidgetRegistry::add(*this)}
 {
     Core::incWidgetCount();
 }
 
 Widget::~Widget()
 {
-    for (WidgetWeakRef* ref : trackedRefs) {
-        ref->invalidate();
-    }
+    WidgetRegistry::remove(registryIndex);
 
     Core::decWidgetCount();
 }
@@ -47,7 +50,7 @@ void Widget::setLogicalExtent(const SDL_FRect& inLogicalExtent)
     // Set our logical screen extent.
     logicalExtent = inLogicalExtent;
 
-    // TODO: Invalidate the layout
+    invalidateMeasure();
 }
 
 const SDL_FRect& Widget::getLogicalExtent() const
@@ -77,7 +80,12 @@ const std::string& Widget::getDebugName() const
 
 void Widget::setIsVisible(bool inIsVisible)
 {
-    isVisible = inIsVisible;
+    // If our visibility is changing, our parent needs to re-layout to add or
+    // remove us.
+    if (isVisible != inIsVisible) {
+        isVisible = inIsVisible;
+        invalidateMeasure();
+    }
 }
 
 bool Widget::getIsVisible() const
@@ -95,6 +103,111 @@ bool Widget::getIsFocusable() const
     return isFocusable;
 }
 
+bool Widget::getIsOpaque() const
+{
+    return false;
+}
+
+void Widget::getOpaqueChildExtents(std::vector<SDL_FRect>& outExtents) const
+{
+    for (const Widget& child : children) {
+        // Skip children that won't be rendered.
+        if (!(child.isVisible) || SDL_RectEmptyFloat(&(child.clippedExtent))) {
+            continue;
+        }
+
+        // If the child is opaque, it covers all of its descendants.
+        if (child.getIsOpaque()) {
+            outExtents.push_back(child.clippedExtent);
+        }
+        else {
+            child.getOpaqueChildExtents(outExtents);
+        }
+    }
+}
+
+void Widget::invalidateMeasure()
+{
+    // Mark ourself and every ancestor up to the root window as dirty.
+    // Note: We don't stop early when we hit an already-dirty ancestor, since
+    //       invisible or clipped widgets may be left dirty after a layout
+    //       pass while their ancestors are cleaned.
+    Widget* rootWidget{this};
+    for (Widget* widget{this}; widget != nullptr; widget = widget->parent) {
+        widget->measureIsDirty = true;
+        widget->arrangeIsDirty = true;
+        rootWidget = widget;
+    }
+
+    // Our current extent needs to be re-drawn. If we end up moving, the
+    // root window will add our new extent after its arrange pass.
+    rootWidget->addDamage(clippedExtent);
+}
+
+void Widget::invalidateArrange()
+{
+    // Mark ourself and every ancestor up to the root window as dirty.
+    Widget* rootWidget{this};
+    for (Widget* widget{this}; widget != nullptr; widget = widget->parent) {
+        widget->arrangeIsDirty = true;
+        rootWidget = widget;
+    }
+
+    rootWidget->addDamage(clippedExtent);
+}
+
+void Widget::invalidateRender()
+{
+    // Only the root window tracks render dirtiness, so walk up to it.
+    Widget* rootWidget{this};
+    while (rootWidget->parent != nullptr) {
+        rootWidget = rootWidget->parent;
+    }
+    rootWidget->renderIsDirty = true;
+
+    rootWidget->addDamage(clippedExtent);
+}
+
+void Widget::invalidateOpacity()
+{
+    Widget* rootWidget{this};
+    while (rootWidget->parent != nullptr) {
+        rootWidget = rootWidget->parent;
+    }
+
+    rootWidget->onOpacityInvalidated();
+}
+
+void Widget::runWithoutInvalidatingAncestors(
+    const std::function<void()>& function)
+{
+    // Save our flags, then let our parent save its flags before calling the
+    // function. Once it returns, restore our flags.
+    // Note: We save the flags on the stack as we recurse, since this is
+    //       called during layout and we don't want to allocate.
+    bool savedMeasureIsDirty{measureIsDirty};
+    bool savedArrangeIsDirty{arrangeIsDirty};
+    if (parent != nullptr) {
+        parent->runWithoutInvalidatingAncestors(function);
+    }
+    else {
+        function();
+    }
+
+    measureIsDirty = savedMeasureIsDirty;
+    arrangeIsDirty = savedArrangeIsDirty;
+}
+
+bool Widget::getIsMeasureDirty() const
+{
+    return measureIsDirty;
+}
+
+bool Widget::getIsArrangeDirty() const
+{
+    return arrangeIsDirty;
+}
+
 Image* Widget::getDragDropImage()
 {
     return nullptr;
@@ -206,13 +319,18 @@ void Widget::onTick(double timestepS)
 
 void Widget::measure(const SDL_FRect&)
 {
+    measureIsDirty = false;
+
     // Scale our logicalExtent to get our scaledExtent.
     scaledExtent = ScalingHelpers::logicalToActual(logicalExtent);
 
     // Give our children a chance to update their logical extent.
-    // Note: We skip invisible children since they won't be rendered or receive
-    //       events.
+    // Note: We set the parent of invisible children too, so that they can
+    //       invalidate us when they're made visible.
+    // Note: We skip measuring invisible children since they won't be rendered
+    //       or receive events.
     for (Widget& child : children) {
+        child.setParent(this);
         if (child.getIsVisible()) {
             child.measure(logicalExtent);
         }
@@ -226,6 +344,7 @@ void Widget::arrange(const SDL_FPoint& startPosition,
     // Note: This logical -> clipped conversion should match ScalingHelpers::
     //       logicalToClipped(), but we don't use it because we need to save
     //       all of the intermediate extents.
+    arrangeIsDirty = false;
 
     // Offset our scaledExtent to get our fullExtent.
     fullExtent = scaledExtent;
@@ -259,8 +378,8 @@ void Widget::arrange(const SDL_FPoint& startPosition,
 
 void Widget::render(const SDL_FPoint& windowTopLeft)
 {
-    // If this widget is fully clipped, don't render it.
-    if (SDL_RectEmptyFloat(&clippedExtent)) {
+    // If this widget is fully clipped or culled, don't render it.
+    if (isRenderCulled(windowTopLeft)) {
         return;
     }
 
@@ -272,24 +391,36 @@ void Widget::render(const SDL_FPoint& windowTopLeft)
     }
 }
 
-void Widget::trackRef(WidgetWeakRef* ref)
+void Widget::addDamage(const SDL_FRect&)
+{
+    // Only windows track damage.
+}
+
+void Widget::onOpacityInvalidated()
+{
+    // Only windows track opaque extents.
+}
+
+bool Widget::isRenderCulled(const SDL_FPoint& windowTopLeft) const
 {
-    trackedRefs.push_back(ref);
+    if (SDL_RectEmptyFloat(&clippedExtent)) {
+        return true;
+    }
+
+    SDL_FRect screenExtent{clippedExtent};
+    screenExtent.x += windowTopLeft.x;
+    screenExtent.y += windowTopLeft.y;
+    return Core::getRenderCommandList().isCulled(screenExtent);
 }
 
-void Widget::untrackRef(WidgetWeakRef* ref)
+std::uint32_t Widget::getRegistryIndex() const
 {
-    auto it{std::find(trackedRefs.begin(), trackedRefs.end(), ref)};
-    AUI_ASSERT(
-        it != trackedRefs.end(),
-        "Tried to untrack ref that didn't exist in list of widget: %s - %p",
-        debugName.c_str(), ref);
-    trackedRefs.erase(it);
+    return registryIndex;
 }
 
-std::size_t Widget::getRefCount()
+void Widget::setParent(Widget* inParent)
 {
-    return trackedRefs.size();
+    parent = inParent;
 }
 
 } // namespace AUI
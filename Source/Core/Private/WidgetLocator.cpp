@@ -1,111 +1,217 @@
 #include "AUI/WidgetLocator.h"
 #include "AUI/Widget.h"
-#include "AUI/ScalingHelpers.h"
+#include "AUI/GridLocatorBackend.h"
 #include "AUI/Internal/Log.h"
 #include "AUI/Internal/AUIAssert.h"
 #include <SDL3/SDL_rect.h>
-#include <cmath>
 #include <algorithm>
 
 namespace AUI
 {
+/** The next layout epoch to give out. Shared by all locators, so that each
+    epoch is unique. */
+static std::size_t nextLayoutEpoch{1};
 
 WidgetLocator::WidgetLocator(const SDL_FRect& inScreenExtent)
-: cellWidth{ScalingHelpers::logicalToActual(LOGICAL_DEFAULT_CELL_WIDTH)}
-, gridScreenExtent{}
-, gridRelativeExtent{}
-, gridCellExtent{}
+: backend{std::make_unique<GridLocatorBackend>()}
+, screenExtent{inScreenExtent}
+, relativeExtent{0, 0, inScreenExtent.w, inScreenExtent.h}
+, widgetMap{}
+, updateIndex{0}
+, nextLayoutOrder{0}
+, updateStats{}
+, changedExtents{}
+, layoutEpoch{0}
+, candidates{}
+, hitWidgets{}
 {
-    setExtent(inScreenExtent);
+    backend->setExtent(relativeExtent);
+    bumpLayoutEpoch();
+}
+
+void WidgetLocator::beginUpdate()
+{
+    updateIndex++;
+    nextLayoutOrder = 0;
+    updateStats = {};
+    changedExtents.clear();
+}
+
+void WidgetLocator::endUpdate()
+{
+    // Remove any widgets that weren't re-added during this update.
+    for (auto it{widgetMap.begin()}; it != widgetMap.end();) {
+        if (it->second.updateIndex != updateIndex) {
+            backend->removeWidget(it->first, it->second.extent);
+            changedExtents.push_back(it->second.extent);
+            it = widgetMap.erase(it);
+            updateStats.removedCount++;
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (updateStats.removedCount > 0) {
+        bumpLayoutEpoch();
+    }
+}
+
+const WidgetLocator::UpdateStats& WidgetLocator::getUpdateStats() const
+{
+    return updateStats;
+}
+
+const std::vector<SDL_FRect>& WidgetLocator::getChangedExtents() const
+{
+    return changedExtents;
 }
 
 void WidgetLocator::addWidget(Widget* widget)
 {
     // Note: This is relative to the parent window's extent (which matches
     //       this locator's extent).
-    SDL_FRect widgetRelativeExtent{widget->getClippedExtent()};
-    AUI_ASSERT(SDL_HasRectIntersectionFloat(&widgetRelativeExtent,
-                                            &gridRelativeExtent),
+    const SDL_FRect& widgetExtent{widget->getClippedExtent()};
+    AUI_ASSERT(SDL_HasRectIntersectionFloat(&widgetExtent, &relativeExtent),
                "Tried to add a widget that is outside this locator's bounds. "
                "Widget name: %s",
                widget->getDebugName().c_str());
 
-    // Find the cells that the widget intersects.
-    SDL_Rect widgetCellExtent{screenToCellExtent(widgetRelativeExtent)};
-
-    // Add the widget to the map, or update it if it already exists for some
-    // reason.
-    widgetMap.insert_or_assign(widget, widgetCellExtent);
+    // If we aren't tracking the widget, add it.
+    auto widgetIt{widgetMap.find(widget)};
+    if (widgetIt == widgetMap.end()) {
+        widgetMap.emplace(widget, TrackedWidget{*widget, widgetExtent,
+                                                nextLayoutOrder++,
+                                                updateIndex});
+        backend->addWidget(widget, widgetExtent);
+        changedExtents.push_back(widgetExtent);
+        updateStats.addedCount++;
+        bumpLayoutEpoch();
+        return;
+    }
 
-    // Add the widget to all the cells that it occupies.
-    int xMax{widgetCellExtent.x + widgetCellExtent.w - 1};
-    int yMax{widgetCellExtent.y + widgetCellExtent.h - 1};
-    for (int x = widgetCellExtent.x; x <= xMax; ++x) {
-        for (int y = widgetCellExtent.y; y <= yMax; ++y) {
-            // Add the widget to this cell's widget array.
-            std::size_t linearizedIndex{linearizeCellIndex(x, y)};
-            std::vector<WidgetWeakRef>& widgetVec{widgetGrid[linearizedIndex]};
+    // We're already tracking the widget. Update its order.
+    // Note: Hit paths are ordered by layout order, so a change invalidates
+    //       them.
+    TrackedWidget& trackedWidget{widgetIt->second};
+    if (trackedWidget.layoutOrder != nextLayoutOrder) {
+        trackedWidget.layoutOrder = nextLayoutOrder;
+        bumpLayoutEpoch();
+    }
+    nextLayoutOrder++;
+    trackedWidget.updateIndex = updateIndex;
+
+    // If the tracked widget was destroyed and this is a new widget at the
+    // same address, refresh the ref.
+    // Note: The backend only uses the address, so it doesn't need to know.
+    if (!(trackedWidget.widgetRef.isValid())) {
+        trackedWidget.widgetRef = WidgetWeakRef{*widget};
+        changedExtents.push_back(trackedWidget.extent);
+        bumpLayoutEpoch();
+    }
 
-            widgetVec.emplace_back(*widget);
-        }
+    // If the widget moved, update its location.
+    SDL_FRect& oldExtent{trackedWidget.extent};
+    if ((oldExtent.x != widgetExtent.x) || (oldExtent.y != widgetExtent.y)
+        || (oldExtent.w != widgetExtent.w)
+        || (oldExtent.h != widgetExtent.h)) {
+        backend->moveWidget(widget, oldExtent, widgetExtent);
+        changedExtents.push_back(oldExtent);
+        changedExtents.push_back(widgetExtent);
+        oldExtent = widgetExtent;
+        updateStats.movedCount++;
+        bumpLayoutEpoch();
+    }
+    else {
+        updateStats.unchangedCount++;
     }
 }
 
 void WidgetLocator::removeWidget(Widget* widget)
 {
     // If the given widget is in the widget map, remove it from the map and
-    // from the grid.
+    // from the backend.
     auto widgetIt{widgetMap.find(widget)};
     if (widgetIt != widgetMap.end()) {
-        // Remove the widget from each cell that it's located in.
-        clearWidgetLocation(widget, widgetIt->second);
+        backend->removeWidget(widget, widgetIt->second.extent);
+        changedExtents.push_back(widgetIt->second.extent);
 
         // Remove the widget from the map.
         widgetMap.erase(widgetIt);
+        bumpLayoutEpoch();
     }
 }
 
 void WidgetLocator::clear()
 {
     widgetMap.clear();
-    for (auto& widgetVector : widgetGrid) {
-        widgetVector.clear();
-    }
+    backend->clear();
+    bumpLayoutEpoch();
 }
 
-WidgetPath WidgetLocator::getPathUnderPoint(const SDL_FPoint& actualPoint) const
+WidgetPath WidgetLocator::getPathUnderPoint(const SDL_FPoint& actualPoint,
+                                             SDL_FRect* outReuseExtent) const
 {
     AUI_ASSERT(
-        SDL_PointInRectFloat(&actualPoint, &gridScreenExtent),
+        SDL_PointInRectFloat(&actualPoint, &screenExtent),
         "Tried to get path for a point that is outside this locator's bounds.");
 
     // Convert the actual screen-space point to a window-relative point.
-    SDL_FPoint relativePoint{(actualPoint.x - gridScreenExtent.x),
-                             (actualPoint.y - gridScreenExtent.y)};
-
-    // Get the cell that contains the given point.
-    float hitCellX{relativePoint.x / cellWidth};
-    float hitCellY{relativePoint.y / cellWidth};
-    std::size_t hitCellIndex{linearizeCellIndex(static_cast<int>(hitCellX),
-                                                static_cast<int>(hitCellY))};
-    const std::vector<WidgetWeakRef>& widgetVec{widgetGrid[hitCellIndex]};
-
-    // Iterate the widgets in the cell, adding them to the path if they're
-    // still valid and contain the given point.
-    WidgetPath returnPath;
-    for (const WidgetWeakRef& widgetWeakRef : widgetVec) {
+    SDL_FPoint relativePoint{(actualPoint.x - screenExtent.x),
+                             (actualPoint.y - screenExtent.y)};
+
+    // Get the widgets that may contain the point.
+    // Note: The reuse region starts as our whole extent, and is shrunk by the
+    //       backend and by each widget that we test.
+    WidgetLocatorBackend::QueryRegion reuseRegion{0, 0, relativeExtent.w,
+                                                  relativeExtent.h};
+    candidates.clear();
+    backend->getCandidates(relativePoint, candidates, reuseRegion);
+
+    // Iterate the candidates, collecting the ones that are still valid and
+    // contain the given point.
+    hitWidgets.clear();
+    for (const Widget* widgetPtr : candidates) {
         // If the widget isn't valid, skip it.
-        if (!(widgetWeakRef.isValid())) {
+        const TrackedWidget& trackedWidget{widgetMap.at(widgetPtr)};
+        if (!(trackedWidget.widgetRef.isValid())) {
             continue;
         }
-        Widget& widget{widgetWeakRef.get()};
 
-        // If the widget contains the point, add it to the path.
+        // If the widget contains the point, save it and shrink the reuse
+        // region to fit inside it. Otherwise, shrink the region to exclude
+        // it.
+        Widget& widget{trackedWidget.widgetRef.get()};
         if (widget.containsPoint(relativePoint)) {
-            returnPath.push_back(widget);
+            hitWidgets.push_back(&trackedWidget);
+            reuseRegion.intersect(widget.getClippedExtent());
+        }
+        else {
+            reuseRegion.exclude(widget.getClippedExtent(), relativePoint);
         }
     }
 
+    if (outReuseExtent != nullptr) {
+        // Note: If the point is on an edge, this may be empty.
+        *outReuseExtent
+            = {(reuseRegion.left + screenExtent.x),
+               (reuseRegion.top + screenExtent.y),
+               std::max((reuseRegion.right - reuseRegion.left), 0.f),
+               std::max((reuseRegion.bottom - reuseRegion.top), 0.f)};
+    }
+
+    // Sort the hit widgets into layout order (root-most to leaf-most).
+    std::sort(hitWidgets.begin(), hitWidgets.end(),
+              [](const TrackedWidget* lhs, const TrackedWidget* rhs) {
+                  return (lhs->layoutOrder < rhs->layoutOrder);
+              });
+
+    // Build the path.
+    WidgetPath returnPath;
+    for (const TrackedWidget* trackedWidget : hitWidgets) {
+        returnPath.push_back(trackedWidget->widgetRef.get());
+    }
+
     return returnPath;
 }
 
@@ -119,8 +225,8 @@ WidgetPath WidgetLocator::getPathUnderWidget(const Widget* widget) const
 
     // Convert the window-relative point to screen-relative so we can use
     // getPathUnderPoint().
-    widgetCenter.x += gridScreenExtent.x;
-    widgetCenter.y += gridScreenExtent.y;
+    widgetCenter.x += screenExtent.x;
+    widgetCenter.y += screenExtent.y;
 
     // Return the path under the widget's center.
     return getPathUnderPoint(widgetCenter);
@@ -128,77 +234,66 @@ WidgetPath WidgetLocator::getPathUnderWidget(const Widget* widget) const
 
 bool WidgetLocator::containsWidget(const Widget* widget) const
 {
-    return widgetMap.contains(widget);
+    auto widgetIt{widgetMap.find(widget)};
+    return ((widgetIt != widgetMap.end())
+            && widgetIt->second.widgetRef.isValid());
+}
+
+std::size_t WidgetLocator::getWidgetCount() const
+{
+    return widgetMap.size();
 }
 
 void WidgetLocator::setExtent(const SDL_FRect& inScreenExtent)
 {
-    gridScreenExtent = inScreenExtent;
-    gridRelativeExtent = gridScreenExtent;
-    gridRelativeExtent.x = 0;
-    gridRelativeExtent.y = 0;
+    // If our extent didn't change, there's nothing to do.
+    if (SDL_RectsEqualFloat(&inScreenExtent, &screenExtent)) {
+        return;
+    }
+
+    // If only our position changed, our tracked widget locations are still
+    // valid (since they're relative to our extent).
+    bool sizeChanged{(inScreenExtent.w != screenExtent.w)
+                     || (inScreenExtent.h != screenExtent.h)};
+    screenExtent = inScreenExtent;
 
-    // Set our grid size to match the extent.
-    gridCellExtent = screenToCellExtent(gridRelativeExtent);
+    // Any screen-space results that were handed out are now invalid.
+    bumpLayoutEpoch();
+    if (!sizeChanged) {
+        return;
+    }
 
-    // Resize the grid to fit our new extent.
-    widgetGrid.resize(gridCellExtent.w * gridCellExtent.h);
+    // Clear out the old widget locations (they're now invalid) and resize
+    // the backend to fit our new extent.
+    relativeExtent = {0, 0, screenExtent.w, screenExtent.h};
+    widgetMap.clear();
+    backend->setExtent(relativeExtent);
 }
 
-void WidgetLocator::setCellWidth(float inCellWidth)
+void WidgetLocator::setBackend(std::unique_ptr<WidgetLocatorBackend> inBackend)
 {
-    cellWidth = inCellWidth;
-    clear();
+    AUI_ASSERT(inBackend != nullptr, "Tried to set a null locator backend.");
+
+    // Widgets will be re-added to the new backend during the next update.
+    backend = std::move(inBackend);
+    backend->setExtent(relativeExtent);
+    widgetMap.clear();
+    bumpLayoutEpoch();
 }
 
-SDL_Rect WidgetLocator::getGridCellExtent()
+WidgetLocatorBackend& WidgetLocator::getBackend()
 {
-    return gridCellExtent;
+    return *backend;
 }
 
-void WidgetLocator::clearWidgetLocation(const Widget* widget,
-                                        const SDL_Rect& cellClearExtent)
+std::size_t WidgetLocator::getLayoutEpoch() const
 {
-    // Iterate through all the cells that the widget occupies.
-    int xMax{cellClearExtent.x + cellClearExtent.w - 1};
-    int yMax{cellClearExtent.y + cellClearExtent.h - 1};
-    for (int x = cellClearExtent.x; x <= xMax; ++x) {
-        for (int y = cellClearExtent.y; y <= yMax; ++y) {
-            // Find the widget's location in this cell's widget vector.
-            std::size_t linearizedIndex{linearizeCellIndex(x, y)};
-            std::vector<WidgetWeakRef>& widgetVec{widgetGrid[linearizedIndex]};
-
-            auto widgetEquals{[&widget](const WidgetWeakRef& other) {
-                // Note: We don't need to check other's validity here since
-                //       we're just comparing addresses.
-                return (widget == &(other.get()));
-            }};
-            auto widgetIt{
-                std::find_if(widgetVec.begin(), widgetVec.end(), widgetEquals)};
-
-            // Remove the entity from this cell's widget vector.
-            if (widgetIt != widgetVec.end()) {
-                widgetVec.erase(widgetIt);
-            }
-        }
-    }
+    return layoutEpoch;
 }
 
-SDL_Rect WidgetLocator::screenToCellExtent(const SDL_FRect& screenExtent)
+void WidgetLocator::bumpLayoutEpoch()
 {
-    // Find the top left and bottom right cell coordinates for the screen
-    // extent.
-    int topLeftX{static_cast<int>(std::floor(screenExtent.x / cellWidth))};
-    int topLeftY{static_cast<int>(std::floor(screenExtent.y / cellWidth))};
-
-    int bottomRightX{static_cast<int>(
-        std::ceil((screenExtent.x + screenExtent.w) / cellWidth))};
-    int bottomRightY{static_cast<int>(
-        std::ceil((screenExtent.y + screenExtent.h) / cellWidth))};
-
-    // Use the top left and bottom right to build the total cell extent.
-    return {topLeftX, topLeftY, (bottomRightX - topLeftX),
-            (bottomRightY - topLeftY)};
+    layoutEpoch = nextLayoutEpoch++;
 }
 
 } // End namespace AUI
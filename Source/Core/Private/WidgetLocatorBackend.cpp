@@ -0,0 +1,35 @@
+#include "AUI/WidgetLocatorBackend.h"
+#include <algorithm>
+
+namespace AUI
+{
+
+void WidgetLocatorBackend::QueryRegion::intersect(const SDL_FRect& extent)
+{
+    left = std::max(left, extent.x);
+    top = std::max(top, extent.y);
+    right = std::min(right, (extent.x + extent.w));
+    bottom = std::min(bottom, (extent.y + extent.h));
+}
+
+void WidgetLocatorBackend::QueryRegion::exclude(const SDL_FRect& extent,
+                                                const SDL_FPoint& point)
+{
+    // Shrink along one of the axes that the point is outside of.
+    float extentRight{extent.x + extent.w};
+    float extentBottom{extent.y + extent.h};
+    if (point.x < extent.x) {
+        right = std::min(right, extent.x);
+    }
+    else if (point.x > extentRight) {
+        left = std::max(left, extentRight);
+    }
+    else if (point.y < extent.y) {
+        bottom = std::min(bottom, extent.y);
+    }
+    else {
+        top = std::max(top, extentBottom);
+    }
+}
+
+} // End namespace AUI
@@ -1,147 +1,196 @@
 #include "AUI/WidgetPath.h"
 #include "AUI/Widget.h"
 #include "AUI/Internal/AUIAssert.h"
+#include <algorithm>
 
 namespace AUI
 {
 
-WidgetPath::WidgetPath() {}
+WidgetPath::WidgetPath()
+: inlineRefs{}
+, heapRefs{}
+, refs{inlineRefs}
+, refCount{0}
+, refCapacity{INLINE_CAPACITY}
+{
+}
 
 WidgetPath::WidgetPath(const WidgetPath& other)
-: widgetRefs{other.widgetRefs}
+: WidgetPath()
 {
+    assign(other.begin(), other.end());
 }
 
 WidgetPath::WidgetPath(WidgetPath&& other)
-: widgetRefs{std::move(other.widgetRefs)}
+: WidgetPath()
 {
+    *this = std::move(other);
 }
 
 WidgetPath::WidgetPath(iterator first, iterator last)
+: WidgetPath()
 {
-    for (iterator it = first; it != last; ++it) {
-        widgetRefs.push_back(*it);
-    }
+    assign(first, last);
 }
 
 WidgetPath& WidgetPath::operator=(const WidgetPath& other)
 {
-    widgetRefs = other.widgetRefs;
+    if (this != &other) {
+        assign(other.begin(), other.end());
+    }
     return *this;
 }
 
 WidgetPath& WidgetPath::operator=(WidgetPath&& other)
 {
-    widgetRefs = other.widgetRefs;
+    if (this == &other) {
+        return *this;
+    }
+
+    // If other is using heap storage, take it. Otherwise, copy its inline
+    // storage.
+    if (other.heapRefs) {
+        heapRefs = std::move(other.heapRefs);
+        refs = heapRefs.get();
+        refCount = other.refCount;
+        refCapacity = other.refCapacity;
+
+        other.refs = other.inlineRefs;
+        other.refCapacity = INLINE_CAPACITY;
+    }
+    else {
+        assign(other.begin(), other.end());
+    }
+    other.refCount = 0;
+
     return *this;
 }
 
 void WidgetPath::push_back(Widget& widget)
 {
-    widgetRefs.emplace_back(widget);
+    reserve(refCount + 1);
+    refs[refCount] = WidgetWeakRef{widget};
+    refCount++;
 }
 
 WidgetPath::iterator WidgetPath::insert(iterator pos, Widget& widget)
 {
-    return widgetRefs.emplace(pos, widget);
+    return insert(static_cast<const_iterator>(pos), widget);
 }
 
 WidgetPath::iterator WidgetPath::insert(const_iterator pos, Widget& widget)
 {
-    return widgetRefs.emplace(pos, widget);
+    // Note: reserve() may move our storage, so we track pos as an index.
+    std::size_t index{static_cast<std::size_t>(pos - refs)};
+    reserve(refCount + 1);
+
+    // Shift the following elements back to make room.
+    std::copy_backward(refs + index, refs + refCount, refs + refCount + 1);
+    refs[index] = WidgetWeakRef{widget};
+    refCount++;
+
+    return refs + index;
 }
 
 WidgetPath::iterator WidgetPath::erase(iterator pos)
 {
-    return widgetRefs.erase(pos);
+    return erase(static_cast<const_iterator>(pos));
 }
 
 WidgetPath::iterator WidgetPath::erase(const_iterator pos)
 {
-    return widgetRefs.erase(pos);
+    // Shift the following elements forward, over the erased element.
+    std::size_t index{static_cast<std::size_t>(pos - refs)};
+    std::copy(refs + index + 1, refs + refCount, refs + index);
+    refCount--;
+
+    return refs + index;
 }
 
 void WidgetPath::clear()
 {
-    widgetRefs.clear();
+    // Note: We keep any heap storage, since paths are often re-filled.
+    refCount = 0;
 }
 
 WidgetWeakRef& WidgetPath::at(std::size_t pos)
 {
-    return widgetRefs.at(pos);
+    AUI_ASSERT(pos < refCount, "Index out of bounds: %zu", pos);
+    return refs[pos];
 }
 
 const WidgetWeakRef& WidgetPath::at(std::size_t pos) const
 {
-    return widgetRefs.at(pos);
+    AUI_ASSERT(pos < refCount, "Index out of bounds: %zu", pos);
+    return refs[pos];
 }
 
 WidgetWeakRef& WidgetPath::operator[](std::size_t pos)
 {
-    return widgetRefs[pos];
+    return refs[pos];
 }
 
 const WidgetWeakRef& WidgetPath::operator[](std::size_t pos) const
 {
-    return widgetRefs[pos];
+    return refs[pos];
 }
 
 WidgetWeakRef& WidgetPath::front()
 {
-    return widgetRefs.front();
+    return refs[0];
 }
 
 const WidgetWeakRef& WidgetPath::front() const
 {
-    return widgetRefs.front();
+    return refs[0];
 }
 
 WidgetWeakRef& WidgetPath::back()
 {
-    return widgetRefs.back();
+    return refs[refCount - 1];
 }
 
 const WidgetWeakRef& WidgetPath::back() const
 {
-    return widgetRefs.back();
+    return refs[refCount - 1];
 }
 
 bool WidgetPath::empty() const
 {
-    return widgetRefs.empty();
+    return (refCount == 0);
 }
 
 std::size_t WidgetPath::size()
 {
-    return widgetRefs.size();
+    return refCount;
 }
 
 WidgetPath::iterator WidgetPath::find(const Widget* widget)
 {
-    for (auto it = widgetRefs.begin(); it != widgetRefs.end(); ++it) {
-        if (&(it->get()) == widget) {
+    for (auto it = begin(); it != end(); ++it) {
+        if (it->isValid() && (&(it->get()) == widget)) {
             return it;
         }
     }
 
-    return widgetRefs.end();
+    return end();
 }
 
 WidgetPath::const_iterator WidgetPath::find(const Widget* widget) const
 {
-    for (auto it = widgetRefs.begin(); it != widgetRefs.end(); ++it) {
-        if (&(it->get()) == widget) {
+    for (auto it = begin(); it != end(); ++it) {
+        if (it->isValid() && (&(it->get()) == widget)) {
             return it;
         }
     }
 
-    return widgetRefs.end();
+    return end();
 }
 
 bool WidgetPath::contains(const Widget* widget) const
 {
-    for (auto it = widgetRefs.begin(); it != widgetRefs.end(); ++it) {
-        if (&(it->get()) == widget) {
+    for (auto it = begin(); it != end(); ++it) {
+        if (it->isValid() && (&(it->get()) == widget)) {
             return true;
         }
     }
@@ -151,62 +200,86 @@ bool WidgetPath::contains(const Widget* widget) const
 
 WidgetPath::iterator WidgetPath::begin()
 {
-    return widgetRefs.begin();
+    return refs;
 }
 
 WidgetPath::const_iterator WidgetPath::begin() const
 {
-    return widgetRefs.begin();
+    return refs;
 }
 
 WidgetPath::const_iterator WidgetPath::cbegin() const
 {
-    return widgetRefs.begin();
+    return refs;
 }
 
 WidgetPath::iterator WidgetPath::end()
 {
-    return widgetRefs.end();
+    return (refs + refCount);
 }
 
 WidgetPath::const_iterator WidgetPath::end() const
 {
-    return widgetRefs.end();
+    return (refs + refCount);
 }
 
 WidgetPath::const_iterator WidgetPath::cend() const
 {
-    return widgetRefs.end();
+    return (refs + refCount);
 }
 
 WidgetPath::reverse_iterator WidgetPath::rbegin()
 {
-    return widgetRefs.rbegin();
+    return reverse_iterator{end()};
 }
 
 WidgetPath::const_reverse_iterator WidgetPath::rbegin() const
 {
-    return widgetRefs.rbegin();
+    return const_reverse_iterator{end()};
 }
 
 WidgetPath::const_reverse_iterator WidgetPath::crbegin() const
 {
-    return widgetRefs.rbegin();
+    return const_reverse_iterator{end()};
 }
 
 WidgetPath::reverse_iterator WidgetPath::rend()
 {
-    return widgetRefs.rend();
+    return reverse_iterator{begin()};
 }
 
 WidgetPath::const_reverse_iterator WidgetPath::rend() const
 {
-    return widgetRefs.rend();
+    return const_reverse_iterator{begin()};
 }
 
 WidgetPath::const_reverse_iterator WidgetPath::crend() const
 {
-    return widgetRefs.rend();
+    return const_reverse_iterator{begin()};
+}
+
+void WidgetPath::assign(const_iterator first, const_iterator last)
+{
+    std::size_t newCount{static_cast<std::size_t>(last - first)};
+    reserve(newCount);
+    std::copy(first, last, refs);
+    refCount = newCount;
+}
+
+void WidgetPath::reserve(std::size_t minCapacity)
+{
+    if (minCapacity <= refCapacity) {
+        return;
+    }
+
+    // Move to a larger heap buffer.
+    std::size_t newCapacity{std::max(minCapacity, (refCapacity * 2))};
+    std::unique_ptr<WidgetWeakRef[]> newRefs{new WidgetWeakRef[newCapacity]};
+    std::copy(refs, (refs + refCount), newRefs.get());
+
+    heapRefs = std::move(newRefs);
+    refs = heapRefs.get();
+    refCapacity = newCapacity;
 }
 
 } // End namespace AUI
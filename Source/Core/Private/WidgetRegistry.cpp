@@ -0,0 +1,44 @@
+#include "AUI/WidgetRegistry.h"
+#include "AUI/Internal/AUIAssert.h"
+
+namespace AUI
+{
+std::vector<WidgetRegistry::Slot> WidgetRegistry::slots{};
+std::vector<std::uint32_t> WidgetRegistry::freeIndices{};
+
+std::uint32_t WidgetRegistry::add(Widget& widget)
+{
+    // If there's a free slot, reuse it.
+    if (!(freeIndices.empty())) {
+        std::uint32_t index{freeIndices.back()};
+        freeIndices.pop_back();
+        slots[index].widget = &widget;
+        return index;
+    }
+
+    // No free slots, add a new one.
+    slots.push_back({&widget, 0});
+    return static_cast<std::uint32_t>(slots.size() - 1);
+}
+
+void WidgetRegistry::remove(std::uint32_t index)
+{
+    AUI_ASSERT(slots[index].widget != nullptr,
+               "Tried to remove widget from empty slot: %u", index);
+
+    // Bump the generation to invalidate any refs to this widget.
+    // Note: The generation may eventually wrap around, but a stale ref would
+    //       need to survive 2^32 widgets in the same slot to be affected.
+    Slot& slot{slots[index]};
+    slot.widget = nullptr;
+    slot.generation++;
+
+    freeIndices.push_back(index);
+}
+
+std::size_t WidgetRegistry::getSlotCount()
+{
+    return slots.size();
+}
+
+} // End namespace AUI
@@ -1,89 +1,26 @@
 #include "AUI/WidgetWeakRef.h"
 #include "AUI/Widget.h"
-#include "AUI/Core.h"
+#include "AUI/WidgetRegistry.h"
+#include "AUI/Internal/AUIAssert.h"
 
 namespace AUI
 {
 
 WidgetWeakRef::WidgetWeakRef(Widget& inWidget)
-: widget{&inWidget}
-, widgetIsValid{true}
+: index{inWidget.getRegistryIndex()}
+, generation{WidgetRegistry::getGeneration(index)}
 {
-    widget->trackRef(this);
-}
-
-WidgetWeakRef::WidgetWeakRef(const WidgetWeakRef& other)
-: widget{other.widget}
-, widgetIsValid{other.widgetIsValid}
-{
-    if (widgetIsValid) {
-        widget->trackRef(this);
-    }
-}
-
-WidgetWeakRef::WidgetWeakRef(WidgetWeakRef&& other)
-: widget{other.widget}
-, widgetIsValid{other.widgetIsValid}
-{
-    if (widgetIsValid) {
-        widget->untrackRef(&other);
-        other.widgetIsValid = false;
-
-        widget->trackRef(this);
-    }
-}
-
-WidgetWeakRef::~WidgetWeakRef()
-{
-    if (widgetIsValid) {
-        widget->untrackRef(this);
-    }
-}
-
-WidgetWeakRef& WidgetWeakRef::operator=(const WidgetWeakRef& other)
-{
-    if (widgetIsValid) {
-        widget->untrackRef(this);
-    }
-
-    widget = other.widget;
-    widgetIsValid = other.widgetIsValid;
-    if (widgetIsValid) {
-        widget->trackRef(this);
-    }
-    return *this;
-}
-
-WidgetWeakRef& WidgetWeakRef::operator=(WidgetWeakRef&& other)
-{
-    if (widgetIsValid) {
-        widget->untrackRef(this);
-    }
-
-    widget = other.widget;
-    widgetIsValid = other.widgetIsValid;
-    if (widgetIsValid) {
-        widget->untrackRef(&other);
-        other.widgetIsValid = false;
-
-        widget->trackRef(this);
-    }
-    return *this;
 }
 
 bool WidgetWeakRef::isValid() const
 {
-    return widgetIsValid;
+    return (WidgetRegistry::getGeneration(index) == generation);
 }
 
 Widget& WidgetWeakRef::get() const
 {
-    return *widget;
-}
-
-void WidgetWeakRef::invalidate()
-{
-    widgetIsValid = false;
+    AUI_ASSERT(isValid(), "Tried to get widget from invalid ref.");
+    return *(WidgetRegistry::getWidget(index));
 }
 
 } // End namespace AUI
@@ -1,18 +1,29 @@
 #include "AUI/Window.h"
+#include "AUI/Core.h"
+#include "AUI/RenderCommandList.h"
 #include "AUI/ScalingHelpers.h"
 #include "AUI/Internal/Log.h"
+#include <cmath>
 
 namespace AUI
 {
 Window::Window(const SDL_FRect& inLogicalExtent, const std::string& inDebugName)
 : Widget(inLogicalExtent, inDebugName)
 , widgetLocator{ScalingHelpers::logicalToActual(inLogicalExtent)}
+, isRenderCached{false}
+, renderCacheTexture{}
+, renderCacheStats{}
+, opaqueLogicalExtents{}
+, opaqueExtents{}
+, opaqueExtentsAreDirty{true}
+, damage{}
 {
 }
 
-WidgetPath Window::getPathUnderPoint(const SDL_FPoint& actualPoint) const
+WidgetPath Window::getPathUnderPoint(const SDL_FPoint& actualPoint,
+                                     SDL_FRect* outReuseExtent) const
 {
-    return widgetLocator.getPathUnderPoint(actualPoint);
+    return widgetLocator.getPathUnderPoint(actualPoint, outReuseExtent);
 }
 
 WidgetPath Window::getPathUnderWidget(const Widget* widget) const
@@ -22,15 +33,28 @@ WidgetPath Window::getPathUnderWidget(const Widget* widget) const
 
 void Window::measure()
 {
+    measureIsDirty = false;
+
     // Scale our logicalExtent to get our scaledExtent.
     // Windows don't have a parent, so scaledExtent is their final extent in
     // the layout.
+    SDL_FRect oldScaledExtent{scaledExtent};
     scaledExtent = ScalingHelpers::logicalToActual(logicalExtent);
 
+    // If we moved or resized, both our old and new extents need to be
+    // re-drawn.
+    if (!SDL_RectsEqualFloat(&oldScaledExtent, &scaledExtent)) {
+        addScreenDamage(oldScaledExtent);
+        addScreenDamage(scaledExtent);
+    }
+
     // Give our children a chance to update their logical extent.
-    // Note: We skip invisible children since they won't be rendered or receive
-    //       events.
+    // Note: We set the parent of invisible children too, so that they can
+    //       invalidate us when they're made visible.
+    // Note: We skip measuring invisible children since they won't be rendered
+    //       or receive events.
     for (Widget& child : children) {
+        child.setParent(this);
         if (child.getIsVisible()) {
             child.measure(logicalExtent);
         }
@@ -39,6 +63,13 @@ void Window::measure()
 
 void Window::arrange()
 {
+    arrangeIsDirty = false;
+
+    // Our children may have moved, so our render cache and opaque extents
+    // are stale.
+    renderIsDirty = true;
+    opaqueExtentsAreDirty = true;
+
     // fullExtent and clippedExtent are window-relative, so we need to 0-out
     // their position. This is important for the locator to work correctly.
     fullExtent = scaledExtent;
@@ -46,12 +77,14 @@ void Window::arrange()
     fullExtent.y = 0;
     clippedExtent = fullExtent;
 
-    // Clear the locator, to prepare for widgets re-adding themselves.
-    widgetLocator.clear();
-
     // Update the locator to match our current screen extent.
+    // Note: If our size changed, this will clear the locator.
     widgetLocator.setExtent(scaledExtent);
 
+    // Begin an incremental locator update. Widgets will re-add themselves as
+    // they're arranged, and only the ones that moved will be relocated.
+    widgetLocator.beginUpdate();
+
     // Add ourself to the locator.
     widgetLocator.addWidget(this);
 
@@ -66,6 +99,15 @@ void Window::arrange()
             child.arrange({0, 0}, availableExtent, &widgetLocator);
         }
     }
+
+    // Remove any widgets that are no longer in the layout (e.g. they were
+    // made invisible or were clipped).
+    widgetLocator.endUpdate();
+
+    // Anything that was added, moved, or removed needs to be re-drawn.
+    for (const SDL_FRect& changedExtent : widgetLocator.getChangedExtents()) {
+        addDamage(changedExtent);
+    }
 }
 
 bool Window::containsWidget(const Widget* widget) const
@@ -73,14 +115,244 @@ bool Window::containsWidget(const Widget* widget) const
     return widgetLocator.containsWidget(widget);
 }
 
+std::size_t Window::getLayoutEpoch() const
+{
+    return widgetLocator.getLayoutEpoch();
+}
+
+void Window::setLocatorBackend(std::unique_ptr<WidgetLocatorBackend> inBackend)
+{
+    widgetLocator.setBackend(std::move(inBackend));
+
+    // Re-arrange so our widgets get added to the new backend.
+    invalidateArrange();
+}
+
+void Window::setIsRenderCached(bool inIsRenderCached)
+{
+    isRenderCached = inIsRenderCached;
+    renderIsDirty = true;
+
+    // If caching was disabled, free the texture.
+    if (!isRenderCached) {
+        renderCacheTexture = nullptr;
+    }
+}
+
+bool Window::getIsRenderCached() const
+{
+    return isRenderCached;
+}
+
+const Window::RenderCacheStats& Window::getRenderCacheStats() const
+{
+    return renderCacheStats;
+}
+
+void Window::resetRenderCacheStats()
+{
+    renderCacheStats = {};
+}
+
+void Window::setOpaqueLogicalExtents(
+    const std::vector<SDL_FRect>& inOpaqueLogicalExtents)
+{
+    opaqueLogicalExtents = inOpaqueLogicalExtents;
+    opaqueExtentsAreDirty = true;
+
+    // Windows underneath us may have been skipped, so our whole extent
+    // needs to be re-drawn.
+    addDamage(clippedExtent);
+}
+
+void Window::getOpaqueExtents(std::vector<SDL_FRect>& outOpaqueExtents)
+{
+    // If something changed since we last gathered our extents, re-gather
+    // them. Otherwise, we can skip walking our widget tree.
+    if (opaqueExtentsAreDirty) {
+        opaqueExtents.clear();
+
+        // Add our declared extents, clipped to our bounds.
+        for (const SDL_FRect& logicalExtent : opaqueLogicalExtents) {
+            SDL_FRect extent{ScalingHelpers::logicalToActual(logicalExtent)};
+            extent.x += scaledExtent.x;
+            extent.y += scaledExtent.y;
+            if (SDL_GetRectIntersectionFloat(&extent, &scaledExtent,
+                                             &extent)) {
+                opaqueExtents.push_back(extent);
+            }
+        }
+
+        // Add any opaque widgets in our tree, offsetting them from
+        // window-relative to screen space.
+        std::size_t firstChildIndex{opaqueExtents.size()};
+        getOpaqueChildExtents(opaqueExtents);
+        for (std::size_t i{firstChildIndex}; i < opaqueExtents.size(); ++i) {
+            opaqueExtents[i].x += scaledExtent.x;
+            opaqueExtents[i].y += scaledExtent.y;
+        }
+
+        opaqueExtentsAreDirty = false;
+    }
+
+    outOpaqueExtents.insert(outOpaqueExtents.end(), opaqueExtents.begin(),
+                            opaqueExtents.end());
+}
+
+std::size_t Window::getWidgetCount() const
+{
+    return widgetLocator.getWidgetCount();
+}
+
+void Window::takeDamage(std::vector<SDL_FRect>& outDamage)
+{
+    outDamage.insert(outDamage.end(), damage.begin(), damage.end());
+    damage.clear();
+}
+
+void Window::addDamage(const SDL_FRect& windowExtent)
+{
+    SDL_FRect screenExtent{windowExtent};
+    screenExtent.x += scaledExtent.x;
+    screenExtent.y += scaledExtent.y;
+    addScreenDamage(screenExtent);
+}
+
+void Window::onOpacityInvalidated()
+{
+    opaqueExtentsAreDirty = true;
+}
+
 void Window::render()
+{
+    // If we aren't caching (or can't), render our children directly.
+    if (!isRenderCached || !refreshCacheTexture()) {
+        renderChildren({scaledExtent.x, scaledExtent.y});
+        return;
+    }
+
+    // If something changed since we last rendered, re-render our children
+    // into the cache.
+    if (renderIsDirty) {
+        rebuildRenderCache();
+        renderCacheStats.rebuildCount++;
+    }
+    else {
+        renderCacheStats.cacheHitCount++;
+    }
+
+    // Draw the cache.
+    float textureWidth{static_cast<float>(renderCacheTexture->w)};
+    float textureHeight{static_cast<float>(renderCacheTexture->h)};
+    Core::getRenderCommandList().addTexturedQuad(
+        renderCacheTexture.get(), {0, 0, textureWidth, textureHeight},
+        {scaledExtent.x, scaledExtent.y, textureWidth, textureHeight});
+}
+
+void Window::addScreenDamage(const SDL_FRect& screenExtent)
+{
+    if (SDL_RectEmptyFloat(&screenExtent)) {
+        return;
+    }
+
+    // If we're holding too many rects, collapse them into one.
+    if (damage.size() == MAX_DAMAGE_RECTS) {
+        SDL_FRect unionExtent{damage[0]};
+        for (const SDL_FRect& extent : damage) {
+            SDL_GetRectUnionFloat(&unionExtent, &extent, &unionExtent);
+        }
+        damage.clear();
+        damage.push_back(unionExtent);
+    }
+
+    damage.push_back(screenExtent);
+}
+
+void Window::renderChildren(const SDL_FPoint& windowTopLeft)
 {
     // Render all visible children.
     for (Widget& child : children) {
         if (child.getIsVisible()) {
-            child.render({scaledExtent.x, scaledExtent.y});
+            child.render(windowTopLeft);
         }
     }
 }
 
+bool Window::refreshCacheTexture()
+{
+    int width{static_cast<int>(std::ceil(scaledExtent.w))};
+    int height{static_cast<int>(std::ceil(scaledExtent.h))};
+    if ((width <= 0) || (height <= 0)) {
+        return false;
+    }
+
+    // If our existing texture is the right size, use it.
+    if (renderCacheTexture && (renderCacheTexture->w == width)
+        && (renderCacheTexture->h == height)) {
+        return true;
+    }
+
+    SDL_Texture* texture{SDL_CreateTexture(
+        Core::getRenderer(), SDL_PIXELFORMAT_ARGB8888,
+        SDL_TEXTUREACCESS_TARGET, width, height)};
+    if (texture == nullptr) {
+        // The renderer doesn't support render targets. Fall back to
+        // rendering directly.
+        AUI_LOG_INFO("Failed to create render cache texture for window: %s",
+                     debugName.c_str());
+        isRenderCached = false;
+        renderCacheTexture = nullptr;
+        return false;
+    }
+
+    // Our children are rendered into the texture with normal alpha
+    // blending, which leaves it holding premultiplied alpha.
+    // Note: The cache is drawn at its native size, so we don't want any
+    //       filtering.
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    renderCacheTexture
+        = std::unique_ptr<SDL_Texture, TextureDeleter>(texture);
+    renderIsDirty = true;
+
+    return true;
+}
+
+void Window::rebuildRenderCache()
+{
+    // Clear the dirty flag first, so that any widgets that invalidate
+    // themselves while rendering (e.g. images that are still loading) get
+    // re-rendered next frame.
+    renderIsDirty = false;
+
+    // Submit anything that was batched for the current target, since we're
+    // about to switch targets.
+    SDL_Renderer* renderer{Core::getRenderer()};
+    RenderCommandList& renderCommandList{Core::getRenderCommandList()};
+    renderCommandList.flush();
+
+    // Render our children into the cache texture, relative to its top left.
+    SDL_Texture* previousTarget{SDL_GetRenderTarget(renderer)};
+    SDL_SetRenderTarget(renderer, renderCacheTexture.get());
+
+    // Clear the texture to transparent, re-applying the draw color after.
+    SDL_Color originalColor{};
+    SDL_GetRenderDrawColor(renderer, &originalColor.r, &originalColor.g,
+                           &originalColor.b, &originalColor.a);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, originalColor.r, originalColor.g,
+                           originalColor.b, originalColor.a);
+
+    // The whole texture was cleared, so every child needs to be rendered.
+    // Note: The cache may be drawn later with different damage or occluders,
+    //       so culling doesn't apply.
+    renderCommandList.setCullingSuspended(true);
+    renderChildren({0, 0});
+    renderCommandList.flush();
+    renderCommandList.setCullingSuspended(false);
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+}
+
 } // namespace AUI
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "AUI/WidgetLocatorBackend.h"
+#include <SDL3/SDL_rect.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+namespace AUI
+{
+
+/**
+ * A locator backend that bulk-builds a bounding volume hierarchy over the
+ * widgets' extents.
+ *
+ * Each widget is stored once, no matter how large it is, and queries only
+ * visit the parts of the tree whose bounds contain the point. This makes it a
+ * good fit for windows with full-size backgrounds or dense grids of small
+ * widgets.
+ *
+ * The tree is rebuilt from scratch by the first query after any widget is
+ * added, moved, or removed. Rebuilding is O(n log n), so this backend works
+ * best for layouts that change less often than they're queried.
+ */
+class BVHLocatorBackend : public WidgetLocatorBackend
+{
+public:
+    /** The max number of widgets to store in each leaf node. */
+    static constexpr std::size_t MAX_LEAF_SIZE{4};
+
+    BVHLocatorBackend();
+
+    void setExtent(const SDL_FRect& inExtent) override;
+
+    void clear() override;
+
+    void addWidget(const Widget* widget, const SDL_FRect& extent) override;
+
+    void moveWidget(const Widget* widget, const SDL_FRect& oldExtent,
+                    const SDL_FRect& newExtent) override;
+
+    void removeWidget(const Widget* widget, const SDL_FRect& extent) override;
+
+    void getCandidates(const SDL_FPoint& point,
+                       std::vector<const Widget*>& outCandidates,
+                       QueryRegion& region) const override;
+
+private:
+    /**
+     * A tracked widget and its extent.
+     */
+    struct Item {
+        const Widget* widget{nullptr};
+        SDL_FRect extent{};
+    };
+
+    /**
+     * A node in the tree.
+     */
+    struct Node {
+        /** The union of the extents of every item under this node. */
+        SDL_FRect bounds{};
+        /** If this is a leaf, the index of its first item in treeItems.
+            Else, the index of its first child in nodes (the second child
+            directly follows it). */
+        std::uint32_t first{0};
+        /** If this is a leaf, the number of items in it. Else, 0. */
+        std::uint32_t count{0};
+    };
+
+    /**
+     * Rebuilds the tree from the current items.
+     */
+    void rebuild() const;
+
+    /**
+     * Fills in the given node using the items in the range [begin, end),
+     * splitting it into children if necessary.
+     */
+    void buildNode(std::uint32_t nodeIndex, std::uint32_t begin,
+                   std::uint32_t end) const;
+
+    /** The tracked widgets, in no particular order. */
+    std::vector<Item> items;
+
+    /** A map of widget pointer -> the widget's index in items. */
+    std::unordered_map<const Widget*, std::size_t> itemIndices;
+
+    /** A copy of items, sorted so that each leaf's items are contiguous. */
+    mutable std::vector<Item> treeItems;
+
+    /** The tree's nodes. The root is at index 0. */
+    mutable std::vector<Node> nodes;
+
+    /** If true, items has changed since the tree was last built. */
+    mutable bool treeIsDirty;
+};
+
+} // End namespace AUI
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AUI/AssetCache.h"
+#include "AUI/RenderCommandList.h"
 #include "AUI/ScreenResolution.h"
 #include <string>
 #include <memory>
@@ -84,6 +85,7 @@ public:
     static ScreenResolution getLogicalScreenSize();
     static ScreenResolution getActualScreenSize();
     static AUI::AssetCache& getAssetCache();
+    static AUI::RenderCommandList& getRenderCommandList();
     static float getSquaredDragTriggerDistance();
 
 private:
@@ -114,6 +116,9 @@ private:
     /** The asset cache for font objects. */
     static std::unique_ptr<AssetCache> assetCache;
 
+    /** The list that widgets submit their draw calls to. */
+    static std::unique_ptr<RenderCommandList> renderCommandList;
+
     /** The distance in pixels that the mouse must travel to trigger to a drag
         and drop event. */
     static float dragTriggerDistance;
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "AUI/WidgetLocatorBackend.h"
+#include <SDL3/SDL_rect.h>
+#include <vector>
+#include <cstddef>
+
+namespace AUI
+{
+
+/**
+ * A locator backend that splits the window into a grid of fixed-size cells.
+ *
+ * Each widget is added to every cell that it overlaps, and queries scan the
+ * widgets in the cell under the point.
+ *
+ * Adding, moving, and removing widgets is cheap, and widgets that move within
+ * the same cells cost nothing. However, large widgets (e.g. backgrounds) are
+ * added to many cells, and dense layouts put many widgets into each cell.
+ * For those layouts, consider BVHLocatorBackend.
+ *
+ * This is the default backend.
+ */
+class GridLocatorBackend : public WidgetLocatorBackend
+{
+public:
+    /** The default logical pixel width of the cells. */
+    static constexpr float LOGICAL_DEFAULT_CELL_WIDTH{128};
+
+    GridLocatorBackend();
+
+    void setExtent(const SDL_FRect& inExtent) override;
+
+    void clear() override;
+
+    void addWidget(const Widget* widget, const SDL_FRect& extent) override;
+
+    void moveWidget(const Widget* widget, const SDL_FRect& oldExtent,
+                    const SDL_FRect& newExtent) override;
+
+    void removeWidget(const Widget* widget, const SDL_FRect& extent) override;
+
+    void getCandidates(const SDL_FPoint& point,
+                       std::vector<const Widget*>& outCandidates,
+                       QueryRegion& region) const override;
+
+    /**
+     * Sets the width of the cells in the grid and clears all tracked widgets
+     * (since their locations are now invalid).
+     * Note: This isn't typically necessary, the default value should be fine
+     *       in most cases.
+     *
+     * @param inCellWidth  The cell width, in actual pixels.
+     */
+    void setCellWidth(float inCellWidth);
+
+    // Testing interface, you probably don't need to use these.
+    SDL_Rect getGridCellExtent() const;
+
+private:
+    /**
+     * Adds the given widget to the cells within the given extent.
+     */
+    void setWidgetLocation(const Widget* widget, const SDL_Rect& cellExtent);
+
+    /**
+     * Removes the given widget from the cells within the given extent.
+     */
+    void clearWidgetLocation(const Widget* widget,
+                             const SDL_Rect& cellClearExtent);
+
+    /**
+     * Returns the index in the widgetGrid vector where the cell with the given
+     * coordinates can be found.
+     */
+    inline std::size_t linearizeCellIndex(int x, int y) const
+    {
+        return (y * gridCellExtent.w) + x;
+    }
+
+    /**
+     * Converts the given window-relative extent to a cell extent.
+     */
+    SDL_Rect toCellExtent(const SDL_FRect& extent) const;
+
+    /** The width of a grid cell in actual-space pixels. */
+    float cellWidth;
+
+    /** The extent that this grid covers, relative to the parent window. */
+    SDL_FRect gridExtent;
+
+    /** The grid's extent, with cells as the unit. */
+    SDL_Rect gridCellExtent;
+
+    /** The outer vector is a linearized 2D grid stored in row-major order,
+        holding the grid's cells.
+        Each element in the grid is a vector of widgets--the widgets that
+        currently intersect with that cell. The widgets are in no particular
+        order.
+        Note: The widget pointers in this grid are not safe to reference, as
+              they may have gone invalid since they were added. */
+    std::vector<std::vector<const Widget*>> widgetGrid;
+};
+
+} // End namespace AUI
@@ -3,9 +3,11 @@
 #include "AUI/Window.h"
 #include "AUI/EventRouter.h"
 #include "AUI/WidgetWeakRef.h"
+#include "AUI/ScreenResolution.h"
 #include <SDL3/SDL_events.h>
 #include <vector>
 #include <optional>
+#include <span>
 
 namespace AUI
 {
@@ -22,10 +24,55 @@ namespace AUI
  * An appropriate screen may be a title screen, settings screen, or a world
  * screen that displays UI elements while allowing the user to see the world
  * behind it.
+ *
+ * Dirty rect rendering:
+ *   Mostly idle UIs can opt in to dirty rect rendering through
+ *   setDirtyRectRenderingEnabled(). Instead of re-drawing everything each
+ *   frame, render() will gather the damage reported by our windows (see
+ *   "Render invalidation" in Widget.h), merge it into a few rects, and only
+ *   re-draw the widgets that intersect those rects. If nothing was damaged,
+ *   nothing is drawn.
+ *
+ *   Each damaged rect is filled with the clear color (transparent by
+ *   default, see setDirtyRectClearColor()) without blending before it's
+ *   re-drawn, so this mode is meant for UIs that own their whole render
+ *   target. The target's contents must persist
+ *   between frames (e.g. render into a texture and present that), and
+ *   getDamagedRects() can be used to only present what changed.
+ *
+ * Occlusion culling:
+ *   Windows can declare opaque extents (see "Opacity" in Window.h). When
+ *   rendering, a window that's fully within an opaque extent of a window
+ *   above it is skipped entirely, and widgets that are fully within one are
+ *   skipped individually. Hidden windows can also skip their layout updates,
+ *   see setOccludedLayoutSkippingEnabled().
+ *
+ *   Note: Each opaque extent is tested on its own. Something that's only
+ *         covered by the union of several extents will still be rendered.
  */
 class Screen
 {
 public:
+    /**
+     * Occlusion culling statistics, for checking how much rendering is
+     * being skipped.
+     */
+    struct OcclusionStats {
+        /** The number of times that a window became fully hidden by an
+            opaque window above it. A window that stays hidden is only
+            counted once. */
+        std::size_t occludedWindowCount{0};
+        /** The number of widgets that weren't rendered because they were
+            hidden. Includes every widget in a window, each time the window
+            becomes hidden.
+            Note: Widgets that are skipped along with their parent aren't
+                  counted. */
+        std::size_t culledWidgetCount{0};
+        /** The number of times that a hidden window's layout update was
+            skipped. */
+        std::size_t skippedLayoutCount{0};
+    };
+
     Screen(const std::string& inDebugName);
 
     virtual ~Screen() = default;
@@ -69,6 +116,36 @@ public:
      */
     bool handleOSEvent(SDL_Event& event);
 
+    /**
+     * Passes the given SDL events to the EventRouter, in order.
+     *
+     * Runs of consecutive mouse motion events are coalesced into their last
+     * event, since only the final position matters for hover state. Other
+     * events (buttons, wheel, keys, text) end a run, so their order relative
+     * to motion is kept. A motion event that would start a drag also ends a
+     * run, so drags start the same way they would if every event was handled.
+     *
+     * Note: The last event in each coalesced run has its xrel/yrel replaced
+     *       with the sum of the run's relative motion.
+     *
+     * @param unconsumedEvents If non-nullptr, events that weren't consumed
+     *                         will be appended to this vector (coalesced runs
+     *                         are represented by their last event).
+     */
+    void handleOSEvents(std::span<SDL_Event> events,
+                        std::vector<SDL_Event>* unconsumedEvents = nullptr);
+
+    /**
+     * Returns the number of mouse motion events that were coalesced away
+     * during the most recent handleOSEvents() call.
+     */
+    std::size_t getCoalescedEventCount() const;
+
+    /**
+     * Returns the event router's hit test cache stats.
+     */
+    const EventRouter::HitTestStats& getHitTestStats() const;
+
     /**
      * Called when a key press isn't handled by any of our widgets.
      *
@@ -92,10 +169,61 @@ public:
     virtual void tick(double timestepS);
 
     /**
-     * Renders all UI graphics for this screen to the current rendering target.
+     * Updates the layout of any visible windows that have been invalidated,
+     * then renders all UI graphics for this screen to the current rendering
+     * target.
+     *
+     * If dirty rect rendering is enabled, only the damaged parts of the
+     * screen are re-drawn.
      */
     virtual void render();
 
+    /**
+     * If true, render() will only re-draw the damaged parts of the screen.
+     * See "Dirty rect rendering" above.
+     *
+     * Note: Enabling this causes the next render() to re-draw everything.
+     */
+    void setDirtyRectRenderingEnabled(bool inDirtyRectRenderingEnabled);
+
+    bool getDirtyRectRenderingEnabled() const;
+
+    /**
+     * Sets the color that damaged rects are filled with before they're
+     * re-drawn, when dirty rect rendering is enabled. Transparent by default.
+     *
+     * Note: This causes the next render() to re-draw everything.
+     */
+    void setDirtyRectClearColor(const SDL_Color& inDirtyRectClearColor);
+
+    /**
+     * Returns the actual-space rects that were re-drawn during the last
+     * render(). These never overlap each other.
+     *
+     * If dirty rect rendering is disabled, this is the whole screen.
+     */
+    const std::vector<SDL_Rect>& getDamagedRects() const;
+
+    /**
+     * If true, windows that are fully hidden by an opaque window above them
+     * won't have their layout updated until they're uncovered.
+     *
+     * Note: While a window is hidden, hit testing and focus may use its last
+     *       layout.
+     */
+    void setOccludedLayoutSkippingEnabled(
+        bool inOccludedLayoutSkippingEnabled);
+
+    bool getOccludedLayoutSkippingEnabled() const;
+
+    /**
+     * Returns the occlusion stats that have accumulated since the last
+     * resetOcclusionStats().
+     */
+    const OcclusionStats& getOcclusionStats() const;
+
+    void resetOcclusionStats();
+
 protected:
     /** The user-assigned name associated with this screen.
         Only useful for debugging. For performance reasons, avoid using it
@@ -117,6 +245,108 @@ protected:
     /** If non-empty, the referenced widget will be given focus after the next
         layout update. */
     std::optional<WidgetWeakRef> pendingFocusTarget;
+
+    /** The actual screen size that was used during the last layout update.
+        Used to tell when the UI scaling changes, so we can invalidate every
+        window's layout. */
+    ScreenResolution lastUsedScreenSize;
+
+private:
+    /** The most damaged rects that we'll re-draw separately. If merging
+        leaves more than this, they're collapsed into their union. */
+    static constexpr std::size_t MAX_DAMAGED_RECTS{8};
+
+    /**
+     * How each window is affected by the opaque windows above it.
+     */
+    struct WindowOcclusion {
+        /** The window that these results are for. */
+        const Window* window{nullptr};
+        /** The number of elements at the front of occluders that are above
+            this window. */
+        std::size_t occluderCount{0};
+        /** If true, this window is fully hidden. */
+        bool isOccluded{false};
+    };
+
+    /**
+     * Updates the layouts of any visible windows that have been invalidated,
+     * and finds which parts of each window are hidden by the windows above
+     * it.
+     */
+    void updateLayoutsAndOcclusion();
+
+    /**
+     * Renders the given window, unless it's invisible or hidden.
+     */
+    void renderWindow(std::size_t windowIndex);
+
+    /**
+     * Gathers this frame's damage from our windows and the drag drop image,
+     * and merges it into damagedRects.
+     */
+    void collectDamage(Image* dragDropImage,
+                       const SDL_FPoint& cursorPosition);
+
+    /**
+     * Adds the given rect to damagedRects, merging it with any rects that
+     * it overlaps.
+     */
+    void addDamagedRect(const SDL_Rect& rect);
+
+    /**
+     * Re-draws the windows and drag drop image within the given rect.
+     */
+    void renderDamagedRect(const SDL_Rect& rect, Image* dragDropImage,
+                           const SDL_FPoint& cursorPosition);
+
+    /**
+     * Finds the end of the run of coalescable motion events that starts at
+     * firstIndex, and sums the run's relative motion into the last event.
+     *
+     * @return The index of the last event in the run.
+     */
+    std::size_t coalesceMouseMotion(std::span<SDL_Event> events,
+                                    std::size_t firstIndex);
+
+    /** See getCoalescedEventCount(). */
+    std::size_t coalescedEventCount;
+
+    /** If true, dirty rect rendering is enabled. */
+    bool dirtyRectRenderingEnabled;
+
+    /** See setDirtyRectClearColor(). */
+    SDL_Color dirtyRectClearColor;
+
+    /** If true, the whole screen needs to be re-drawn during the next
+        render() (e.g. because the screen size changed). */
+    bool needsFullRedraw;
+
+    /** Used by collectDamage() to gather damage from our windows. Kept as a
+        member to avoid re-allocating it every frame. */
+    std::vector<SDL_FRect> damage;
+
+    /** See getDamagedRects(). */
+    std::vector<SDL_Rect> damagedRects;
+
+    /** If we rendered a drag drop image last frame, this is where. */
+    std::optional<SDL_FRect> lastDragDropExtent;
+
+    /** If true, hidden windows skip their layout updates. */
+    bool occludedLayoutSkippingEnabled;
+
+    /** Our windows' opaque extents, in actual space, ordered from the top
+        window to the bottom. */
+    std::vector<SDL_FRect> occluders;
+
+    /** Parallel to windows. See WindowOcclusion. */
+    std::vector<WindowOcclusion> windowOcclusion;
+
+    /** windowOcclusion, as of the previous frame. Used to tell when a
+        window becomes hidden. */
+    std::vector<WindowOcclusion> lastWindowOcclusion;
+
+    OcclusionStats occlusionStats;
 };
 
 } // namespace AUI
@@ -8,6 +8,8 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <functional>
+#include <cstdint>
 
 namespace AUI
 {
@@ -43,6 +45,26 @@ class WidgetLocator;
  * Note: Widgets have no concept of reordering their children based on events.
  *       For example, if you want a widget to come to the front of the screen
  *       when it's clicked, you should instead put it in a separate Window.
+ *
+ * Layout invalidation:
+ *   Windows only re-run their measure/arrange passes when something in their
+ *   widget tree has been invalidated. The built-in setters (setLogicalExtent,
+ *   setIsVisible, Text::setText, Container::push_back, etc.) invalidate the
+ *   layout for you. If your derived widget changes state that affects its
+ *   size or position outside of those setters (e.g. a scroll offset), call
+ *   invalidateMeasure() or invalidateArrange().
+ *
+ * Render invalidation:
+ *   Windows can cache their rendered contents (see
+ *   Window::setIsRenderCached()). Layout invalidation also invalidates the
+ *   cache, but if your derived widget changes how it looks without changing
+ *   its layout (e.g. a color or an animation frame), call invalidateRender().
+ *
+ *   Each invalidation also reports the widget's current extent to its root
+ *   window as damage, which Screen uses for dirty rect rendering (see
+ *   Screen::setDirtyRectRenderingEnabled()).
+ *   If your derived widget overrides render(), start with the
+ *   isRenderCulled() check so that it's skipped when it isn't damaged.
  */
 class Widget
 {
@@ -50,6 +72,13 @@ public:
     /** Widget is not independently constructible. */
     Widget() = delete;
 
+    // Each widget owns a WidgetRegistry slot that's removed when it's
+    // destructed, so widgets can't be copied or moved.
+    Widget(const Widget& other) = delete;
+    Widget(Widget&& other) = delete;
+    Widget& operator=(const Widget& other) = delete;
+    Widget& operator=(Widget&& other) = delete;
+
     virtual ~Widget();
 
     /**
@@ -86,6 +115,67 @@ public:
     virtual void setIsFocusable(bool inIsFocusable);
     bool getIsFocusable() const;
 
+    /**
+     * Returns true if this widget fully covers its clipped extent with
+     * opaque pixels.
+     *
+     * Windows use this to infer which parts of them are opaque, so that
+     * windows underneath them can skip rendering (see Window.h).
+     *
+     * Note: If this changes without a layout change, overrides must call
+     *       invalidateOpacity().
+     */
+    virtual bool getIsOpaque() const;
+
+    /**
+     * Internal library function.
+     * Appends the window-relative clipped extents of our visible descendants
+     * that are opaque (see getIsOpaque()) to the given vector.
+     *
+     * Note: Only descendants in our children list are checked (e.g.
+     *       Container elements aren't).
+     */
+    void getOpaqueChildExtents(std::vector<SDL_FRect>& outExtents) const;
+
+    /**
+     * Marks this widget as needing a new measure pass (which also implies a
+     * new arrange pass), and propagates the invalidation up to its parent
+     * window.
+     */
+    void invalidateMeasure();
+
+    /**
+     * Marks this widget as needing a new arrange pass, and propagates the
+     * invalidation up to its parent window.
+     *
+     * Use this instead of invalidateMeasure() for changes that only affect
+     * positioning, such as scrolling.
+     */
+    void invalidateArrange();
+
+    /**
+     * Marks this widget's root window as needing to be re-rendered, and
+     * reports this widget's extent as damaged.
+     *
+     * Only needed for visual changes that don't affect layout. Measure and
+     * arrange invalidation already imply a re-render.
+     */
+    void invalidateRender();
+
+    /**
+     * Marks this widget's root window's opaque extents as stale, so they'll
+     * be gathered again before the next occlusion check.
+     *
+     * Only needed for changes to getIsOpaque() that don't affect layout.
+     * Measure and arrange invalidation already imply this.
+     */
+    void invalidateOpacity();
+
+    /** See Widget::measureIsDirty. */
+    bool getIsMeasureDirty() const;
+    /** See Widget::arrangeIsDirty. */
+    bool getIsArrangeDirty() const;
+
     // Note: We'd prefer to return a const Image*, but render() is non-const.
     /** Returns the image that should follow the mouse while this widget is
         being dragged.
@@ -351,24 +441,56 @@ public:
 
     /**
      * Internal library function.
-     * Used by WidgetWeakRef to register a reference.
+     * Used by WidgetWeakRef to get this widget's WidgetRegistry slot.
      */
-    void trackRef(WidgetWeakRef* ref);
+    std::uint32_t getRegistryIndex() const;
 
     /**
      * Internal library function.
-     * Used by WidgetWeakRef to unregister a reference.
+     * Used by widgets that own children outside of Widget::children (e.g.
+     * Container elements) to set up layout invalidation propagation.
      */
-    void untrackRef(WidgetWeakRef* ref);
+    void setParent(Widget* inParent);
+
+protected:
+    Widget(const SDL_FRect& inLogicalExtent, const std::string& inDebugName);
 
     /**
-     * Internal library function.
-     * Used by tests to verify that refs are being tracked correctly.
+     * Called on the root widget (the Window) when a widget in its tree is
+     * invalidated.
+     *
+     * @param windowExtent The damaged extent, relative to the window.
      */
-    std::size_t getRefCount();
+    virtual void addDamage(const SDL_FRect& windowExtent);
 
-protected:
-    Widget(const SDL_FRect& inLogicalExtent, const std::string& inDebugName);
+    /**
+     * Called on the root widget (the Window) when a widget in its tree
+     * changes its opacity. See invalidateOpacity().
+     */
+    virtual void onOpacityInvalidated();
+
+    /**
+     * Returns true if this widget shouldn't be rendered, because it's fully
+     * clipped or doesn't intersect the render command list's cull extent.
+     *
+     * @param windowTopLeft The top left coordinate of this widget's parent
+     *                      window.
+     */
+    bool isRenderCulled(const SDL_FPoint& windowTopLeft) const;
+
+    /**
+     * Calls the given function, then restores the layout dirty flags of
+     * ourself and our ancestors to what they were before it was called.
+     *
+     * Used by containers that change an element during layout (e.g. by
+     * re-binding a recycled item) and then measure it in the same pass.
+     * Without this, the element's invalidation would leave the window dirty
+     * and cause a redundant second layout pass.
+     *
+     * Note: Any damage that the function adds is kept.
+     */
+    void runWithoutInvalidatingAncestors(
+        const std::function<void()>& function);
 
     /** An optional user-assigned name associated with this widget.
         Only useful for debugging. For performance reasons, avoid using it
@@ -421,11 +543,29 @@ protected:
         front -> back, events propagate from back -> front). */
     std::vector<std::reference_wrapper<Widget>> children;
 
-    /** The weak references to this widget.
-        When this widget is destructed, it will invalidate itself in these
-        refs. When one of these refs is destructed, it will tell us to stop
-        tracking it. */
-    std::vector<WidgetWeakRef*> trackedRefs;
+    /** This widget's parent, or nullptr if it doesn't have one (e.g. it's a
+        Window, or it hasn't been through a layout pass yet).
+        Only used to propagate layout invalidation. Set during the parent's
+        measure pass, or when being added to a Container. */
+    Widget* parent;
+
+    /** If true, something has changed that requires this widget to be
+        re-measured. Cleared by measure(). */
+    bool measureIsDirty;
+
+    /** If true, something has changed that requires this widget to be
+        re-arranged. Cleared by arrange(). */
+    bool arrangeIsDirty;
+
+    /** If true, something has changed that requires this widget's contents
+        to be re-rendered. Only used by root widgets (Windows), to know when
+        their render cache is stale. See invalidateRender(). */
+    bool renderIsDirty;
+
+    /** This widget's WidgetRegistry slot. Used by WidgetWeakRef.
+        When this widget is destructed, it removes itself from the registry,
+        which invalidates any refs to it. */
+    std::uint32_t registryIndex;
 };
 
 } // namespace AUI
@@ -2,9 +2,12 @@
 
 #include "AUI/WidgetPath.h"
 #include "AUI/WidgetWeakRef.h"
+#include "AUI/WidgetLocatorBackend.h"
 #include <SDL3/SDL_rect.h>
+#include <memory>
 #include <vector>
 #include <unordered_map>
+#include <cstddef>
 
 namespace AUI
 {
@@ -12,13 +15,24 @@ namespace AUI
 class Widget;
 
 /**
- * A spatial partitioning grid that tracks where widgets are located.
+ * Tracks where widgets are located.
  *
  * Used to quickly find which widgets were hit by e.g. a mouse click event.
  *
- * Internally, widgets are organized into "cells", each of which has a size
- * corresponding to a configurable cell width. This value can be tweaked to
- * affect performance.
+ * The spatial indexing is handled by a WidgetLocatorBackend. By default, a
+ * GridLocatorBackend is used. Layouts that it handles poorly (e.g. dense
+ * grids of small widgets) can swap in a different backend via setBackend().
+ *
+ * The locator's contents persist across layout passes. To update it, call
+ * beginUpdate(), re-add every widget in layout order, then call endUpdate().
+ * Widgets whose location didn't change are left alone, widgets that moved are
+ * relocated, and widgets that weren't re-added are removed. Each re-added
+ * widget still costs a hash lookup, but the spatial index (the grid or
+ * backend) is only modified for the widgets that were added, moved, or
+ * removed.
+ *
+ * Each change to the locator's contents bumps its layout epoch. Callers can
+ * compare epochs to tell if a previously returned path may be out of date.
  */
 class WidgetLocator
 {
@@ -34,15 +48,59 @@ public:
     WidgetLocator(const WidgetLocator& other) = delete;
     WidgetLocator(WidgetLocator&& other) = delete;
 
+    /**
+     * Stats describing the work done during the last update.
+     */
+    struct UpdateStats {
+        /** The number of widgets that were newly added. */
+        std::size_t addedCount{0};
+        /** The number of widgets whose extent changed. */
+        std::size_t movedCount{0};
+        /** The number of widgets that were removed because they weren't
+            re-added during the update. */
+        std::size_t removedCount{0};
+        /** The number of widgets whose location didn't change. */
+        std::size_t unchangedCount{0};
+    };
+
+    /**
+     * Begins an incremental update.
+     *
+     * After calling this, re-add every widget in the layout (in layout order)
+     * through addWidget(), then call endUpdate().
+     */
+    void beginUpdate();
+
+    /**
+     * Ends an incremental update, removing any widgets that weren't re-added
+     * since the last beginUpdate().
+     */
+    void endUpdate();
+
+    /**
+     * Returns the stats for the current or most recent update.
+     */
+    const UpdateStats& getUpdateStats() const;
+
+    /**
+     * Returns the window-relative extents that changed during the current or
+     * most recent update: the new extent of each added widget, the old and
+     * new extents of each moved widget, and the old extent of each removed
+     * widget.
+     *
+     * Used to find the parts of the window that need to be re-drawn.
+     */
+    const std::vector<SDL_FRect>& getChangedExtents() const;
+
     /**
      * Adds the given widget to the locator.
      *
-     * The widget's current position will be stored. To update the widget's
-     * position in this locator, call clear() and re-add the widget.
+     * The widget's current position will be stored. If the widget is already
+     * tracked, its location is only updated if its cells have changed.
      *
      * Note: Widgets are layered according to the order that they're added
-     *       in. E.g. if 2 overlapping widgets are added, the second will
-     *       be considered to be in front of the first.
+     *       in (during the current update). E.g. if 2 overlapping widgets are
+     *       added, the second will be considered to be in front of the first.
      *
      * Note: Assumes the given widget is fully within this locator's extent.
      *       Don't pass in widgets that are outside its bounds.
@@ -54,9 +112,8 @@ public:
     /**
      * If we're tracking the given widget, removes it from this locator.
      *
-     * Note: Typically you'll remove widgets by calling clear() and adding
-     *       them back in order. This is necessary to enforce your desired
-     *       layering.
+     * Note: Typically you won't need to call this, since endUpdate() removes
+     *       any widgets that weren't re-added.
      */
     void removeWidget(Widget* widget);
 
@@ -71,10 +128,15 @@ public:
      * given actual-space point.
      *
      * @param actualPoint  The point in actual space to test widgets with.
+     * @param outReuseExtent  If non-nullptr, will be set to an actual-space
+     *                        extent around actualPoint. Until the layout
+     *                        epoch changes, any point strictly inside this
+     *                        extent will produce the same path.
      * @return A widget path, ordered with the root-most widget at the front
      *         and the leaf-most widget at the back.
      */
-    WidgetPath getPathUnderPoint(const SDL_FPoint& actualPoint) const;
+    WidgetPath getPathUnderPoint(const SDL_FPoint& actualPoint,
+                                 SDL_FRect* outReuseExtent = nullptr) const;
 
     /**
      * Builds a path containing all tracked widgets that are underneath the
@@ -94,6 +156,11 @@ public:
      */
     bool containsWidget(const Widget* widget) const;
 
+    /**
+     * Returns the number of widgets that this locator is tracking.
+     */
+    std::size_t getWidgetCount() const;
+
     /**
      * Sets the part of the screen (in actual space) that this widget locator
      * covers.
@@ -103,75 +170,98 @@ public:
      *
      * All tracked widgets must be fully within these bounds.
      *
+     * If the extent's size changed, the locator is cleared (since all of the
+     * tracked locations are now invalid).
+     *
      * @param inScreenExtent  The actual screen-space extent that this locator
      *                        should cover.
      */
     void setExtent(const SDL_FRect& inScreenExtent);
 
     /**
-     * Sets the width of the cells in the spatial partitioning grid and clears
-     * the locator's state (since it's now invalid).
-     * Note: This isn't typically necessary, the default value should be fine
-     *       in most cases.
+     * Replaces this locator's backend and clears the locator's state.
+     *
+     * Widgets will be added to the new backend during the next update.
      */
-    void setCellWidth(float inCellWidth);
+    void setBackend(std::unique_ptr<WidgetLocatorBackend> inBackend);
 
-    // Testing interface, you probably don't need to use these.
-    SDL_Rect getGridCellExtent();
-
-private:
-    /** The default logical pixel width of the cells in the spatial
-        partitioning grid. */
-    static constexpr float LOGICAL_DEFAULT_CELL_WIDTH{128};
+    /**
+     * Returns this locator's backend, e.g. for tweaking backend-specific
+     * settings.
+     */
+    WidgetLocatorBackend& getBackend();
 
     /**
-     * Removes the given widget from the cells within the given extent.
+     * Returns this locator's layout epoch.
      *
-     * Note: This leaves the widget in the entityMap. Only the tracked
-     *       location is cleared out.
+     * The epoch changes whenever the locator's contents or extent change.
+     * Epochs are unique across all locators, so a cached epoch will never
+     * match a different locator.
      */
-    void clearWidgetLocation(const Widget* widget,
-                             const SDL_Rect& cellClearExtent);
+    std::size_t getLayoutEpoch() const;
 
+private:
     /**
-     * Returns the index in the widgetGrid vector where the cell with the given
-     * coordinates can be found.
+     * The data that we track for each widget.
      */
-    inline std::size_t linearizeCellIndex(int x, int y) const
-    {
-        return (y * gridCellExtent.w) + x;
-    }
+    struct TrackedWidget {
+        /** Used to check that the widget is still alive before accessing it,
+            and to detect when a widget's address has been reused. */
+        WidgetWeakRef widgetRef;
+        /** The extent that the widget was last added with. */
+        SDL_FRect extent{};
+        /** The order that this widget was added in. Used to order hit test
+            results from root-most to leaf-most. */
+        std::size_t layoutOrder{0};
+        /** The update that this widget was last added during. Used to find
+            widgets that are no longer in the layout. */
+        std::size_t updateIndex{0};
+    };
 
     /**
-     * Converts the given screen extent to a cell extent.
+     * Gives this locator a new, unique layout epoch.
      */
-    SDL_Rect screenToCellExtent(const SDL_FRect& screenExtent);
+    void bumpLayoutEpoch();
 
-    /** The width of a grid cell in logical-space pixels. */
-    float cellWidth;
+    /** The spatial index that holds our widgets. */
+    std::unique_ptr<WidgetLocatorBackend> backend;
 
-    /** The grid's extent in actual screen space. */
-    SDL_FRect gridScreenExtent;
+    /** Our extent in actual screen space. */
+    SDL_FRect screenExtent;
 
-    /** The grid's extent, relative to the parent window. */
-    SDL_FRect gridRelativeExtent;
+    /** Our extent, relative to the parent window. */
+    SDL_FRect relativeExtent;
 
-    /** The grid's relative extent, with cells as the unit. */
-    SDL_Rect gridCellExtent;
-
-    /** The outer vector is a linearized 2D grid stored in row-major order,
-        holding the grid's cells.
-        Each element in the grid is a vector of widgets--the widgets that
-        currently intersect with that cell. */
-    std::vector<std::vector<WidgetWeakRef>> widgetGrid;
-
-    /** A map of widget pointer -> the cells that the widget is located in.
-        Used to easily clear out old widget data before setting their new
-        location.
+    /** A map of widget pointer -> the widget's tracked data.
+        Used to check if a widget moved, and to validate and order the
+        widgets that the backend returns.
         Note: The widget pointers in this map are not safe to reference, as
               they may have gone invalid since they were added. We're only
               using them as identifiers. */
-    std::unordered_map<const Widget*, SDL_Rect> widgetMap;
+    std::unordered_map<const Widget*, TrackedWidget> widgetMap;
+
+    /** The index of the current update. Incremented by beginUpdate(). */
+    std::size_t updateIndex;
+
+    /** The layout order to give to the next added widget. */
+    std::size_t nextLayoutOrder;
+
+    /** The stats for the current or most recent update. */
+    UpdateStats updateStats;
+
+    /** See getChangedExtents(). */
+    std::vector<SDL_FRect> changedExtents;
+
+    /** The current layout epoch. See getLayoutEpoch(). */
+    std::size_t layoutEpoch;
+
+    /** Used by getPathUnderPoint() to collect candidate widgets from the
+        backend. Kept as a member to avoid re-allocating it. */
+    mutable std::vector<const Widget*> candidates;
+
+    /** Used by getPathUnderPoint() to collect hit widgets. Kept as a member
+        to avoid re-allocating it on every mouse move. */
+    mutable std::vector<const TrackedWidget*> hitWidgets;
 };
 
 } // End namespace AUI
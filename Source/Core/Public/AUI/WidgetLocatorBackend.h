@@ -0,0 +1,99 @@
+#pragma once
+
+#include <SDL3/SDL_rect.h>
+#include <vector>
+
+namespace AUI
+{
+
+class Widget;
+
+/**
+ * The spatial index that a WidgetLocator uses to find the widgets near a
+ * point.
+ *
+ * WidgetLocator handles widget validity, layout order, and hit testing.
+ * Backends only need to store each widget's extent and return the widgets
+ * that may contain a given point.
+ *
+ * All extents and points given to a backend are relative to the locator's
+ * window.
+ *
+ * See GridLocatorBackend and BVHLocatorBackend for the built-in backends.
+ */
+class WidgetLocatorBackend
+{
+public:
+    /**
+     * An area around a queried point. Backends shrink it while gathering
+     * candidates, so that every widget containing a point strictly inside
+     * the area ends up in the candidate list.
+     */
+    struct QueryRegion {
+        float left{0};
+        float top{0};
+        float right{0};
+        float bottom{0};
+
+        /**
+         * Shrinks this region to fit inside the given extent.
+         */
+        void intersect(const SDL_FRect& extent);
+
+        /**
+         * Shrinks this region so that it no longer overlaps the given extent.
+         *
+         * @param point  The queried point. Must be outside of extent, and is
+         *               kept inside this region.
+         */
+        void exclude(const SDL_FRect& extent, const SDL_FPoint& point);
+    };
+
+    virtual ~WidgetLocatorBackend() = default;
+
+    /**
+     * Sets the window-relative extent that this backend should cover, and
+     * clears all tracked widgets.
+     */
+    virtual void setExtent(const SDL_FRect& inExtent) = 0;
+
+    /**
+     * Removes all tracked widgets.
+     */
+    virtual void clear() = 0;
+
+    /**
+     * Starts tracking the given widget at the given extent.
+     */
+    virtual void addWidget(const Widget* widget, const SDL_FRect& extent) = 0;
+
+    /**
+     * Moves the given tracked widget from oldExtent to newExtent.
+     */
+    virtual void moveWidget(const Widget* widget, const SDL_FRect& oldExtent,
+                            const SDL_FRect& newExtent)
+        = 0;
+
+    /**
+     * Stops tracking the given widget.
+     *
+     * @param extent  The extent that the widget was last added or moved to.
+     */
+    virtual void removeWidget(const Widget* widget, const SDL_FRect& extent)
+        = 0;
+
+    /**
+     * Appends every tracked widget that may contain the given point to
+     * outCandidates, and shrinks region to an area that the candidates are
+     * valid for.
+     *
+     * Note: The candidates may include widgets that don't contain the point.
+     *       The caller is expected to test each one.
+     */
+    virtual void getCandidates(const SDL_FPoint& point,
+                               std::vector<const Widget*>& outCandidates,
+                               QueryRegion& region) const
+        = 0;
+};
+
+} // End namespace AUI
@@ -1,7 +1,8 @@
 #pragma once
 
 #include "WidgetWeakRef.h"
-#include <vector>
+#include <memory>
+#include <iterator>
 
 namespace AUI
 {
@@ -13,15 +14,20 @@ class Widget;
  * most (i.e. farthest back in the final rendered screen to farthest forward).
  *
  * The front of a path will typically be a Window.
+ *
+ * Paths are built on every mouse move, so the first INLINE_CAPACITY
+ * references are stored inline. Only deeper paths allocate.
  */
 class WidgetPath
 {
 public:
-    using iterator = std::vector<WidgetWeakRef>::iterator;
-    using const_iterator = std::vector<WidgetWeakRef>::const_iterator;
-    using reverse_iterator = std::vector<WidgetWeakRef>::reverse_iterator;
-    using const_reverse_iterator
-        = std::vector<WidgetWeakRef>::const_reverse_iterator;
+    using iterator = WidgetWeakRef*;
+    using const_iterator = const WidgetWeakRef*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /** The number of references that can be stored without allocating. */
+    static constexpr std::size_t INLINE_CAPACITY{16};
 
     //-------------------------------------------------------------------------
     // Constructors, Assignment
@@ -131,7 +137,7 @@ public:
      * Iterator to the first element referencing the given widget. If no such
      * element is found, past-the-end (see end()) iterator is returned.
      *
-     * Note: Doesn't check if the widget reference is still valid.
+     * Note: Invalid widget references are skipped.
      */
     iterator find(const Widget* widget);
     const_iterator find(const Widget* widget) const;
@@ -139,7 +145,7 @@ public:
     /**
      * true if the given widget was found in this path, otherwise false.
      *
-     * Note: Doesn't check if the widget reference is still valid.
+     * Note: Invalid widget references are skipped.
      */
     bool contains(const Widget* widget) const;
 
@@ -163,7 +169,31 @@ public:
     const_reverse_iterator crend() const;
 
 private:
-    std::vector<WidgetWeakRef> widgetRefs;
+    /**
+     * Replaces our contents with the range [first, last).
+     */
+    void assign(const_iterator first, const_iterator last);
+
+    /**
+     * If our capacity is less than minCapacity, moves our references into a
+     * larger heap buffer.
+     */
+    void reserve(std::size_t minCapacity);
+
+    /** Inline storage, used until the path grows past INLINE_CAPACITY. */
+    WidgetWeakRef inlineRefs[INLINE_CAPACITY];
+
+    /** Heap storage, used if the path grows past INLINE_CAPACITY. */
+    std::unique_ptr<WidgetWeakRef[]> heapRefs;
+
+    /** Points to the storage that's in use (inlineRefs or heapRefs). */
+    WidgetWeakRef* refs;
+
+    /** The number of references in this path. */
+    std::size_t refCount;
+
+    /** The number of references that refs can hold. */
+    std::size_t refCapacity;
 };
 
 } // End namespace AUI
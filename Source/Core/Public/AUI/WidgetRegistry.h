@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace AUI
+{
+
+class Widget;
+
+/**
+ * Internal library class.
+ *
+ * A slot map that gives each living widget an index and a generation.
+ * WidgetWeakRef holds an (index, generation) pair and is valid as long as
+ * the slot's generation still matches. When a widget is destructed, its
+ * slot's generation is bumped (invalidating every ref to it at once) and
+ * the slot is reused by the next widget that gets constructed.
+ *
+ * This lets weak refs be trivially copyable, without the widget needing to
+ * track each ref that points at it.
+ *
+ * Note: Like WidgetWeakRef, this class is not threadsafe. Construct and
+ *       destruct widgets on the same thread that uses them.
+ */
+class WidgetRegistry
+{
+public:
+    /**
+     * Adds the given widget to a free slot.
+     *
+     * @return The index of the widget's slot.
+     */
+    static std::uint32_t add(Widget& widget);
+
+    /**
+     * Removes the widget in the given slot, invalidating any refs to it.
+     */
+    static void remove(std::uint32_t index);
+
+    /**
+     * Returns the current generation of the given slot.
+     */
+    static std::uint32_t getGeneration(std::uint32_t index)
+    {
+        return slots[index].generation;
+    }
+
+    /**
+     * Returns the widget in the given slot, or nullptr if the slot is free.
+     */
+    static Widget* getWidget(std::uint32_t index)
+    {
+        return slots[index].widget;
+    }
+
+    /**
+     * Returns the number of slots that have been allocated (used and free).
+     */
+    static std::size_t getSlotCount();
+
+private:
+    struct Slot {
+        /** The widget in this slot. nullptr if this slot is free. */
+        Widget* widget{nullptr};
+
+        /** Incremented each time the slot's widget is removed. */
+        std::uint32_t generation{0};
+    };
+
+    /** The widget slots. Indexed by widget registry index. */
+    static std::vector<Slot> slots;
+
+    /** The indices of free slots, ready to be reused. */
+    static std::vector<std::uint32_t> freeIndices;
+};
+
+} // End namespace AUI
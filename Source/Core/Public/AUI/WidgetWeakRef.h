@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <compare>
+
 namespace AUI
 {
 
@@ -8,9 +11,10 @@ class Widget;
 /**
  * A weak reference to a Widget object.
  *
- * Registers itself with the associated widget.
- * If the widget is destructed first, it invalidates this reference.
- * If this reference is destructed first, it unregisters itself from the widget.
+ * Holds the index and generation of the widget's WidgetRegistry slot. When
+ * the widget is destructed, the slot's generation changes, which invalidates
+ * every ref to it. Refs don't register themselves with the widget, so they're
+ * trivially copyable and checking validity is O(1).
  *
  * Make sure to check isValid() before accessing the widget.
  *
@@ -26,16 +30,6 @@ class WidgetWeakRef
 public:
     WidgetWeakRef(Widget& inWidget);
 
-    WidgetWeakRef(const WidgetWeakRef& other);
-
-    WidgetWeakRef(WidgetWeakRef&& other);
-
-    ~WidgetWeakRef();
-
-    WidgetWeakRef& operator=(const WidgetWeakRef& other);
-
-    WidgetWeakRef& operator=(WidgetWeakRef&& other);
-
     /**
      * Returns true if the associated widget is still valid (i.e. if it's
      * still alive).
@@ -50,17 +44,27 @@ public:
     Widget& get() const;
 
     /**
-     * Marks the associated widget as invalid.
-     *
-     * Used by the Widget class. You likely don't want to call this directly.
+     * Equal refs refer to the same widget. Ordering is by registry slot, and
+     * is only meant for sorting refs to speed up lookups.
+     * Safe to call on invalid refs.
      */
-    void invalidate();
+    auto operator<=>(const WidgetWeakRef& other) const = default;
 
 private:
-    Widget* widget;
+    /** Friend WidgetPath so it can default construct its inline storage. */
+    friend class WidgetPath;
+
+    /**
+     * Leaves the ref uninitialized. Only for use as storage, never read an
+     * uninitialized ref.
+     */
+    WidgetWeakRef() = default;
+
+    /** The index of the widget's WidgetRegistry slot. */
+    std::uint32_t index;
 
-    /** If true, the widget reference is still valid. */
-    bool widgetIsValid;
+    /** The generation of the slot when this ref was created. */
+    std::uint32_t generation;
 };
 
 } // End namespace AUI
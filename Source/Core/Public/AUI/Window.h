@@ -3,6 +3,8 @@
 #include "AUI/Widget.h"
 #include "AUI/WidgetLocator.h"
 #include <SDL3/SDL_events.h>
+#include <SDL3/SDL_render.h>
+#include <memory>
 #include <vector>
 
 namespace AUI
@@ -29,10 +31,39 @@ namespace AUI
  * Note: To match the expected Widget behavior, a Window's fullExtent and
  *       clippedExtent are window-relative (in this case, meaning x and y are
  *       0). To get a Window's position on the screen, use scaledExtent.
+ *
+ * Render caching:
+ *   Windows that rarely change (HUD frames, backgrounds) can opt in to
+ *   render caching through setIsRenderCached(). A cached window renders its
+ *   children into a texture, and then just draws that texture until
+ *   something in its widget tree is invalidated (through layout or render
+ *   invalidation, see Widget.h).
+ *
+ *   Note: The cache texture holds premultiplied alpha, so translucent
+ *         widgets blend the same way they would when drawn directly.
+ *   Note: Windows that override render() don't use the cache.
+ *
+ * Opacity:
+ *   Windows that fully cover what's underneath them (dialogs, full-screen
+ *   menus) let Screen skip rendering the widgets that they hide. A window's
+ *   opaque extents come from setOpaqueLogicalExtents(), plus the extent of
+ *   each visible widget in our tree that reports itself as opaque (e.g. a
+ *   background Image with no alpha channel or that was marked with
+ *   Image::setIsOpaque(), see Widget::getIsOpaque()).
  */
 class Window : public Widget
 {
 public:
+    /**
+     * Render cache statistics, for checking how well caching is working.
+     */
+    struct RenderCacheStats {
+        /** The number of renders that just drew the cached texture. */
+        std::size_t cacheHitCount{0};
+        /** The number of renders that had to re-render our children. */
+        std::size_t rebuildCount{0};
+    };
+
     Window(const SDL_FRect& inLogicalExtent, const std::string& inDebugName);
 
     virtual ~Window() = default;
@@ -42,10 +73,12 @@ public:
      * given actual-space point.
      *
      * @param actualPoint  The point in actual space to test widgets with.
+     * @param outReuseExtent  See WidgetLocator::getPathUnderPoint().
      * @return A widget path, ordered with the root-most widget at the front
      *         and the leaf-most widget at the back.
      */
-    WidgetPath getPathUnderPoint(const SDL_FPoint& actualPoint) const;
+    WidgetPath getPathUnderPoint(const SDL_FPoint& actualPoint,
+                                 SDL_FRect* outReuseExtent = nullptr) const;
 
     /**
      * Builds a path containing all tracked widgets that are underneath the
@@ -64,6 +97,70 @@ public:
      */
     bool containsWidget(const Widget* widget) const;
 
+    /**
+     * Returns the layout epoch of this window's widget locator. Changes
+     * whenever the window's hit-testable layout changes.
+     */
+    std::size_t getLayoutEpoch() const;
+
+    /**
+     * Replaces the spatial index that this window uses for hit testing.
+     * See WidgetLocatorBackend.
+     *
+     * The window's widgets will be added to the new backend during the next
+     * layout update.
+     */
+    void setLocatorBackend(std::unique_ptr<WidgetLocatorBackend> inBackend);
+
+    /**
+     * If true, this window's contents will be rendered into a cached texture
+     * and only re-rendered when something in its widget tree is invalidated.
+     * See "Render caching" above.
+     */
+    void setIsRenderCached(bool inIsRenderCached);
+
+    bool getIsRenderCached() const;
+
+    /**
+     * Returns the render cache stats that have accumulated since the last
+     * resetRenderCacheStats().
+     */
+    const RenderCacheStats& getRenderCacheStats() const;
+
+    void resetRenderCacheStats();
+
+    /**
+     * Declares the given window-relative logical extents to be fully opaque.
+     * Anything in windows underneath us that's fully within one of these
+     * extents won't be rendered.
+     */
+    void setOpaqueLogicalExtents(const std::vector<SDL_FRect>&
+                                     inOpaqueLogicalExtents);
+
+    /**
+     * Appends our opaque extents to the given vector, in actual screen
+     * space. See "Opacity" above.
+     *
+     * Note: Our extents are cached, and only gathered again after we're
+     *       arranged or a widget in our tree calls invalidateOpacity().
+     */
+    void getOpaqueExtents(std::vector<SDL_FRect>& outOpaqueExtents);
+
+    /**
+     * Returns the number of widgets in this window's current layout.
+     */
+    std::size_t getWidgetCount() const;
+
+    /**
+     * Appends the damage that has accumulated since the last call to the
+     * given vector, in actual screen space, then clears it.
+     *
+     * Damage is added when a widget in our tree is invalidated, when our
+     * arrange pass adds, moves, or removes widgets, and when our extent
+     * changes. Used by Screen's dirty rect rendering.
+     */
+    void takeDamage(std::vector<SDL_FRect>& outDamage);
+
     /**
      * Performs the measure pass.
      *
@@ -72,8 +169,8 @@ public:
     virtual void measure();
 
     /**
-     * Clears the old widget positions from widgetLocator and performs the
-     * arrange pass.
+     * Performs the arrange pass, incrementally updating the widget positions
+     * in widgetLocator.
      *
      * @post This window and all children have up-to-date extents, and are
      *       added to this window's widgetLocator in the correct order.
@@ -90,17 +187,82 @@ public:
     virtual void render();
 
 protected:
+    /**
+     * Adds the given window-relative extent to our damage.
+     */
+    void addDamage(const SDL_FRect& windowExtent) override;
+
+    /**
+     * Marks our cached opaque extents as stale.
+     */
+    void onOpacityInvalidated() override;
+
     /**
      * Used to efficiently build an in-order list of widgets that were hit by
      * e.g. a mouse click event.
-     * This Window's children are added to this locator at the end of their
-     * updateLayout(). Since the layout pass iterates our children in their
-     * rendering order, the locator will end up with a properly ordered grid of
+     * This Window's children are added to this locator during their
+     * arrange(). Since the layout pass iterates our children in their
+     * rendering order, the locator will end up with a properly ordered set of
      * widgets to use for hit testing.
      */
     WidgetLocator widgetLocator;
 
 private:
+    /** The most damage rects that we'll hold before collapsing them into
+        their union. Keeps windows that are never rendered from growing
+        without bound. */
+    static constexpr std::size_t MAX_DAMAGE_RECTS{64};
+
+    /** A deleter to use with our cache texture. */
+    struct TextureDeleter {
+        void operator()(SDL_Texture* p) { SDL_DestroyTexture(p); }
+    };
+
+    /**
+     * Adds the given actual screen-space extent to our damage.
+     */
+    void addScreenDamage(const SDL_FRect& screenExtent);
+
+    /**
+     * Renders all visible children, offset by the given window position.
+     */
+    void renderChildren(const SDL_FPoint& windowTopLeft);
+
+    /**
+     * If renderCacheTexture doesn't match our size, re-creates it.
+     *
+     * @return true if the texture is ready to use, else false (e.g. if the
+     *         renderer doesn't support render targets).
+     */
+    bool refreshCacheTexture();
+
+    /**
+     * Renders our children into renderCacheTexture.
+     */
+    void rebuildRenderCache();
+
+    /** If true, render caching is enabled. */
+    bool isRenderCached;
+
+    /** If render caching is enabled, holds our rendered children. */
+    std::unique_ptr<SDL_Texture, TextureDeleter> renderCacheTexture;
+
+    RenderCacheStats renderCacheStats;
+
+    /** See setOpaqueLogicalExtents(). */
+    std::vector<SDL_FRect> opaqueLogicalExtents;
+
+    /** Our opaque extents in actual screen space, as of the last time they
+        were gathered. See getOpaqueExtents(). */
+    std::vector<SDL_FRect> opaqueExtents;
+
+    /** If true, opaqueExtents needs to be gathered again. */
+    bool opaqueExtentsAreDirty;
+
+    /** The actual screen-space extents that have been damaged since the last
+        takeDamage(). */
+    std::vector<SDL_FRect> damage;
+
     // We hide the Widget measure/arrange/render implementations, because
     // Windows have different needs. Specifically, they don't receive layout
     // info from their parent, and they own their widgetLocator.
@@ -20,6 +20,8 @@ EventRouter::EventRouter(Screen& inScreen)
 , dragPath{}
 , dragOrigin{}
 , dragUnderway{false}
+, hitTestCache{}
+, hitTestStats{}
 {
 }
 
@@ -195,9 +197,7 @@ bool EventRouter::handleMouseMove(SDL_MouseMotionEvent& event)
     }
 
     // If we've dragged a widget past the trigger distance, start a drag event.
-    if (!dragUnderway && !(dragPath.empty())
-        && (SDLHelpers::squaredDistance(dragOrigin, cursorPosition)
-            > Core::getSquaredDragTriggerDistance())) {
+    if (wouldMouseMoveStartDrag(cursorPosition)) {
         // Note: This will also send a MouseLeave event to previously-hovered
         //       widgets, since we're switching to DragEnter/DragLeave.
         routeDragStart();
@@ -215,6 +215,14 @@ bool EventRouter::handleMouseMove(SDL_MouseMotionEvent& event)
     return eventWasHandled;
 }
 
+bool EventRouter::wouldMouseMoveStartDrag(
+    const SDL_FPoint& cursorPosition) const
+{
+    return (!dragUnderway && !(dragPath.empty())
+            && (SDLHelpers::squaredDistance(dragOrigin, cursorPosition)
+                > Core::getSquaredDragTriggerDistance()));
+}
+
 bool EventRouter::handleKeyDown(SDL_KeyboardEvent& event)
 {
     // If we have a valid focused widget, route the event down the focus path.
@@ -302,6 +310,16 @@ Image* EventRouter::getDragDropImage()
     return nullptr;
 }
 
+const EventRouter::HitTestStats& EventRouter::getHitTestStats() const
+{
+    return hitTestStats;
+}
+
+void EventRouter::resetHitTestStats()
+{
+    hitTestStats = {};
+}
+
 MouseButtonType EventRouter::translateSDLButtonType(Uint8 sdlButtonType)
 {
     switch (sdlButtonType) {
@@ -349,13 +367,61 @@ WidgetPath EventRouter::getPathUnderCursor(const SDL_FPoint& cursorPosition)
 {
     // Check if the cursor is hovering over an AUI window.
     Window* hoveredWindow{screen.getWindowUnderPoint(cursorPosition)};
-    if (hoveredWindow != nullptr) {
-        // The cursor is over one of our windows. Return the widget path that
-        // the cursor is hovering over.
-        return hoveredWindow->getPathUnderPoint(cursorPosition);
+    if (hoveredWindow == nullptr) {
+        return WidgetPath{};
     }
 
-    return WidgetPath{};
+    // If the cached path is still good, return it.
+    if (canReuseCachedPath(*hoveredWindow, cursorPosition)) {
+        hitTestStats.cacheHitCount++;
+        return hitTestCache.path;
+    }
+
+    // The cursor is over one of our windows. Find the widget path that the
+    // cursor is hovering over and cache it.
+    hitTestStats.fullLookupCount++;
+    hitTestCache.window = hoveredWindow;
+    hitTestCache.layoutEpoch = hoveredWindow->getLayoutEpoch();
+    hitTestCache.cursorPosition = cursorPosition;
+    hitTestCache.path = hoveredWindow->getPathUnderPoint(
+        cursorPosition, &(hitTestCache.reuseExtent));
+
+    return hitTestCache.path;
+}
+
+bool EventRouter::canReuseCachedPath(const Window& hoveredWindow,
+                                     const SDL_FPoint& cursorPosition) const
+{
+    // If the layout changed, the cached path may be wrong.
+    // Note: Epochs are unique across windows, so this also catches a new
+    //       window at the same address.
+    if ((hitTestCache.window != &hoveredWindow)
+        || (hitTestCache.layoutEpoch != hoveredWindow.getLayoutEpoch())) {
+        return false;
+    }
+
+    // If any of the cached widgets were destroyed, do a fresh lookup so they
+    // get dropped from the path.
+    for (const WidgetWeakRef& widgetRef : hitTestCache.path) {
+        if (!(widgetRef.isValid())) {
+            return false;
+        }
+    }
+
+    // If the cursor didn't move, or it's still strictly within the reuse
+    // extent, the path is the same.
+    // Note: Points on the reuse extent's edges may hit a widget that starts
+    //       there, so they aren't considered safe.
+    if ((cursorPosition.x == hitTestCache.cursorPosition.x)
+        && (cursorPosition.y == hitTestCache.cursorPosition.y)) {
+        return true;
+    }
+
+    const SDL_FRect& reuseExtent{hitTestCache.reuseExtent};
+    return (cursorPosition.x > reuseExtent.x)
+           && (cursorPosition.x < (reuseExtent.x + reuseExtent.w))
+           && (cursorPosition.y > reuseExtent.y)
+           && (cursorPosition.y < (reuseExtent.y + reuseExtent.h));
 }
 
 WidgetPath EventRouter::getPathUnderWidget(const Widget* widget)
@@ -474,22 +540,36 @@ EventRouter::RouterReturnData
 
 void EventRouter::routeMouseEnterAndLeave(WidgetPath& hoverPath)
 {
+    // Skip the part of the paths that hasn't changed. Paths progress down the
+    // widget tree, so this is usually everything but the last few widgets.
+    std::size_t commonCount{0};
+    while ((commonCount < lastHoveredWidgetPath.size())
+           && (commonCount < hoverPath.size())
+           && (lastHoveredWidgetPath[commonCount] == hoverPath[commonCount])) {
+        commonCount++;
+    }
+
+    // Sort the remaining refs so we can binary search them.
+    // Note: These copies are stored inline, so they don't allocate.
+    WidgetPath sortedLastHovered{lastHoveredWidgetPath.begin() + commonCount,
+                                 lastHoveredWidgetPath.end()};
+    std::sort(sortedLastHovered.begin(), sortedLastHovered.end());
+    WidgetPath sortedHovered{hoverPath.begin() + commonCount, hoverPath.end()};
+    std::sort(sortedHovered.begin(), sortedHovered.end());
+
     // Send MouseLeave events to any widgets that are no longer hovered.
-    for (WidgetWeakRef& widgetWeakRef : lastHoveredWidgetPath) {
+    for (auto it{lastHoveredWidgetPath.begin() + commonCount};
+         it != lastHoveredWidgetPath.end(); ++it) {
+        WidgetWeakRef& widgetWeakRef{*it};
+
         // If the widget is gone, skip it.
         if (!(widgetWeakRef.isValid())) {
             continue;
         }
 
-        // Check if the widget is in hoverPath.
-        auto result{std::find_if(hoverPath.begin(), hoverPath.end(),
-                                 [&widgetWeakRef](WidgetWeakRef& refToCompare) {
-                                     return (&(widgetWeakRef.get())
-                                             == &(refToCompare.get()));
-                                 })};
-
         // If the widget is no longer hovered, pass a MouseLeave event to it.
-        if (result == hoverPath.end()) {
+        if (!std::binary_search(sortedHovered.begin(), sortedHovered.end(),
+                                widgetWeakRef)) {
             Widget& widget{widgetWeakRef.get()};
             if (dragUnderway) {
                 widget.onDragLeave();
@@ -501,21 +581,18 @@ void EventRouter::routeMouseEnterAndLeave(WidgetPath& hoverPath)
     }
 
     // Send MouseEnter events to all newly hovered widgets.
-    for (WidgetWeakRef& widgetWeakRef : hoverPath) {
+    for (auto it{hoverPath.begin() + commonCount}; it != hoverPath.end();
+         ++it) {
+        WidgetWeakRef& widgetWeakRef{*it};
+
         // If the widget is gone, skip it.
         if (!(widgetWeakRef.isValid())) {
             continue;
         }
 
-        // Check if the widget is in lastHoveredWidgetPath.
-        auto result{std::find_if(
-            lastHoveredWidgetPath.begin(), lastHoveredWidgetPath.end(),
-            [&widgetWeakRef](WidgetWeakRef& refToCompare) {
-                return (&(widgetWeakRef.get()) == &(refToCompare.get()));
-            })};
-
         // If the widget is new, pass a MouseEnter event to it.
-        if (result == lastHoveredWidgetPath.end()) {
+        if (!std::binary_search(sortedLastHovered.begin(),
+                                sortedLastHovered.end(), widgetWeakRef)) {
             Widget& widget{widgetWeakRef.get()};
             if (dragUnderway) {
                 widget.onDragEnter();
@@ -897,7 +974,7 @@ void EventRouter::setMouseCapture(AUI::Widget* newCaptorWidget)
 
 Widget* EventRouter::getFocusedWidget()
 {
-    if (!focusPath.empty()) {
+    if (!focusPath.empty() && focusPath.back().isValid()) {
         WidgetWeakRef& focusedWidgetRef{focusPath.back()};
         return &(focusedWidgetRef.get());
     }
@@ -11,6 +11,7 @@ namespace AUI
 {
 
 class Screen;
+class Window;
 class Image;
 
 /**
@@ -48,10 +49,27 @@ class Image;
  *   Sometimes you want to receive key events without having focus, e.g.
  *   to open a menu. To do this, use Screen::onKeyDown(). It will receive
  *   any key events that aren't handled by a focused widget.
+ *
+ * Hit Testing:
+ *   The last path found under the cursor is cached, along with the area
+ *   around the cursor that would produce the same path. If the cursor stays
+ *   within that area and the hovered window's layout epoch hasn't changed,
+ *   the cached path is re-used instead of querying the window's locator.
  */
 class EventRouter
 {
 public:
+    /**
+     * Counts how often getPathUnderCursor() was able to re-use its cached
+     * path.
+     */
+    struct HitTestStats {
+        /** The number of lookups that were satisfied by the cache. */
+        std::size_t cacheHitCount{0};
+        /** The number of lookups that had to query a widget locator. */
+        std::size_t fullLookupCount{0};
+    };
+
     EventRouter(Screen& inScreen);
 
     /**
@@ -78,6 +96,16 @@ public:
      */
     bool handleMouseMove(SDL_MouseMotionEvent& event);
 
+    /**
+     * Returns true if a mouse move to the given position would start a drag
+     * (i.e. a draggable widget is pressed and the position is past the drag
+     * trigger distance).
+     *
+     * Used by Screen to avoid coalescing away a motion event that should
+     * start a drag.
+     */
+    bool wouldMouseMoveStartDrag(const SDL_FPoint& cursorPosition) const;
+
     /**
      * Call when a SDL_EVENT_KEY_DOWN event occurs.
      * @return true if the event was consumed, else false.
@@ -106,6 +134,14 @@ public:
      */
     Image* getDragDropImage();
 
+    /**
+     * Returns the hit test stats that have accumulated since the last
+     * resetHitTestStats().
+     */
+    const HitTestStats& getHitTestStats() const;
+
+    void resetHitTestStats();
+
 private:
     /**
      * Used for passing data from an event router function back up to an event
@@ -122,6 +158,22 @@ private:
         WidgetPath::iterator handlerWidget;
     };
 
+    /**
+     * The last path that was found by getPathUnderCursor(), and the
+     * conditions under which it can be re-used.
+     */
+    struct HitTestCache {
+        /** The window that the path was found in. */
+        const Window* window{nullptr};
+        /** The window's layout epoch when the path was found. */
+        std::size_t layoutEpoch{0};
+        /** The cursor position that the path was found at. */
+        SDL_FPoint cursorPosition{};
+        /** The actual-space area that will produce the same path. */
+        SDL_FRect reuseExtent{};
+        WidgetPath path{};
+    };
+
     /**
      * Translates the given SDL button type to our MouseButtonType.
      */
@@ -142,6 +194,13 @@ private:
      */
     WidgetPath getPathUnderCursor(const SDL_FPoint& cursorPosition);
 
+    /**
+     * Returns true if hitTestCache's path can be re-used for the given
+     * cursor position over the given window.
+     */
+    bool canReuseCachedPath(const Window& hoveredWindow,
+                            const SDL_FPoint& cursorPosition) const;
+
     /**
      * Returns a path that traces from the given widget's parent Window, up to
      * the given widget (inclusive).
@@ -260,9 +319,8 @@ private:
     void setMouseCapture(AUI::Widget* newCaptorWidget);
 
     /**
-     * Returns the current focused widget, or nullptr if there is none.
-     * Note: This does not check the validity of the widget. This is mostly
-     *       useful just to get a pointer for comparisons.
+     * Returns the current focused widget, or nullptr if there is none (or
+     * if the focused widget has been destructed).
      */
     Widget* getFocusedWidget();
 
@@ -307,6 +365,12 @@ private:
 
     /** If true, we're currently dragging a widget. */
     bool dragUnderway;
+
+    /** The last path found under the cursor. */
+    HitTestCache hitTestCache;
+
+    /** Hit test cache stats, for checking how well the cache is working. */
+    HitTestStats hitTestStats;
 };
 
 } // End namespace AUI
@@ -1,9 +1,71 @@
 #include "AUI/AssetCache.h"
 #include "AUI/Core.h"
 #include "AUI/Internal/Log.h"
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_timer.h>
+#include <iterator>
+#include <algorithm>
 
 namespace AUI
 {
+/** The default value for asyncUploadBudgetNS (2ms). */
+static constexpr Uint64 DEFAULT_ASYNC_UPLOAD_BUDGET_NS{2'000'000};
+
+/** The default value for generatedTextureBudget (16MiB). */
+static constexpr std::size_t DEFAULT_GENERATED_TEXTURE_BUDGET{
+    16 * 1024 * 1024};
+
+/** The most referenced generated textures that pruneGeneratedTextures()
+    will skip before giving up. */
+static constexpr std::size_t MAX_GENERATED_PRUNE_SKIP_COUNT{8};
+
+/** The maximum number of async worker threads to start. */
+static constexpr unsigned int MAX_ASYNC_WORKER_COUNT{4};
+
+AssetCache::AssetCache()
+: textureCache{}
+, fontCache{}
+, lruList{}
+, generatedLruList{}
+, memoryBudget{0}
+, autoPruneEnabled{false}
+, generatedTextureBytes{0}
+, generatedTextureBudget{DEFAULT_GENERATED_TEXTURE_BUDGET}
+, stats{}
+, glyphAtlas{}
+, fontMutex{}
+, textRasterizer{fontMutex}
+, pendingTextureIDs{}
+, failedTextureIDs{}
+, asyncUploadBudgetNS{DEFAULT_ASYNC_UPLOAD_BUDGET_NS}
+, asyncPlaceholder{}
+, asyncMutex{}
+, asyncCondition{}
+, decodeQueue{}
+, uploadQueue{}
+, asyncWorkersShouldExit{false}
+, asyncWorkers{}
+{
+}
+
+AssetCache::~AssetCache()
+{
+    // Stop our worker threads.
+    {
+        std::scoped_lock lock{asyncMutex};
+        asyncWorkersShouldExit = true;
+    }
+    asyncCondition.notify_all();
+    for (std::thread& worker : asyncWorkers) {
+        worker.join();
+    }
+
+    // Free any surfaces that never got uploaded.
+    for (DecodedSurface& decodedSurface : uploadQueue) {
+        SDL_DestroySurface(decodedSurface.surface);
+    }
+}
+
 std::shared_ptr<SDL_Texture>
     AssetCache::requestTexture(const std::string& textureID,
                                SDL_ScaleMode scaleMode)
@@ -11,8 +73,11 @@ std::shared_ptr<SDL_Texture>
     // If the texture is already in the cache, return it.
     auto it{textureCache.find(textureID)};
     if (it != textureCache.end()) {
-        return it->second;
+        stats.hitCount++;
+        touch(it->second);
+        return it->second.texture;
     }
+    stats.missCount++;
 
     // The ID wasn't found in the cache, assume it's a path to an image and
     // try to load it.
@@ -31,29 +96,178 @@ std::shared_ptr<SDL_Texture>
     SDL_SetTextureScaleMode(texture.get(), scaleMode);
 
     // Save the texture in the cache.
-    textureCache[textureID] = texture;
+    addTextureEntry(textureID, texture, false, false);
+    autoPrune();
 
     return texture;
 }
 
 std::shared_ptr<SDL_Texture>
-    AssetCache::addTexture(SDL_Texture* inTexture, const std::string& textureID)
+    AssetCache::requestTextureAsync(const std::string& textureID,
+                                    SDL_ScaleMode scaleMode)
 {
-    // If a texture with the given ID is already in the cache, free it and
-    // replace it with the given texture.
+    // If the texture is already in the cache, return it.
     auto it{textureCache.find(textureID)};
     if (it != textureCache.end()) {
-        it->second.reset(inTexture,
-                         [](SDL_Texture* p) { SDL_DestroyTexture(p); });
-        return it->second;
+        stats.hitCount++;
+        touch(it->second);
+        return it->second.texture;
+    }
+
+    // If the texture is already being loaded, wait for it.
+    if (pendingTextureIDs.contains(textureID)) {
+        return nullptr;
+    }
+    stats.missCount++;
+
+    // Queue the texture to be decoded.
+    startAsyncWorkers();
+    pendingTextureIDs.insert(textureID);
+    failedTextureIDs.erase(textureID);
+    {
+        std::scoped_lock lock{asyncMutex};
+        decodeQueue.emplace_back(textureID, scaleMode);
+    }
+    asyncCondition.notify_one();
+
+    return nullptr;
+}
+
+std::shared_ptr<SDL_Texture> AssetCache::requestGeneratedTexture(
+    const std::string& textureID,
+    const std::function<SDL_Texture*()>& generateTexture)
+{
+    // If the texture has already been generated, return it.
+    auto it{textureCache.find(textureID)};
+    if (it != textureCache.end()) {
+        stats.hitCount++;
+        touch(it->second);
+        return it->second.texture;
+    }
+    stats.missCount++;
+
+    // Generate the texture.
+    SDL_Texture* rawTexture{generateTexture()};
+    if (rawTexture == nullptr) {
+        return nullptr;
     }
 
     // Wrap the texture in a shared_ptr.
     std::shared_ptr<SDL_Texture> texture{
-        inTexture, [](SDL_Texture* p) { SDL_DestroyTexture(p); }};
+        rawTexture, [](SDL_Texture* p) { SDL_DestroyTexture(p); }};
 
     // Save the texture in the cache.
-    textureCache[textureID] = texture;
+    // Note: Generated textures can be re-generated, so they aren't pinned.
+    addTextureEntry(textureID, texture, false, true);
+    pruneGeneratedTextures();
+    autoPrune();
+
+    return texture;
+}
+
+bool AssetCache::isTextureLoadPending(const std::string& textureID) const
+{
+    return pendingTextureIDs.contains(textureID);
+}
+
+bool AssetCache::didTextureLoadFail(const std::string& textureID) const
+{
+    return failedTextureIDs.contains(textureID);
+}
+
+void AssetCache::processAsyncLoads()
+{
+    // If nothing is pending, there's nothing to upload.
+    if (pendingTextureIDs.empty()) {
+        return;
+    }
+
+    Uint64 startTimeNS{SDL_GetTicksNS()};
+    while (true) {
+        // Grab the next decoded surface, if there is one.
+        DecodedSurface decodedSurface{};
+        {
+            std::scoped_lock lock{asyncMutex};
+            if (uploadQueue.empty()) {
+                break;
+            }
+            decodedSurface = std::move(uploadQueue.front());
+            uploadQueue.pop_front();
+        }
+        pendingTextureIDs.erase(decodedSurface.textureID);
+
+        if (decodedSurface.surface == nullptr) {
+            AUI_LOG_ERROR("Failed to load texture: %s",
+                          decodedSurface.textureID.c_str());
+            failedTextureIDs.insert(decodedSurface.textureID);
+        }
+        else if (textureCache.contains(decodedSurface.textureID)) {
+            // A texture was added with this ID while we were decoding (e.g.
+            // through addTexture()). Keep it instead of overwriting it.
+            SDL_DestroySurface(decodedSurface.surface);
+        }
+        else {
+            // Upload the surface and add the texture to the cache.
+            SDL_Texture* rawTexture{SDL_CreateTextureFromSurface(
+                Core::getRenderer(), decodedSurface.surface)};
+            SDL_DestroySurface(decodedSurface.surface);
+            if (rawTexture == nullptr) {
+                AUI_LOG_ERROR("Failed to upload texture: %s",
+                              decodedSurface.textureID.c_str());
+            }
+            else {
+                std::shared_ptr<SDL_Texture> texture{
+                    rawTexture, [](SDL_Texture* p) { SDL_DestroyTexture(p); }};
+                SDL_SetTextureScaleMode(texture.get(),
+                                        decodedSurface.scaleMode);
+
+                // Note: We don't auto prune here, since nothing references
+                //       the new texture yet. The next request will prune.
+                addTextureEntry(decodedSurface.textureID, texture, false,
+                                false);
+            }
+        }
+
+        // If we've used up our budget, leave the rest for the next frame.
+        if ((SDL_GetTicksNS() - startTimeNS) >= asyncUploadBudgetNS) {
+            break;
+        }
+    }
+}
+
+void AssetCache::setAsyncUploadBudget(Uint64 inAsyncUploadBudgetNS)
+{
+    asyncUploadBudgetNS = inAsyncUploadBudgetNS;
+}
+
+void AssetCache::setAsyncPlaceholder(const std::string& textureID,
+                                     SDL_ScaleMode scaleMode)
+{
+    if (textureID.empty()) {
+        asyncPlaceholder = nullptr;
+    }
+    else {
+        asyncPlaceholder = requestTexture(textureID, scaleMode);
+    }
+}
+
+const std::shared_ptr<SDL_Texture>& AssetCache::getAsyncPlaceholder() const
+{
+    return asyncPlaceholder;
+}
+
+std::shared_ptr<SDL_Texture>
+    AssetCache::addTexture(SDL_Texture* inTexture, const std::string& textureID)
+{
+    // Wrap the texture in a shared_ptr.
+    std::shared_ptr<SDL_Texture> texture{
+        inTexture, [](SDL_Texture* p) { SDL_DestroyTexture(p); }};
+
+    // Save the texture in the cache, replacing any existing texture with the
+    // given ID.
+    // Note: Since we can't reload user-added textures, they're pinned.
+    addTextureEntry(textureID, texture, true, false);
+    autoPrune();
 
     return texture;
 }
@@ -70,11 +284,18 @@ std::shared_ptr<TTF_Font> AssetCache::requestFont(const std::string& fontPath,
     // If the font is already loaded, return it.
     auto it = fontCache.find(idString);
     if (it != fontCache.end()) {
-        return it->second;
+        stats.hitCount++;
+        touch(it->second.lruIt);
+        return it->second.font;
     }
+    stats.missCount++;
 
     // Load the font.
-    TTF_Font* rawFont{TTF_OpenFont(fontPath.c_str(), fontSize)};
+    TTF_Font* rawFont{nullptr};
+    {
+        std::scoped_lock lock{fontMutex};
+        rawFont = TTF_OpenFont(fontPath.c_str(), fontSize);
+    }
     if (rawFont == nullptr) {
         AUI_LOG_ERROR("Failed to load font: %s", fontPath.c_str());
         return nullptr;
@@ -89,10 +310,255 @@ std::shared_ptr<TTF_Font> AssetCache::requestFont(const std::string& fontPath,
         TTF_SetFontOutline(font.get(), fontOutlineSize);
     }
 
+    // Estimate the font's size using its file size (the font data is kept in
+    // memory while the font is open).
+    SDL_PathInfo pathInfo{};
+    std::size_t byteSize{0};
+    if (SDL_GetPathInfo(fontPath.c_str(), &pathInfo)) {
+        byteSize = static_cast<std::size_t>(pathInfo.size);
+    }
+
     // Save the font in the cache.
-    fontCache[idString] = font;
+    lruList.push_back({AssetType::Font, idString});
+    fontCache[idString]
+        = {font, fontPath, fontSize, byteSize, std::prev(lruList.end())};
+    stats.residentBytes += byteSize;
+    autoPrune();
 
     return font;
 }
 
+GlyphAtlas& AssetCache::getGlyphAtlas()
+{
+    return glyphAtlas;
+}
+
+TextRasterizer& AssetCache::getTextRasterizer()
+{
+    return textRasterizer;
+}
+
+void AssetCache::setMemoryBudget(std::size_t inMemoryBudget)
+{
+    memoryBudget = inMemoryBudget;
+}
+
+void AssetCache::setGeneratedTextureBudget(
+    std::size_t inGeneratedTextureBudget)
+{
+    generatedTextureBudget = inGeneratedTextureBudget;
+}
+
+void AssetCache::setAutoPruneEnabled(bool inAutoPruneEnabled)
+{
+    autoPruneEnabled = inAutoPruneEnabled;
+}
+
+std::size_t AssetCache::prune()
+{
+    // Walk from the least recently used asset to the most recently used,
+    // evicting until we're within budget.
+    std::size_t evictedCount{0};
+    for (auto lruIt{lruList.begin()}; lruIt != lruList.end();) {
+        if ((memoryBudget != 0) && (stats.residentBytes <= memoryBudget)) {
+            break;
+        }
+
+        auto nextIt{std::next(lruIt)};
+        if (tryEvict(lruIt)) {
+            evictedCount++;
+        }
+        lruIt = nextIt;
+    }
+
+    stats.evictionCount += evictedCount;
+    return evictedCount;
+}
+
+const AssetCache::Stats& AssetCache::getStats() const
+{
+    return stats;
+}
+
+void AssetCache::addTextureEntry(const std::string& textureID,
+                                 std::shared_ptr<SDL_Texture> texture,
+                                 bool isPinned, bool isGenerated)
+{
+    std::size_t byteSize{calcTextureByteSize(texture.get())};
+
+    // If a previous async load of this ID failed, it no longer matters.
+    failedTextureIDs.erase(textureID);
+
+    // If a texture with the given ID is already in the cache, replace it.
+    auto it{textureCache.find(textureID)};
+    if (it != textureCache.end()) {
+        TextureEntry& entry{it->second};
+        stats.residentBytes -= entry.byteSize;
+        if (entry.isGenerated) {
+            generatedTextureBytes -= entry.byteSize;
+            generatedLruList.erase(entry.generatedLruIt);
+        }
+        entry.texture = std::move(texture);
+        entry.byteSize = byteSize;
+        entry.isPinned = isPinned;
+        entry.isGenerated = isGenerated;
+        touch(entry.lruIt);
+    }
+    else {
+        lruList.push_back({AssetType::Texture, textureID});
+        it = textureCache
+                 .emplace(textureID,
+                          TextureEntry{std::move(texture), byteSize, isPinned,
+                                       isGenerated, std::prev(lruList.end())})
+                 .first;
+    }
+
+    stats.residentBytes += byteSize;
+    if (isGenerated) {
+        // Note: Map nodes don't move, so it's safe to hold a pointer.
+        TextureEntry& entry{it->second};
+        generatedTextureBytes += byteSize;
+        generatedLruList.push_back(&entry);
+        entry.generatedLruIt = std::prev(generatedLruList.end());
+    }
+}
+
+void AssetCache::touch(LruList::iterator lruIt)
+{
+    // Move the entry to the back (most recently used).
+    lruList.splice(lruList.end(), lruList, lruIt);
+}
+
+void AssetCache::touch(TextureEntry& entry)
+{
+    touch(entry.lruIt);
+    if (entry.isGenerated) {
+        generatedLruList.splice(generatedLruList.end(), generatedLruList,
+                                entry.generatedLruIt);
+    }
+}
+
+void AssetCache::autoPrune()
+{
+    if (autoPruneEnabled && (memoryBudget != 0)
+        && (stats.residentBytes > memoryBudget)) {
+        prune();
+    }
+}
+
+void AssetCache::pruneGeneratedTextures()
+{
+    // Walk from the least recently used generated texture to the most
+    // recently used, evicting until we're within budget.
+    std::size_t evictedCount{0};
+    std::size_t skippedCount{0};
+    while ((generatedTextureBytes > generatedTextureBudget)
+           && !(generatedLruList.empty())
+           && (skippedCount < MAX_GENERATED_PRUNE_SKIP_COUNT)) {
+        // If the texture is still in use, move it to the back and skip it.
+        TextureEntry& entry{*(generatedLruList.front())};
+        if (tryEvict(entry.lruIt)) {
+            evictedCount++;
+        }
+        else {
+            touch(entry);
+            skippedCount++;
+        }
+    }
+
+    stats.evictionCount += evictedCount;
+}
+
+bool AssetCache::tryEvict(LruList::iterator lruIt)
+{
+    if (lruIt->type == AssetType::Texture) {
+        auto textureIt{textureCache.find(lruIt->id)};
+        TextureEntry& entry{textureIt->second};
+
+        // If the texture is pinned or is still referenced, skip it.
+        if (entry.isPinned || (entry.texture.use_count() > 1)) {
+            return false;
+        }
+
+        stats.residentBytes -= entry.byteSize;
+        if (entry.isGenerated) {
+            generatedTextureBytes -= entry.byteSize;
+            generatedLruList.erase(entry.generatedLruIt);
+        }
+        textureCache.erase(textureIt);
+    }
+    else {
+        auto fontIt{fontCache.find(lruIt->id)};
+        FontEntry& entry{fontIt->second};
+
+        // If the font is still referenced, skip it.
+        if (entry.font.use_count() > 1) {
+            return false;
+        }
+
+        // Remove the font's glyphs from the atlas, since a new font may be
+        // allocated at the same address.
+        glyphAtlas.removeFont(entry.font.get());
+
+        // Have the text rasterizer's workers close their copies of the font.
+        textRasterizer.closeFont(entry.fontPath, entry.fontSize);
+
+        stats.residentBytes -= entry.byteSize;
+        std::scoped_lock lock{fontMutex};
+        fontCache.erase(fontIt);
+    }
+
+    lruList.erase(lruIt);
+    return true;
+}
+
+void AssetCache::startAsyncWorkers()
+{
+    if (!(asyncWorkers.empty())) {
+        return;
+    }
+
+    // Leave a core for the main thread.
+    unsigned int workerCount{std::thread::hardware_concurrency()};
+    workerCount = std::clamp(workerCount, 2u, MAX_ASYNC_WORKER_COUNT + 1) - 1;
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        asyncWorkers.emplace_back(&AssetCache::asyncWorkerLoop, this);
+    }
+}
+
+void AssetCache::asyncWorkerLoop()
+{
+    while (true) {
+        // Wait for an image to decode.
+        std::pair<std::string, SDL_ScaleMode> request{};
+        {
+            std::unique_lock lock{asyncMutex};
+            asyncCondition.wait(lock, [this] {
+                return asyncWorkersShouldExit || !(decodeQueue.empty());
+            });
+            if (asyncWorkersShouldExit) {
+                return;
+            }
+
+            request = std::move(decodeQueue.front());
+            decodeQueue.pop_front();
+        }
+
+        // Decode the image.
+        // Note: Only the upload to a texture needs to be on the main thread.
+        SDL_Surface* surface{IMG_Load(request.first.c_str())};
+
+        // Pass it back to the main thread.
+        std::scoped_lock lock{asyncMutex};
+        uploadQueue.push_back({std::move(request.first), request.second,
+                               surface});
+    }
+}
+
+std::size_t AssetCache::calcTextureByteSize(SDL_Texture* texture)
+{
+    return (static_cast<std::size_t>(texture->w) * texture->h
+            * SDL_BYTESPERPIXEL(texture->format));
+}
+
 } // End namespace AUI
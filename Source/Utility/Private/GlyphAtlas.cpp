@@ -0,0 +1,204 @@
+#include "AUI/GlyphAtlas.h"
+#include "AUI/Core.h"
+#include "AUI/Internal/Log.h"
+#include <algorithm>
+
+namespace AUI
+{
+/** The empty space to leave between glyphs, so that filtering doesn't bleed
+    neighboring glyphs into each other. */
+static constexpr int GLYPH_PADDING{1};
+
+GlyphAtlas::GlyphAtlas()
+: pages{}
+, glyphMap{}
+{
+}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+const GlyphAtlas::Glyph& GlyphAtlas::getGlyph(TTF_Font* font,
+                                              Uint32 codepoint)
+{
+    // If the glyph is already in the atlas, return it.
+    GlyphKey key{font, codepoint};
+    auto glyphIt{glyphMap.find(key)};
+    if (glyphIt != glyphMap.end()) {
+        return glyphIt->second;
+    }
+
+    // The glyph wasn't found, render it and add it.
+    auto newGlyphIt{glyphMap.emplace(key, addGlyph(font, codepoint)).first};
+    return newGlyphIt->second;
+}
+
+void GlyphAtlas::removeFont(TTF_Font* font)
+{
+    std::erase_if(glyphMap, [font](const auto& glyphPair) {
+        return (glyphPair.first.font == font);
+    });
+
+    // Remove the font from its pages.
+    for (Page& page : pages) {
+        std::erase(page.fonts, font);
+    }
+
+    // If every page is unused, keep the first one around since we'll likely
+    // need it again. Its shelves are cleared so its space can be re-used.
+    auto isUnused{[](const Page& page) { return page.fonts.empty(); }};
+    auto firstPageIt{pages.begin()};
+    if (!(pages.empty()) && std::all_of(pages.begin(), pages.end(), isUnused)) {
+        pages[0].shelves.clear();
+        firstPageIt++;
+    }
+
+    // Free any other pages that are no longer used.
+    pages.erase(std::remove_if(firstPageIt, pages.end(), isUnused),
+                pages.end());
+}
+
+std::size_t GlyphAtlas::getPageCount() const
+{
+    return pages.size();
+}
+
+std::size_t GlyphAtlas::getGlyphCount() const
+{
+    return glyphMap.size();
+}
+
+GlyphAtlas::Glyph GlyphAtlas::addGlyph(TTF_Font* font, Uint32 codepoint)
+{
+    Glyph glyph{};
+
+    // Get the glyph's metrics.
+    int minX{0};
+    int advance{0};
+    if (!TTF_GetGlyphMetrics(font, codepoint, &minX, nullptr, nullptr,
+                             nullptr, &advance)) {
+        // The font doesn't have this glyph. Leave it empty so that we don't
+        // keep trying to render it.
+        return glyph;
+    }
+    glyph.xOffset = std::min(minX, 0);
+    glyph.advance = advance;
+
+    // Render the glyph in white, so it can be tinted using vertex colors.
+    SDL_Surface* glyphSurface{
+        TTF_RenderGlyph_Blended(font, codepoint, {255, 255, 255, 255})};
+    if (glyphSurface == nullptr) {
+        // Some glyphs (e.g. spaces) may not have an image. We'll still use
+        // their advance.
+        return glyph;
+    }
+
+    // Convert the surface to match our page format.
+    SDL_Surface* convertedSurface{
+        SDL_ConvertSurface(glyphSurface, SDL_PIXELFORMAT_ARGB8888)};
+    SDL_DestroySurface(glyphSurface);
+    if (convertedSurface == nullptr) {
+        AUI_LOG_FATAL("Failed to convert glyph surface.");
+    }
+
+    // Find a spot for the glyph and copy it into the page.
+    SDL_Rect spot{};
+    Page& page{
+        allocateSpot(font, convertedSurface->w, convertedSurface->h, spot)};
+    SDL_UpdateTexture(page.texture.get(), &spot, convertedSurface->pixels,
+                      convertedSurface->pitch);
+    SDL_DestroySurface(convertedSurface);
+
+    glyph.page = page.texture.get();
+    glyph.texExtent = {static_cast<float>(spot.x), static_cast<float>(spot.y),
+                       static_cast<float>(spot.w), static_cast<float>(spot.h)};
+
+    return glyph;
+}
+
+GlyphAtlas::Page& GlyphAtlas::allocateSpot(TTF_Font* font, int width,
+                                           int height, SDL_Rect& outSpot)
+{
+    if (((width + GLYPH_PADDING) > PAGE_SIZE)
+        || ((height + GLYPH_PADDING) > PAGE_SIZE)) {
+        AUI_LOG_FATAL("Glyph is too large for the atlas. Size: %d x %d",
+                      width, height);
+    }
+
+    // Try to fit the glyph into one of our existing pages.
+    Page* page{nullptr};
+    for (Page& existingPage : pages) {
+        if (allocateSpotInPage(existingPage, width, height, outSpot)) {
+            page = &existingPage;
+            break;
+        }
+    }
+
+    // If all of our pages are full, add a new one.
+    if (page == nullptr) {
+        page = &(addPage());
+        allocateSpotInPage(*page, width, height, outSpot);
+    }
+
+    // Track the font, so we know when the page can be freed.
+    if (std::find(page->fonts.begin(), page->fonts.end(), font)
+        == page->fonts.end()) {
+        page->fonts.push_back(font);
+    }
+
+    return *page;
+}
+
+bool GlyphAtlas::allocateSpotInPage(Page& page, int width, int height,
+                                    SDL_Rect& outSpot)
+{
+    int paddedWidth{width + GLYPH_PADDING};
+    int paddedHeight{height + GLYPH_PADDING};
+
+    // Try to fit the glyph into an existing shelf.
+    // Note: Glyphs from a given font are mostly the same height, so shelves
+    //       fill up pretty evenly.
+    for (Shelf& shelf : page.shelves) {
+        if ((paddedHeight <= shelf.height)
+            && ((shelf.nextX + paddedWidth) <= PAGE_SIZE)) {
+            outSpot = {shelf.nextX, shelf.y, width, height};
+            shelf.nextX += paddedWidth;
+            return true;
+        }
+    }
+
+    // Try to add a new shelf below the last one.
+    int nextShelfY{0};
+    if (!(page.shelves.empty())) {
+        const Shelf& lastShelf{page.shelves.back()};
+        nextShelfY = lastShelf.y + lastShelf.height;
+    }
+    if ((nextShelfY + paddedHeight) > PAGE_SIZE) {
+        // This page is full.
+        return false;
+    }
+
+    page.shelves.push_back({nextShelfY, paddedHeight, paddedWidth});
+    outSpot = {0, nextShelfY, width, height};
+    return true;
+}
+
+GlyphAtlas::Page& GlyphAtlas::addPage()
+{
+    SDL_Texture* texture{SDL_CreateTexture(
+        Core::getRenderer(), SDL_PIXELFORMAT_ARGB8888,
+        SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE)};
+    if (texture == nullptr) {
+        AUI_LOG_FATAL("Failed to create glyph atlas page.");
+    }
+
+    // Glyphs are drawn at their native size, so we don't want any filtering.
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+
+    pages.emplace_back();
+    pages.back().texture
+        = std::unique_ptr<SDL_Texture, TextureDeleter>(texture);
+    return pages.back();
+}
+
+} // namespace AUI
@@ -0,0 +1,315 @@
+#include "AUI/RenderCommandList.h"
+#include "AUI/Core.h"
+#include "AUI/SDLHelpers.h"
+#include <algorithm>
+
+namespace AUI
+{
+RenderCommandList::RenderCommandList()
+: batches{}
+, batchCount{0}
+, offsetVertices{}
+, batchingEnabled{false}
+, hasCullExtent{false}
+, cullExtent{}
+, occluders{}
+, cullingIsSuspended{false}
+, stats{}
+{
+}
+
+void RenderCommandList::setBatchingEnabled(bool inBatchingEnabled)
+{
+    if (batchingEnabled && !inBatchingEnabled) {
+        flush();
+    }
+
+    batchingEnabled = inBatchingEnabled;
+}
+
+bool RenderCommandList::getBatchingEnabled() const
+{
+    return batchingEnabled;
+}
+
+void RenderCommandList::addTexturedQuad(SDL_Texture* texture,
+                                        const SDL_FRect& srcRect,
+                                        const SDL_FRect& dstRect,
+                                        float alphaMod)
+{
+    stats.commandCount++;
+
+    // If we aren't batching, draw the texture immediately.
+    if (!batchingEnabled) {
+        SDL_SetTextureAlphaModFloat(texture, alphaMod);
+        SDL_RenderTexture(Core::getRenderer(), texture, &srcRect, &dstRect);
+        stats.drawCallCount++;
+        return;
+    }
+
+    // Convert the source rect to normalized texture coordinates.
+    float textureWidth{static_cast<float>(texture->w)};
+    float textureHeight{static_cast<float>(texture->h)};
+    SDL_FRect texCoords{srcRect.x / textureWidth, srcRect.y / textureHeight,
+                        srcRect.w / textureWidth, srcRect.h / textureHeight};
+
+    // Note: Batched quads apply their alpha through their vertex colors,
+    //       since textures may be shared by images with different alphas.
+    Batch& batch{findBatch(texture, nullptr, dstRect)};
+    addQuad(batch, dstRect, texCoords, {1.f, 1.f, 1.f, alphaMod});
+}
+
+void RenderCommandList::addFilledRect(const SDL_FRect& rect,
+                                      const SDL_Color& color)
+{
+    stats.commandCount++;
+
+    // If we aren't batching, draw the rect immediately.
+    if (!batchingEnabled) {
+        SDL_Renderer* renderer{Core::getRenderer()};
+
+        // Save the current draw color to re-apply later.
+        SDL_Color originalColor{};
+        SDL_GetRenderDrawColor(renderer, &originalColor.r, &originalColor.g,
+                               &originalColor.b, &originalColor.a);
+
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderFillRect(renderer, &rect);
+        stats.drawCallCount++;
+
+        SDL_SetRenderDrawColor(renderer, originalColor.r, originalColor.g,
+                               originalColor.b, originalColor.a);
+        return;
+    }
+
+    Batch& batch{findBatch(nullptr, nullptr, rect)};
+    addQuad(batch, rect, {},
+            {color.r / 255.f, color.g / 255.f, color.b / 255.f,
+             color.a / 255.f});
+}
+
+void RenderCommandList::addGeometry(SDL_Texture* texture,
+                                    std::span<const SDL_Vertex> vertices,
+                                    std::span<const int> indices,
+                                    const SDL_FPoint& offset,
+                                    const SDL_Rect* clipRect)
+{
+    if (vertices.empty() || indices.empty()) {
+        return;
+    }
+    stats.commandCount++;
+
+    // If we aren't batching, offset the vertices and draw them immediately.
+    if (!batchingEnabled) {
+        offsetVertices.assign(vertices.begin(), vertices.end());
+        for (SDL_Vertex& vertex : offsetVertices) {
+            vertex.position.x += offset.x;
+            vertex.position.y += offset.y;
+        }
+
+        drawGeometry(texture, offsetVertices.data(),
+                     static_cast<int>(offsetVertices.size()), indices.data(),
+                     static_cast<int>(indices.size()), clipRect);
+        return;
+    }
+
+    // Calc the bounds of the geometry.
+    SDL_FRect bounds{vertices[0].position.x + offset.x,
+                     vertices[0].position.y + offset.y, 0, 0};
+    float maxX{bounds.x};
+    float maxY{bounds.y};
+    for (const SDL_Vertex& vertex : vertices) {
+        bounds.x = std::min(bounds.x, vertex.position.x + offset.x);
+        bounds.y = std::min(bounds.y, vertex.position.y + offset.y);
+        maxX = std::max(maxX, vertex.position.x + offset.x);
+        maxY = std::max(maxY, vertex.position.y + offset.y);
+    }
+    bounds.w = maxX - bounds.x;
+    bounds.h = maxY - bounds.y;
+
+    // Add the geometry to a batch, re-basing its indices onto the batch's
+    // vertices.
+    Batch& batch{findBatch(texture, clipRect, bounds)};
+    int baseIndex{static_cast<int>(batch.vertices.size())};
+    for (const SDL_Vertex& vertex : vertices) {
+        SDL_Vertex& newVertex{batch.vertices.emplace_back(vertex)};
+        newVertex.position.x += offset.x;
+        newVertex.position.y += offset.y;
+    }
+    for (int index : indices) {
+        batch.indices.push_back(baseIndex + index);
+    }
+}
+
+void RenderCommandList::flush()
+{
+    for (std::size_t i = 0; i < batchCount; ++i) {
+        Batch& batch{batches[i]};
+        drawGeometry(batch.texture, batch.vertices.data(),
+                     static_cast<int>(batch.vertices.size()),
+                     batch.indices.data(),
+                     static_cast<int>(batch.indices.size()),
+                     (batch.hasClipRect ? &(batch.clipRect) : nullptr));
+
+        // Clear the batch, keeping its memory for the next frame.
+        batch.vertices.clear();
+        batch.indices.clear();
+    }
+
+    batchCount = 0;
+}
+
+void RenderCommandList::setCullExtent(const SDL_FRect* inCullExtent)
+{
+    hasCullExtent = (inCullExtent != nullptr);
+    cullExtent = (inCullExtent != nullptr) ? *inCullExtent : SDL_FRect{};
+}
+
+const SDL_FRect* RenderCommandList::getCullExtent() const
+{
+    return (hasCullExtent ? &cullExtent : nullptr);
+}
+
+void RenderCommandList::setOccluders(std::span<const SDL_FRect> inOccluders)
+{
+    occluders = inOccluders;
+}
+
+void RenderCommandList::setCullingSuspended(bool inCullingSuspended)
+{
+    cullingIsSuspended = inCullingSuspended;
+}
+
+bool RenderCommandList::isCulled(const SDL_FRect& screenExtent)
+{
+    if (cullingIsSuspended) {
+        return false;
+    }
+
+    if (hasCullExtent
+        && !SDL_HasRectIntersectionFloat(&screenExtent, &cullExtent)) {
+        return true;
+    }
+
+    for (const SDL_FRect& occluder : occluders) {
+        if (SDLHelpers::rectContainsRect(occluder, screenExtent)) {
+            stats.occludedCount++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const RenderCommandList::Stats& RenderCommandList::getStats() const
+{
+    return stats;
+}
+
+void RenderCommandList::resetStats()
+{
+    stats = {};
+}
+
+RenderCommandList::Batch&
+    RenderCommandList::findBatch(SDL_Texture* texture, const SDL_Rect* clipRect,
+                                 const SDL_FRect& bounds)
+{
+    // Search backwards for a batch with a matching texture and clip rect.
+    // If we pass a batch that overlaps the new command, we have to stop,
+    // since adding the command to an earlier batch would draw it underneath.
+    std::size_t searchEnd{
+        (batchCount > MAX_BATCH_SEARCH_DEPTH)
+            ? (batchCount - MAX_BATCH_SEARCH_DEPTH)
+            : 0};
+    for (std::size_t i = batchCount; i > searchEnd; --i) {
+        Batch& batch{batches[i - 1]};
+        bool clipRectsMatch{
+            (clipRect == nullptr)
+                ? !(batch.hasClipRect)
+                : (batch.hasClipRect
+                   && SDL_RectsEqual(clipRect, &(batch.clipRect)))};
+        if ((batch.texture == texture) && clipRectsMatch) {
+            SDL_GetRectUnionFloat(&(batch.bounds), &bounds, &(batch.bounds));
+            return batch;
+        }
+
+        if (SDL_HasRectIntersectionFloat(&(batch.bounds), &bounds)) {
+            break;
+        }
+    }
+
+    // No batch was found, start a new one.
+    if (batchCount == batches.size()) {
+        batches.emplace_back();
+    }
+    Batch& newBatch{batches[batchCount]};
+    batchCount++;
+
+    newBatch.texture = texture;
+    newBatch.hasClipRect = (clipRect != nullptr);
+    newBatch.clipRect = (clipRect != nullptr) ? *clipRect : SDL_Rect{};
+    newBatch.bounds = bounds;
+    return newBatch;
+}
+
+void RenderCommandList::addQuad(Batch& batch, const SDL_FRect& dstRect,
+                                const SDL_FRect& texCoords,
+                                const SDL_FColor& color)
+{
+    int baseIndex{static_cast<int>(batch.vertices.size())};
+    float right{dstRect.x + dstRect.w};
+    float bottom{dstRect.y + dstRect.h};
+    float texRight{texCoords.x + texCoords.w};
+    float texBottom{texCoords.y + texCoords.h};
+
+    batch.vertices.push_back(
+        {{dstRect.x, dstRect.y}, color, {texCoords.x, texCoords.y}});
+    batch.vertices.push_back(
+        {{right, dstRect.y}, color, {texRight, texCoords.y}});
+    batch.vertices.push_back({{right, bottom}, color, {texRight, texBottom}});
+    batch.vertices.push_back(
+        {{dstRect.x, bottom}, color, {texCoords.x, texBottom}});
+
+    for (int index : {0, 1, 2, 0, 2, 3}) {
+        batch.indices.push_back(baseIndex + index);
+    }
+}
+
+void RenderCommandList::drawGeometry(SDL_Texture* texture,
+                                     const SDL_Vertex* vertices,
+                                     int vertexCount, const int* indices,
+                                     int indexCount, const SDL_Rect* clipRect)
+{
+    SDL_Renderer* renderer{Core::getRenderer()};
+
+    // If there's no clip rect, just draw.
+    if (clipRect == nullptr) {
+        SDL_RenderGeometry(renderer, texture, vertices, vertexCount, indices,
+                           indexCount);
+        stats.drawCallCount++;
+        return;
+    }
+
+    // Apply the clip rect, respecting any clip rect that's already set.
+    SDL_Rect finalClipRect{*clipRect};
+    SDL_Rect oldClipRect{};
+    bool hadClipRect{SDL_RenderClipEnabled(renderer)};
+    if (hadClipRect) {
+        SDL_GetRenderClipRect(renderer, &oldClipRect);
+        if (!SDL_GetRectIntersection(clipRect, &oldClipRect,
+                                     &finalClipRect)) {
+            return;
+        }
+    }
+    SDL_SetRenderClipRect(renderer, &finalClipRect);
+
+    SDL_RenderGeometry(renderer, texture, vertices, vertexCount, indices,
+                       indexCount);
+    stats.drawCallCount++;
+
+    // Restore the previous clip rect.
+    SDL_SetRenderClipRect(renderer, (hadClipRect ? &oldClipRect : nullptr));
+}
+
+} // namespace AUI
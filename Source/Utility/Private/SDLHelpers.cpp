@@ -19,5 +19,12 @@ float SDLHelpers::squaredDistance(const SDL_FPoint& pointA,
     return std::abs(xDif + yDif);
 }
 
+bool SDLHelpers::rectContainsRect(const SDL_FRect& outerRect,
+                                  const SDL_FRect& innerRect)
+{
+    return (innerRect.x >= outerRect.x) && (innerRect.y >= outerRect.y)
+           && ((innerRect.x + innerRect.w) <= (outerRect.x + outerRect.w))
+           && ((innerRect.y + innerRect.h) <= (outerRect.y + outerRect.h));
+}
 
 } // namespace AUI
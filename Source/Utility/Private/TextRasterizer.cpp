@@ -0,0 +1,457 @@
+#include "AUI/TextRasterizer.h"
+#include <string_view>
+#include <algorithm>
+#include <cmath>
+
+namespace AUI
+{
+/** The maximum number of worker threads to start.
+    Note: Each worker opens its own copy of every font it uses, so we keep
+          this low. */
+static constexpr unsigned int MAX_WORKER_COUNT{2};
+
+/** The maximum number of fonts that each worker thread keeps open. When a
+    worker needs another font, it closes its least recently used one. */
+static constexpr std::size_t MAX_WORKER_FONT_COUNT{8};
+
+/**
+ * Returns the ID that workers use for the given font.
+ */
+static std::string getWorkerFontID(const std::string& fontPath,
+                                   float fontSize)
+{
+    // "fontPath_fontSize"
+    return fontPath + "_" + std::to_string(fontSize);
+}
+
+TextRasterizer::TextRasterizer(std::mutex& inFontMutex)
+: fontMutex{inFontMutex}
+, nextJobID{1}
+, jobMutex{}
+, jobCondition{}
+, jobQueue{}
+, results{}
+, cancelledJobIDs{}
+, fontsToClose{}
+, workersShouldExit{false}
+, workers{}
+{
+}
+
+TextRasterizer::~TextRasterizer()
+{
+    // Stop our worker threads.
+    {
+        std::scoped_lock lock{jobMutex};
+        workersShouldExit = true;
+    }
+    jobCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Free any results that were never taken.
+    for (auto& [jobID, surface] : results) {
+        SDL_DestroySurface(surface);
+    }
+}
+
+SDL_Surface* TextRasterizer::rasterize(const Request& request, TTF_Font* font)
+{
+    // If the text string is empty, render a space instead.
+    std::string_view textToRender{request.text};
+    if (textToRender.empty()) {
+        textToRender = " ";
+    }
+
+    // Render the text image using the requested renderMode.
+    const SDL_Color& color{request.color};
+    const SDL_Color& backgroundColor{request.backgroundColor};
+    SDL_Surface* surface{nullptr};
+    if (request.wrapWidth >= 0) {
+        switch (request.renderMode) {
+            case RenderMode::Solid:
+                surface = TTF_RenderText_Solid_Wrapped(
+                    font, textToRender.data(), textToRender.size(), color,
+                    request.wrapWidth);
+                break;
+            case RenderMode::Shaded:
+                surface = TTF_RenderText_Shaded_Wrapped(
+                    font, textToRender.data(), textToRender.size(), color,
+                    backgroundColor, request.wrapWidth);
+                break;
+            case RenderMode::Blended:
+                surface = TTF_RenderText_Blended_Wrapped(
+                    font, textToRender.data(), textToRender.size(), color,
+                    request.wrapWidth);
+                break;
+            case RenderMode::LCD:
+                surface = TTF_RenderText_LCD_Wrapped(
+                    font, textToRender.data(), textToRender.size(), color,
+                    backgroundColor, request.wrapWidth);
+                break;
+        }
+    }
+    else {
+        switch (request.renderMode) {
+            case RenderMode::Solid:
+                surface = TTF_RenderText_Solid(font, textToRender.data(),
+                                               textToRender.size(), color);
+                break;
+            case RenderMode::Shaded:
+                surface = TTF_RenderText_Shaded(font, textToRender.data(),
+                                                textToRender.size(), color,
+                                                backgroundColor);
+                break;
+            case RenderMode::Blended:
+                surface = TTF_RenderText_Blended(font, textToRender.data(),
+                                                 textToRender.size(), color);
+                break;
+            case RenderMode::LCD:
+                surface = TTF_RenderText_LCD(font, textToRender.data(),
+                                             textToRender.size(), color,
+                                             backgroundColor);
+                break;
+        }
+    }
+
+    // If we have an outline, add it.
+    if ((surface != nullptr) && (request.fontOutlineSize > 0)) {
+        surface = addOutline(surface, request.fontOutlineSize);
+    }
+
+    return surface;
+}
+
+TextRasterizer::JobID
+    TextRasterizer::requestRasterization(const Request& request)
+{
+    startWorkers();
+
+    JobID jobID{nextJobID++};
+    {
+        std::scoped_lock lock{jobMutex};
+        jobQueue.emplace_back(jobID, request);
+    }
+    jobCondition.notify_one();
+
+    return jobID;
+}
+
+bool TextRasterizer::isJobComplete(JobID jobID)
+{
+    std::scoped_lock lock{jobMutex};
+    return results.contains(jobID);
+}
+
+bool TextRasterizer::takeResult(JobID jobID, SDL_Surface*& outSurface)
+{
+    std::scoped_lock lock{jobMutex};
+    auto it{results.find(jobID)};
+    if (it == results.end()) {
+        return false;
+    }
+
+    outSurface = it->second;
+    results.erase(it);
+    return true;
+}
+
+void TextRasterizer::cancelJob(JobID jobID)
+{
+    std::scoped_lock lock{jobMutex};
+
+    // If the job is finished, free its result.
+    auto resultIt{results.find(jobID)};
+    if (resultIt != results.end()) {
+        SDL_DestroySurface(resultIt->second);
+        results.erase(resultIt);
+        return;
+    }
+
+    // If the job hasn't been started, remove it from the queue.
+    auto jobIt{std::find_if(jobQueue.begin(), jobQueue.end(),
+                            [jobID](const auto& job) {
+                                return (job.first == jobID);
+                            })};
+    if (jobIt != jobQueue.end()) {
+        jobQueue.erase(jobIt);
+        return;
+    }
+
+    // The job is in progress, throw its result away when it finishes.
+    cancelledJobIDs.insert(jobID);
+}
+
+SDL_Surface* TextRasterizer::addOutline(SDL_Surface* textSurface,
+                                        int outlineSize)
+{
+    // Convert the text to a known format, so we can read its alpha.
+    SDL_Surface* convertedSurface{
+        SDL_ConvertSurface(textSurface, SDL_PIXELFORMAT_ARGB8888)};
+    SDL_DestroySurface(textSurface);
+    if (convertedSurface == nullptr) {
+        return nullptr;
+    }
+    textSurface = convertedSurface;
+
+    // Create the outlined surface, with room for the outline on each side.
+    int textWidth{textSurface->w};
+    int textHeight{textSurface->h};
+    int width{textWidth + (outlineSize * 2)};
+    int height{textHeight + (outlineSize * 2)};
+    SDL_Surface* outlinedSurface{
+        SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888)};
+    if (outlinedSurface == nullptr) {
+        SDL_DestroySurface(textSurface);
+        return nullptr;
+    }
+
+    // Copy the text's alpha into a plane the size of the outlined surface,
+    // centered.
+    // Note: ARGB8888 is a packed format, so alpha is the top byte of each
+    //       pixel regardless of endianness.
+    std::size_t planeSize{static_cast<std::size_t>(width * height)};
+    std::vector<Uint8> textAlpha(planeSize, 0);
+    for (int y = 0; y < textHeight; ++y) {
+        const Uint32* textRow{reinterpret_cast<const Uint32*>(
+            static_cast<const Uint8*>(textSurface->pixels)
+            + (y * textSurface->pitch))};
+        Uint8* alphaRow{&(textAlpha[((y + outlineSize) * width)
+                                    + outlineSize])};
+        for (int x = 0; x < textWidth; ++x) {
+            alphaRow[x] = static_cast<Uint8>(textRow[x] >> 24);
+        }
+    }
+
+    // Build horizontally dilated copies of the alpha plane, one per radius
+    // from 0 to outlineSize. Each radius is built from the previous one.
+    // Note: These loops (and the vertical pass below) are kept to simple
+    //       byte-wise max operations over contiguous rows, so that the
+    //       compiler can vectorize them.
+    std::vector<std::vector<Uint8>> rowMaxes(outlineSize + 1);
+    rowMaxes[0] = std::move(textAlpha);
+    for (int radius = 1; radius <= outlineSize; ++radius) {
+        const std::vector<Uint8>& previous{rowMaxes[radius - 1]};
+        std::vector<Uint8>& current{rowMaxes[radius]};
+        current = previous;
+        for (int y = 0; y < height; ++y) {
+            const Uint8* previousRow{&(previous[y * width])};
+            Uint8* currentRow{&(current[y * width])};
+            for (int x = 1; x < width; ++x) {
+                currentRow[x] = std::max(currentRow[x], previousRow[x - 1]);
+            }
+            for (int x = 0; x < (width - 1); ++x) {
+                currentRow[x] = std::max(currentRow[x], previousRow[x + 1]);
+            }
+        }
+    }
+
+    // Dilate vertically, using the horizontal radius that keeps each row
+    // within a circle. This gives us the outline's alpha.
+    std::vector<Uint8> outlineAlpha(planeSize, 0);
+    float circleRadius{outlineSize + 0.5f};
+    for (int yOffset = -outlineSize; yOffset <= outlineSize; ++yOffset) {
+        float rowHalfWidth{
+            std::sqrt((circleRadius * circleRadius)
+                      - static_cast<float>(yOffset * yOffset))};
+        int radius{std::min(outlineSize, static_cast<int>(rowHalfWidth))};
+        const std::vector<Uint8>& rowMax{rowMaxes[radius]};
+
+        int startY{std::max(0, -yOffset)};
+        int endY{std::min(height, (height - yOffset))};
+        for (int y = startY; y < endY; ++y) {
+            const Uint8* sourceRow{&(rowMax[(y + yOffset) * width])};
+            Uint8* outlineRow{&(outlineAlpha[y * width])};
+            for (int x = 0; x < width; ++x) {
+                outlineRow[x] = std::max(outlineRow[x], sourceRow[x]);
+            }
+        }
+    }
+
+    // Composite the text over the black outline.
+    for (int y = 0; y < height; ++y) {
+        Uint32* outlinedRow{reinterpret_cast<Uint32*>(
+            static_cast<Uint8*>(outlinedSurface->pixels)
+            + (y * outlinedSurface->pitch))};
+        const Uint8* outlineRow{&(outlineAlpha[y * width])};
+        int textY{y - outlineSize};
+        const Uint32* textRow{nullptr};
+        if ((textY >= 0) && (textY < textHeight)) {
+            textRow = reinterpret_cast<const Uint32*>(
+                static_cast<const Uint8*>(textSurface->pixels)
+                + (textY * textSurface->pitch));
+        }
+
+        for (int x = 0; x < width; ++x) {
+            int textX{x - outlineSize};
+            Uint32 textPixel{0};
+            if ((textRow != nullptr) && (textX >= 0) && (textX < textWidth)) {
+                textPixel = textRow[textX];
+            }
+
+            // Text over black: the color is the text's color scaled by its
+            // coverage of the result, and the alpha is the usual "over".
+            Uint32 textAlphaValue{textPixel >> 24};
+            Uint32 outlineAlphaValue{outlineRow[x]};
+            Uint32 alpha{
+                textAlphaValue
+                + ((outlineAlphaValue * (255 - textAlphaValue)) / 255)};
+            Uint32 pixel{alpha << 24};
+            if (alpha != 0) {
+                for (int shift : {16, 8, 0}) {
+                    Uint32 channel{(textPixel >> shift) & 0xFF};
+                    pixel |= (((channel * textAlphaValue) / alpha) << shift);
+                }
+            }
+            outlinedRow[x] = pixel;
+        }
+    }
+
+    SDL_DestroySurface(textSurface);
+    return outlinedSurface;
+}
+
+void TextRasterizer::closeFont(const std::string& fontPath, float fontSize)
+{
+    // If our workers haven't started, they don't have any fonts open.
+    {
+        std::scoped_lock lock{jobMutex};
+        if (fontsToClose.empty()) {
+            return;
+        }
+
+        std::string fontID{getWorkerFontID(fontPath, fontSize)};
+        for (std::vector<std::string>& workerFontsToClose : fontsToClose) {
+            workerFontsToClose.push_back(fontID);
+        }
+    }
+    jobCondition.notify_all();
+}
+
+void TextRasterizer::startWorkers()
+{
+    if (!(workers.empty())) {
+        return;
+    }
+
+    // Leave a core for the main thread.
+    unsigned int workerCount{std::thread::hardware_concurrency()};
+    workerCount = std::clamp(workerCount, 2u, MAX_WORKER_COUNT + 1) - 1;
+    {
+        std::scoped_lock lock{jobMutex};
+        fontsToClose.resize(workerCount);
+    }
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&TextRasterizer::workerLoop, this, i);
+    }
+}
+
+void TextRasterizer::workerLoop(std::size_t workerIndex)
+{
+    // This thread's copies of the fonts it has used, as (ID, font). Ordered
+    // from least to most recently used.
+    std::vector<std::pair<std::string, TTF_Font*>> fonts{};
+
+    // Returns this thread's copy of the given font, opening it if necessary.
+    auto getFont{[this, &fonts](const std::string& fontPath,
+                                float fontSize) -> TTF_Font* {
+        std::string fontID{getWorkerFontID(fontPath, fontSize)};
+
+        // If we already have the font open, mark it as most recently used.
+        auto it{std::find_if(fonts.begin(), fonts.end(),
+                             [&fontID](const auto& fontPair) {
+                                 return (fontPair.first == fontID);
+                             })};
+        if (it != fonts.end()) {
+            std::rotate(it, (it + 1), fonts.end());
+            return fonts.back().second;
+        }
+
+        // Open the font, closing our least recently used font if we're full.
+        // Note: If the font fails to open, we don't remember the failure, in
+        //       case the file becomes available later.
+        std::scoped_lock lock{fontMutex};
+        TTF_Font* font{TTF_OpenFont(fontPath.c_str(), fontSize)};
+        if (font == nullptr) {
+            return nullptr;
+        }
+        if (fonts.size() >= MAX_WORKER_FONT_COUNT) {
+            TTF_CloseFont(fonts.front().second);
+            fonts.erase(fonts.begin());
+        }
+        fonts.emplace_back(std::move(fontID), font);
+        return font;
+    }};
+
+    // Closes this thread's copies of the given fonts, if it has them open.
+    auto closeFonts{[this, &fonts](const std::vector<std::string>& fontIDs) {
+        std::scoped_lock lock{fontMutex};
+        std::erase_if(fonts, [&fontIDs](const auto& fontPair) {
+            if (std::find(fontIDs.begin(), fontIDs.end(), fontPair.first)
+                == fontIDs.end()) {
+                return false;
+            }
+
+            TTF_CloseFont(fontPair.second);
+            return true;
+        });
+    }};
+
+    while (true) {
+        // Wait for a job, or for fonts to close.
+        std::pair<JobID, Request> job{};
+        std::vector<std::string> fontIDsToClose{};
+        {
+            std::unique_lock lock{jobMutex};
+            jobCondition.wait(lock, [this, workerIndex] {
+                return workersShouldExit || !(jobQueue.empty())
+                       || !(fontsToClose[workerIndex].empty());
+            });
+            if (workersShouldExit) {
+                break;
+            }
+
+            fontIDsToClose = std::move(fontsToClose[workerIndex]);
+            fontsToClose[workerIndex].clear();
+            if (!(jobQueue.empty())) {
+                job = std::move(jobQueue.front());
+                jobQueue.pop_front();
+            }
+        }
+
+        // Close any fonts that AssetCache has evicted.
+        if (!(fontIDsToClose.empty())) {
+            closeFonts(fontIDsToClose);
+        }
+
+        // If we were only woken up to close fonts, go back to waiting.
+        if (job.first == 0) {
+            continue;
+        }
+
+        // Rasterize the text.
+        const Request& request{job.second};
+        SDL_Surface* surface{nullptr};
+        if (TTF_Font* font{getFont(request.fontPath, request.fontSize)}) {
+            surface = rasterize(request, font);
+        }
+
+        // Pass the result back to the main thread, unless it was cancelled.
+        std::scoped_lock lock{jobMutex};
+        if (cancelledJobIDs.erase(job.first) > 0) {
+            SDL_DestroySurface(surface);
+        }
+        else {
+            results[job.first] = surface;
+        }
+    }
+
+    // Close this thread's fonts.
+    std::scoped_lock lock{fontMutex};
+    for (auto& [fontID, font] : fonts) {
+        TTF_CloseFont(font);
+    }
+}
+
+} // namespace AUI
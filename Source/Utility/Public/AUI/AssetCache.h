@@ -3,10 +3,20 @@
 #include <SDL3/SDL_render.h>
 #include <SDL3_image/SDL_image.h>
 #include <SDL3_ttf/SDL_ttf.h>
+#include "AUI/GlyphAtlas.h"
+#include "AUI/TextRasterizer.h"
 
 #include <memory>
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <list>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace AUI
 {
@@ -14,14 +24,58 @@ namespace AUI
 /**
  * This class facilitates loading and managing the lifetime of assets.
  *
- * TODO: We need to find an appropriate time to prune the cache.
- *       If we made our own managed pointer, we could do it when references are
- *       dropped, or we could track how long an asset has gone without having
- *       any references and periodically remove old ones.
+ * Pruning:
+ *   Each asset's approximate memory usage is tracked (w * h * bytes per
+ *   pixel for textures, file size for fonts). Calling prune() will evict
+ *   assets that are no longer referenced outside of the cache, least
+ *   recently used first, until the cache fits within its memory budget.
+ *   If setAutoPruneEnabled(true) is used, prune() will be called whenever
+ *   an asset is added and the cache is over its budget.
+ *
+ *   Textures that were added through addTexture() are never evicted, since
+ *   we have no way to reload them.
+ *
+ * Generated textures:
+ *   Textures that are generated from other assets (e.g. nine slice textures)
+ *   can be shared through requestGeneratedTexture(). The caller builds an ID
+ *   from everything that affects the generated pixels, so that e.g. 500
+ *   identical buttons share 1 texture and only the first one pays for the
+ *   generation. Since they can be re-generated, these textures are evicted
+ *   like any other once nothing references them.
+ *   Generated textures are also kept within their own budget (see
+ *   setGeneratedTextureBudget()), which is always enforced. This keeps
+ *   content that churns (e.g. a Text whose string changes every frame) from
+ *   growing the cache without bound when no memory budget is set.
+ *
+ * Async loading:
+ *   requestTextureAsync() decodes image files to surfaces on a pool of worker
+ *   threads. The decoded surfaces are uploaded to textures on the main thread
+ *   by processAsyncLoads(), which Screen::render() calls each frame. Uploads
+ *   are limited by a per-frame time budget, so that a burst of new images
+ *   gets spread across multiple frames instead of stalling one.
+ *   The worker threads are only started once the first async request is made.
  */
 class AssetCache
 {
 public:
+    /**
+     * Cache statistics, for tuning the memory budget.
+     */
+    struct Stats {
+        /** The number of requests that were found in the cache. */
+        std::size_t hitCount{0};
+        /** The number of requests that had to load an asset. */
+        std::size_t missCount{0};
+        /** The number of assets that have been evicted by prune(). */
+        std::size_t evictionCount{0};
+        /** The approximate number of bytes used by the cached assets. */
+        std::size_t residentBytes{0};
+    };
+
+    AssetCache();
+
+    ~AssetCache();
+
     // Note: We use const std::string& instead of std::string_view because we
     //       need to pass C strings into the SDL APIs.
     /**
@@ -37,11 +91,100 @@ public:
     std::shared_ptr<SDL_Texture> requestTexture(const std::string& textureID,
                                                 SDL_ScaleMode scaleMode);
 
+    /**
+     * If a texture with the given ID is in the cache, returns it.
+     * If not, queues the image file at the given path to be decoded on a
+     * worker thread and returns nullptr. Once processAsyncLoads() uploads the
+     * texture, further calls will return it.
+     *
+     * Calling this again while a load is pending won't queue another load.
+     *
+     * @param textureID A user-defined ID (for textures added using
+     *                  addTexture()), or the full path to an image file.
+     * @param scaleMode The filtering/scaling mode that this texture should use.
+     * @return A valid texture if one was found, else nullptr.
+     */
+    std::shared_ptr<SDL_Texture>
+        requestTextureAsync(const std::string& textureID,
+                            SDL_ScaleMode scaleMode);
+
+    /**
+     * If a texture with the given ID is in the cache, returns it.
+     * If not, calls generateTexture(), adds the resulting texture to the
+     * cache, and returns it.
+     *
+     * Note: Ownership of the generated texture will be taken. Do not free it.
+     *
+     * @param textureID An ID that uniquely describes the generated texture's
+     *                  contents. Must not collide with other texture IDs.
+     * @param generateTexture Generates the texture. May return nullptr, in
+     *                        which case nothing is cached.
+     * @return A valid texture if one was found or generated, else nullptr.
+     */
+    std::shared_ptr<SDL_Texture> requestGeneratedTexture(
+        const std::string& textureID,
+        const std::function<SDL_Texture*()>& generateTexture);
+
+    /**
+     * Returns true if the texture with the given ID has been requested
+     * through requestTextureAsync() and hasn't been uploaded yet.
+     *
+     * Note: If a load fails, this will return false and the texture won't
+     *       be in the cache. See didTextureLoadFail().
+     */
+    bool isTextureLoadPending(const std::string& textureID) const;
+
+    /**
+     * Returns true if the most recent requestTextureAsync() load of the
+     * texture with the given ID failed (the failure will have been logged).
+     *
+     * Requesting the texture again clears the failure.
+     */
+    bool didTextureLoadFail(const std::string& textureID) const;
+
+    /**
+     * Uploads decoded async textures into the cache, until we run out of
+     * decoded surfaces or the upload time budget is used up.
+     * At least 1 texture will be uploaded per call, if any are ready.
+     *
+     * Called by Screen::render(). If you render multiple screens per frame,
+     * later calls will just find less work to do.
+     */
+    void processAsyncLoads();
+
+    /**
+     * Sets the amount of time that processAsyncLoads() may spend uploading
+     * textures, per call.
+     *
+     * @param inAsyncUploadBudgetNS The budget in nanoseconds (2ms by default).
+     */
+    void setAsyncUploadBudget(Uint64 inAsyncUploadBudgetNS);
+
+    /**
+     * Sets the texture that images should display while their async texture
+     * is loading. If never set (or set to an empty ID), nothing is displayed.
+     *
+     * Note: The placeholder texture is loaded synchronously.
+     *
+     * @param textureID A user-defined ID (for textures added using
+     *                  addTexture()), or the full path to an image file.
+     * @param scaleMode The filtering/scaling mode that this texture should use.
+     */
+    void setAsyncPlaceholder(const std::string& textureID,
+                             SDL_ScaleMode scaleMode);
+
+    /**
+     * Returns the texture set by setAsyncPlaceholder(), or nullptr if there
+     * isn't one.
+     */
+    const std::shared_ptr<SDL_Texture>& getAsyncPlaceholder() const;
+
     /**
      * Adds the given texture to the cache, using the given ID.
      * If a texture already exists with the given ID, it will be overwritten.
      *
      * Note: Ownership of the texture will be taken. Do not free it.
+     * Note: Textures added through this function will never be pruned.
      *
      * @return A valid texture.
      */
@@ -60,10 +203,234 @@ public:
     std::shared_ptr<TTF_Font> requestFont(const std::string& fontPath,
                                           float fontSize, int fontOutlineSize);
 
+    /**
+     * Returns the shared glyph atlas, used by Text widgets that use the
+     * GlyphAtlas render backend.
+     */
+    GlyphAtlas& getGlyphAtlas();
+
+    /**
+     * Returns the text rasterizer, for rendering text on worker threads.
+     */
+    TextRasterizer& getTextRasterizer();
+
+    /**
+     * Sets the approximate number of bytes that the cached assets should
+     * fit within. See class comment.
+     *
+     * @param inMemoryBudget The budget in bytes. 0 == no budget, prune() will
+     *                       evict every unreferenced asset.
+     */
+    void setMemoryBudget(std::size_t inMemoryBudget);
+
+    /**
+     * Sets the approximate number of bytes that generated textures (see
+     * requestGeneratedTexture()) should fit within.
+     *
+     * Whenever a texture is generated and this budget is exceeded,
+     * unreferenced generated textures are evicted, least recently used
+     * first. Unlike the memory budget, this doesn't depend on auto prune.
+     *
+     * @param inGeneratedTextureBudget The budget in bytes (16MiB by default).
+     *                                 0 == evict every unreferenced generated
+     *                                 texture whenever a texture is generated.
+     */
+    void setGeneratedTextureBudget(std::size_t inGeneratedTextureBudget);
+
+    /**
+     * If true, prune() will be called whenever an asset is added and the
+     * cache is over its memory budget.
+     * Does nothing if there's no memory budget.
+     */
+    void setAutoPruneEnabled(bool inAutoPruneEnabled);
+
+    /**
+     * Evicts unreferenced assets, least recently used first, until the cache
+     * fits within its memory budget. If there's no memory budget, evicts
+     * every unreferenced asset.
+     *
+     * @return The number of assets that were evicted.
+     */
+    std::size_t prune();
+
+    /**
+     * Returns the current cache statistics.
+     */
+    const Stats& getStats() const;
+
 private:
-    std::unordered_map<std::string, std::shared_ptr<SDL_Texture>> textureCache;
+    /** Used to tell what type of asset an LRU list entry refers to. */
+    enum class AssetType { Texture, Font };
+
+    /** An entry in the LRU list. */
+    struct LruEntry {
+        AssetType type{};
+        std::string id{};
+    };
+    using LruList = std::list<LruEntry>;
+
+    struct TextureEntry;
+    /** Generated textures, ordered from least to most recently used. */
+    using GeneratedLruList = std::list<TextureEntry*>;
+
+    struct TextureEntry {
+        std::shared_ptr<SDL_Texture> texture{};
+        /** The approximate number of bytes used by the texture. */
+        std::size_t byteSize{0};
+        /** If true, this texture can't be evicted. */
+        bool isPinned{false};
+        /** If true, this texture was added by requestGeneratedTexture(). */
+        bool isGenerated{false};
+        /** This texture's position in lruList. */
+        LruList::iterator lruIt{};
+        /** If generated, this texture's position in generatedLruList. */
+        GeneratedLruList::iterator generatedLruIt{};
+    };
+
+    /** A texture that has been decoded by a worker thread, waiting to be
+        uploaded. */
+    struct DecodedSurface {
+        std::string textureID{};
+        SDL_ScaleMode scaleMode{};
+        /** The decoded image. nullptr if decoding failed. */
+        SDL_Surface* surface{nullptr};
+    };
+
+    struct FontEntry {
+        std::shared_ptr<TTF_Font> font{};
+        /** The path and size that the font was opened with. */
+        std::string fontPath{};
+        float fontSize{0};
+        /** The approximate number of bytes used by the font. */
+        std::size_t byteSize{0};
+        /** This font's position in lruList. */
+        LruList::iterator lruIt{};
+    };
+
+    /**
+     * Adds the given texture to textureCache, replacing any existing entry.
+     */
+    void addTextureEntry(const std::string& textureID,
+                         std::shared_ptr<SDL_Texture> texture, bool isPinned,
+                         bool isGenerated);
+
+    /**
+     * Marks the given LRU entry as the most recently used.
+     */
+    void touch(LruList::iterator lruIt);
+
+    /**
+     * Marks the given texture as the most recently used.
+     */
+    void touch(TextureEntry& entry);
+
+    /**
+     * If auto prune is enabled and we're over budget, prunes.
+     */
+    void autoPrune();
+
+    /**
+     * If generated textures are over their budget, evicts unreferenced
+     * generated textures until they're within it.
+     *
+     * Referenced textures are moved to the back of generatedLruList as
+     * they're found. To keep this cheap when most generated textures are in
+     * use, we stop after skipping a few of them. The next call will pick
+     * up where we left off.
+     */
+    void pruneGeneratedTextures();
+
+    /**
+     * If the given LRU entry's asset isn't referenced outside of the cache
+     * and isn't pinned, evicts it.
+     *
+     * @return true if the asset was evicted, else false.
+     */
+    bool tryEvict(LruList::iterator lruIt);
+
+    /**
+     * Starts our worker threads, if they haven't been started yet.
+     */
+    void startAsyncWorkers();
+
+    /**
+     * The worker thread loop. Decodes requested images until
+     * asyncWorkersShouldExit is set.
+     */
+    void asyncWorkerLoop();
+
+    /**
+     * Returns the approximate number of bytes used by the given texture.
+     */
+    static std::size_t calcTextureByteSize(SDL_Texture* texture);
+
+    std::unordered_map<std::string, TextureEntry> textureCache;
+
+    std::unordered_map<std::string, FontEntry> fontCache;
+
+    /** Every cached asset, ordered from least to most recently used. */
+    LruList lruList;
+
+    /** The generated textures in textureCache. Kept separately from lruList
+        so that pruning them doesn't need to walk every asset. */
+    GeneratedLruList generatedLruList;
+
+    /** The approximate number of bytes that the cached assets should fit
+        within. 0 == no budget. */
+    std::size_t memoryBudget;
+
+    /** If true, we'll automatically prune when over budget. */
+    bool autoPruneEnabled;
+
+    /** The approximate number of bytes used by generated textures. */
+    std::size_t generatedTextureBytes;
+
+    /** The approximate number of bytes that generated textures should fit
+        within. */
+    std::size_t generatedTextureBudget;
+
+    Stats stats;
+
+    GlyphAtlas glyphAtlas;
+
+    /** Locked while opening or closing fonts, since TextRasterizer's worker
+        threads open their own fonts and that isn't thread-safe. */
+    std::mutex fontMutex;
+
+    TextRasterizer textRasterizer;
+
+    /** The IDs of textures that have been requested through
+        requestTextureAsync() but haven't been uploaded yet.
+        Only touched by the main thread. */
+    std::unordered_set<std::string> pendingTextureIDs;
+
+    /** The IDs of textures whose most recent async load failed.
+        Only touched by the main thread. */
+    std::unordered_set<std::string> failedTextureIDs;
+
+    /** The amount of time that processAsyncLoads() may spend uploading
+        textures, in nanoseconds. */
+    Uint64 asyncUploadBudgetNS;
+
+    /** The texture to display while async textures are loading. */
+    std::shared_ptr<SDL_Texture> asyncPlaceholder;
+
+    /** Guards the async queues and asyncWorkersShouldExit. */
+    std::mutex asyncMutex;
+
+    /** Signaled when a decode is queued or the workers should exit. */
+    std::condition_variable asyncCondition;
+
+    /** Images waiting to be decoded, as (path, scale mode). */
+    std::deque<std::pair<std::string, SDL_ScaleMode>> decodeQueue;
+
+    /** Decoded images waiting to be uploaded. */
+    std::deque<DecodedSurface> uploadQueue;
+
+    /** If true, the worker threads should exit. */
+    bool asyncWorkersShouldExit;
 
-    std::unordered_map<std::string, std::shared_ptr<TTF_Font>> fontCache;
+    std::vector<std::thread> asyncWorkers;
 };
 
 } // End namespace AUI
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <SDL3/SDL_render.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+namespace AUI
+{
+/**
+ * Caches rendered glyphs in shared atlas textures ("pages").
+ *
+ * Glyphs are rendered in white, so that they can be tinted to any color
+ * through vertex colors when drawn with SDL_RenderGeometry().
+ *
+ * Glyphs are keyed on the font object they were rendered with. Since
+ * AssetCache gives each (font, size, outline) combination its own font
+ * object, each combination gets its own set of glyphs.
+ *
+ * Each page is PAGE_SIZE x PAGE_SIZE, and a new page is added whenever the
+ * existing pages are full. Pages track which fonts have glyphs in them. Once
+ * every font in a page has been removed, the page is freed.
+ *
+ * Note: The space used by a removed font's glyphs isn't reclaimed until the
+ *       rest of the fonts in its page are removed too.
+ */
+class GlyphAtlas
+{
+public:
+    /**
+     * A single glyph within the atlas.
+     */
+    struct Glyph {
+        /** The page texture that this glyph is in. */
+        SDL_Texture* page{nullptr};
+
+        /** The extent of this glyph's image within its page texture. */
+        SDL_FRect texExtent{};
+
+        /** How far the left edge of the glyph's image is from the pen
+            position. May be negative. */
+        int xOffset{0};
+
+        /** How far to move the pen after drawing this glyph. */
+        int advance{0};
+    };
+
+    /** The width and height of each page texture. */
+    static constexpr int PAGE_SIZE{1024};
+
+    GlyphAtlas();
+
+    ~GlyphAtlas();
+
+    /**
+     * Returns the glyph for the given codepoint in the given font.
+     * If the glyph isn't in the atlas yet, renders it and adds it.
+     *
+     * Note: The returned reference is valid until the font is removed.
+     */
+    const Glyph& getGlyph(TTF_Font* font, Uint32 codepoint);
+
+    /**
+     * Removes all of the given font's glyphs from the atlas.
+     *
+     * Call this before closing a font, since a new font may be allocated at
+     * the same address.
+     *
+     * Any pages that no longer hold glyphs from other fonts will be freed.
+     */
+    void removeFont(TTF_Font* font);
+
+    /**
+     * Returns the number of page textures that have been allocated.
+     */
+    std::size_t getPageCount() const;
+
+    /**
+     * Returns the number of glyphs that have been rendered into the atlas.
+     */
+    std::size_t getGlyphCount() const;
+
+private:
+    /** A deleter to use with our page textures. */
+    struct TextureDeleter {
+        void operator()(SDL_Texture* p) { SDL_DestroyTexture(p); }
+    };
+
+    /**
+     * A horizontal strip within a page that glyphs are packed into, left to
+     * right.
+     */
+    struct Shelf {
+        /** The Y position of the top of this shelf. */
+        int y{0};
+        /** The height of this shelf. */
+        int height{0};
+        /** The X position where the next glyph should be placed. */
+        int nextX{0};
+    };
+
+    /**
+     * A single atlas texture.
+     */
+    struct Page {
+        std::unique_ptr<SDL_Texture, TextureDeleter> texture{};
+        std::vector<Shelf> shelves{};
+        /** The fonts that have glyphs in this page. */
+        std::vector<TTF_Font*> fonts{};
+    };
+
+    /**
+     * Used to key the glyph map.
+     */
+    struct GlyphKey {
+        TTF_Font* font{nullptr};
+        Uint32 codepoint{0};
+
+        bool operator==(const GlyphKey& other) const = default;
+    };
+
+    struct GlyphKeyHash {
+        std::size_t operator()(const GlyphKey& key) const
+        {
+            return std::hash<const void*>{}(key.font)
+                   ^ (std::hash<Uint32>{}(key.codepoint) << 1);
+        }
+    };
+
+    /**
+     * Renders the given glyph and copies it into a page.
+     */
+    Glyph addGlyph(TTF_Font* font, Uint32 codepoint);
+
+    /**
+     * Finds a spot for an image of the given size within our pages. Adds a
+     * new page if necessary.
+     *
+     * @param font The font that the image is from. Will be added to the
+     *             page's fonts.
+     * @return The page that the spot is in.
+     */
+    Page& allocateSpot(TTF_Font* font, int width, int height,
+                       SDL_Rect& outSpot);
+
+    /**
+     * Tries to find a spot for an image of the given size within the given
+     * page.
+     *
+     * @return true if a spot was found, else false.
+     */
+    bool allocateSpotInPage(Page& page, int width, int height,
+                            SDL_Rect& outSpot);
+
+    /**
+     * Adds a new, empty page.
+     */
+    Page& addPage();
+
+    /** The atlas pages. */
+    std::vector<Page> pages;
+
+    /** The glyphs that have been added to the atlas. */
+    std::unordered_map<GlyphKey, Glyph, GlyphKeyHash> glyphMap;
+};
+
+} // namespace AUI
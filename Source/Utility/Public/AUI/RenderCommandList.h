@@ -0,0 +1,213 @@
+#pragma once
+
+#include <SDL3/SDL_render.h>
+#include <span>
+#include <vector>
+
+namespace AUI
+{
+/**
+ * Collects the draw calls made by widgets during Screen::render(), so they
+ * can be submitted as a small number of batched SDL_RenderGeometry() calls.
+ *
+ * Batching:
+ *   Each command is added to the most recent batch that uses the same texture
+ *   and clip rect, as long as no batch after it overlaps the command's
+ *   bounds. This keeps painter's order intact wherever widgets overlap, while
+ *   letting e.g. a grid of icons that share a texture collapse into 1 call.
+ *   Only the last MAX_BATCH_SEARCH_DEPTH batches are searched.
+ *
+ *   Batching is disabled by default. While disabled, each command is drawn
+ *   immediately, the same way widgets used to draw themselves.
+ *
+ *   If you enable batching and draw directly through SDL during
+ *   Screen::render() (e.g. in a custom widget), call flush() before drawing
+ *   so that your draw lands in the right order.
+ *
+ * Culling:
+ *   While a cull extent is set (e.g. by Screen's dirty rect rendering),
+ *   widgets that don't intersect it skip rendering. While occluders are set
+ *   (e.g. by Screen's occlusion culling), widgets that are fully covered by
+ *   one of them skip rendering. See Widget::isRenderCulled().
+ */
+class RenderCommandList
+{
+public:
+    /**
+     * Draw call statistics, for checking how well batching is working.
+     */
+    struct Stats {
+        /** The number of commands that have been added (the number of draw
+            calls we would make without batching). */
+        std::size_t commandCount{0};
+        /** The number of draw calls that have actually been made. */
+        std::size_t drawCallCount{0};
+        /** The number of widgets that skipped rendering because they were
+            fully covered by an occluder.
+            Note: Widgets that are skipped along with their parent aren't
+                  counted. */
+        std::size_t occludedCount{0};
+    };
+
+    /** How many batches to search backwards through when looking for a batch
+        to add a command to. */
+    static constexpr std::size_t MAX_BATCH_SEARCH_DEPTH{16};
+
+    RenderCommandList();
+
+    /**
+     * If true, commands will be batched until flush() is called. If false,
+     * commands will be drawn immediately.
+     *
+     * Note: Disabling batching will flush any batched commands.
+     */
+    void setBatchingEnabled(bool inBatchingEnabled);
+
+    bool getBatchingEnabled() const;
+
+    /**
+     * Draws the given portion of the given texture.
+     *
+     * @param srcRect The extent within the texture to draw.
+     * @param dstRect The extent on the render target to draw to.
+     * @param alphaMod The alpha to draw with, from 0.0 - 1.0.
+     */
+    void addTexturedQuad(SDL_Texture* texture, const SDL_FRect& srcRect,
+                         const SDL_FRect& dstRect, float alphaMod = 1.f);
+
+    /**
+     * Draws a rectangle filled with the given color.
+     */
+    void addFilledRect(const SDL_FRect& rect, const SDL_Color& color);
+
+    /**
+     * Draws the given triangles.
+     *
+     * @param texture The texture to draw with. May be nullptr.
+     * @param offset An offset to apply to each vertex's position.
+     * @param clipRect If non-nullptr, the geometry will be clipped to this
+     *                 rect (intersected with the renderer's clip rect).
+     */
+    void addGeometry(SDL_Texture* texture, std::span<const SDL_Vertex> vertices,
+                     std::span<const int> indices, const SDL_FPoint& offset,
+                     const SDL_Rect* clipRect);
+
+    /**
+     * Draws all batched commands, in order.
+     */
+    void flush();
+
+    /**
+     * Sets the actual-space extent that widgets must intersect in order to
+     * be rendered.
+     *
+     * @param inCullExtent If nullptr, culling is disabled.
+     */
+    void setCullExtent(const SDL_FRect* inCullExtent);
+
+    /**
+     * Returns the current cull extent, or nullptr if culling is disabled.
+     */
+    const SDL_FRect* getCullExtent() const;
+
+    /**
+     * Sets the actual-space extents that will be covered by something opaque
+     * after the current draws. Widgets that are fully within one of them
+     * won't be rendered.
+     *
+     * Note: The given extents must outlive their use. Pass an empty span to
+     *       clear them.
+     */
+    void setOccluders(std::span<const SDL_FRect> inOccluders);
+
+    /**
+     * If true, isCulled() will return false for everything. Used when
+     * rendering somewhere other than the screen (e.g. into a window's render
+     * cache), where the cull extent and occluders don't apply.
+     */
+    void setCullingSuspended(bool inCullingSuspended);
+
+    /**
+     * Returns true if something at the given actual-space extent doesn't
+     * need to be rendered, because it doesn't intersect the cull extent or
+     * is fully covered by an occluder.
+     */
+    bool isCulled(const SDL_FRect& screenExtent);
+
+    /**
+     * Returns the stats that have accumulated since the last resetStats().
+     */
+    const Stats& getStats() const;
+
+    /**
+     * Resets the stats. Call this at the start of each frame to get per-frame
+     * counts.
+     */
+    void resetStats();
+
+private:
+    /**
+     * A set of triangles that share a texture and clip rect.
+     */
+    struct Batch {
+        SDL_Texture* texture{nullptr};
+
+        /** If true, clipRect should be applied when drawing this batch. */
+        bool hasClipRect{false};
+        SDL_Rect clipRect{};
+
+        /** The union of the bounds of every command in this batch. */
+        SDL_FRect bounds{};
+
+        std::vector<SDL_Vertex> vertices{};
+        std::vector<int> indices{};
+    };
+
+    /**
+     * Returns the batch that a command with the given texture, clip rect, and
+     * bounds should be added to. Adds a new batch if necessary.
+     */
+    Batch& findBatch(SDL_Texture* texture, const SDL_Rect* clipRect,
+                     const SDL_FRect& bounds);
+
+    /**
+     * Adds a quad covering dstRect to the given batch.
+     */
+    void addQuad(Batch& batch, const SDL_FRect& dstRect,
+                 const SDL_FRect& texCoords, const SDL_FColor& color);
+
+    /**
+     * Draws the given geometry immediately, clipped to the given clip rect.
+     */
+    void drawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices,
+                      int vertexCount, const int* indices, int indexCount,
+                      const SDL_Rect* clipRect);
+
+    /** The batches. Only the first batchCount are in use, the rest are kept
+        around to avoid re-allocating their vectors every frame. */
+    std::vector<Batch> batches;
+
+    /** The number of batches in use. */
+    std::size_t batchCount;
+
+    /** Used when drawing geometry immediately, to offset the vertices. Kept
+        as a member to avoid re-allocating it every frame. */
+    std::vector<SDL_Vertex> offsetVertices;
+
+    /** If true, commands are batched. If false, they're drawn immediately. */
+    bool batchingEnabled;
+
+    /** If true, cullExtent should be applied. See setCullExtent(). */
+    bool hasCullExtent;
+    SDL_FRect cullExtent;
+
+    /** See setOccluders(). */
+    std::span<const SDL_FRect> occluders;
+
+    /** See setCullingSuspended(). */
+    bool cullingIsSuspended;
+
+    Stats stats;
+};
+
+} // namespace AUI
@@ -16,6 +16,11 @@ public:
     static float squaredDistance(const SDL_FPoint& pointA,
                                  const SDL_FPoint& pointB);
 
+    /**
+     * Returns true if innerRect is fully within outerRect.
+     */
+    static bool rectContainsRect(const SDL_FRect& outerRect,
+                                 const SDL_FRect& innerRect);
 };
 
 } // namespace AUI
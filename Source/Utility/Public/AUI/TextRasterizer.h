@@ -0,0 +1,195 @@
+#pragma once
+
+#include <SDL3/SDL_surface.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace AUI
+{
+
+/**
+ * Rasterizes text into surfaces, either immediately or on a pool of worker
+ * threads.
+ *
+ * Async rasterization:
+ *   requestRasterization() queues a job and returns its ID. A worker thread
+ *   renders the text into a surface, and the requester picks it up on the
+ *   main thread through takeResult() (uploading it to a texture is left to
+ *   the requester, since that has to happen on the main thread).
+ *   The worker threads are only started once the first job is requested.
+ *
+ *   TTF_Font objects can't be shared between threads, so each worker opens
+ *   its own copy of every font that it needs. Since opening and closing
+ *   fonts isn't thread-safe, that's guarded by the font mutex that we're
+ *   given (which AssetCache also locks when opening and closing fonts).
+ *   Each worker keeps a small number of fonts open, closing the least
+ *   recently used one when it needs another. When AssetCache evicts a
+ *   font, it calls closeFont() so the workers close their copies too.
+ *
+ * Outlines:
+ *   Outlines are built from the rendered text's alpha, by dilating it with a
+ *   circular kernel and compositing the text on top. This only renders the
+ *   text once and doesn't need a separate outlined font.
+ *   Note: Since the outline follows the text's alpha, modes that draw an
+ *         opaque box (Shaded, LCD) get an outline around the box.
+ */
+class TextRasterizer
+{
+public:
+    /**
+     * Text render mode, affects the quality of the rendered image.
+     * See SDL_ttf documentation for more.
+     */
+    enum class RenderMode {
+        /** Fastest, lowest quality. */
+        Solid,
+        /** Better quality, but has a box around it. */
+        Shaded,
+        /** Slower, high quality, no box. */
+        Blended,
+        /** Slowest, LCD subpixel quality, but has a box around it.
+            Useful for small font sizes. */
+        LCD
+    };
+
+    /**
+     * Everything needed to rasterize a piece of text.
+     */
+    struct Request {
+        /** Full path to the font file. */
+        std::string fontPath{};
+        /** The actual font size, in point. */
+        float fontSize{0};
+        /** The actual font outline size. 0 == no outline. */
+        int fontOutlineSize{0};
+        /** The text to render. If empty, a space is rendered instead. */
+        std::string text{};
+        RenderMode renderMode{RenderMode::Blended};
+        SDL_Color color{0, 0, 0, 255};
+        /** Only used when renderMode == Shaded or LCD. */
+        SDL_Color backgroundColor{0, 0, 0, 0};
+        /** The width to wrap the text at, in pixels. -1 == no wrapping. */
+        int wrapWidth{-1};
+    };
+
+    /** Identifies a requested rasterization job. 0 is never a valid ID. */
+    using JobID = Uint64;
+
+    /**
+     * @param inFontMutex Locked while opening or closing fonts.
+     */
+    TextRasterizer(std::mutex& inFontMutex);
+
+    ~TextRasterizer();
+
+    /**
+     * Renders the given text into a new surface, immediately.
+     *
+     * @param font The font to render with. Must match the request's path and
+     *             size, and must not have an outline set.
+     * @return The new surface, or nullptr if rendering failed. The caller
+     *         owns the surface.
+     */
+    static SDL_Surface* rasterize(const Request& request, TTF_Font* font);
+
+    /**
+     * Queues the given text to be rendered on a worker thread.
+     *
+     * @return The ID to use with takeResult() and cancelJob().
+     */
+    JobID requestRasterization(const Request& request);
+
+    /**
+     * Returns true if the given job has finished (successfully or not).
+     */
+    bool isJobComplete(JobID jobID);
+
+    /**
+     * If the given job has finished, hands over its surface and forgets the
+     * job.
+     *
+     * @param outSurface If the job finished, will be set to the rendered
+     *                   surface (or nullptr if rendering failed). The caller
+     *                   owns the surface.
+     * @return true if the job finished, else false.
+     */
+    bool takeResult(JobID jobID, SDL_Surface*& outSurface);
+
+    /**
+     * Cancels the given job. If it's already finished, its result is freed.
+     * If it's in progress, its result will be freed once it finishes.
+     */
+    void cancelJob(JobID jobID);
+
+    /**
+     * Tells the worker threads to close their copies of the given font, if
+     * they have it open. If a later job needs it, it'll be re-opened.
+     *
+     * Called by AssetCache when it evicts a font.
+     */
+    void closeFont(const std::string& fontPath, float fontSize);
+
+private:
+    /**
+     * Returns a new surface containing the given text surface, centered on a
+     * black outline of the given size. The new surface is outlineSize pixels
+     * larger on each side.
+     *
+     * Note: Takes ownership of the given surface.
+     */
+    static SDL_Surface* addOutline(SDL_Surface* textSurface, int outlineSize);
+
+    /**
+     * Starts our worker threads, if they haven't been started yet.
+     */
+    void startWorkers();
+
+    /**
+     * The worker thread loop. Rasterizes requested text until
+     * workersShouldExit is set.
+     *
+     * @param workerIndex This worker's index into fontsToClose.
+     */
+    void workerLoop(std::size_t workerIndex);
+
+    /** See constructor. */
+    std::mutex& fontMutex;
+
+    /** The ID to give the next requested job. */
+    JobID nextJobID;
+
+    /** Guards the job queue, results, and workersShouldExit. */
+    std::mutex jobMutex;
+
+    /** Signaled when a job is queued or the workers should exit. */
+    std::condition_variable jobCondition;
+
+    /** Jobs waiting to be rasterized. */
+    std::deque<std::pair<JobID, Request>> jobQueue;
+
+    /** Finished jobs that haven't been taken yet. */
+    std::unordered_map<JobID, SDL_Surface*> results;
+
+    /** Jobs that were cancelled while being rasterized. Their results are
+        thrown away when they finish. */
+    std::unordered_set<JobID> cancelledJobIDs;
+
+    /** For each worker, the IDs ("fontPath_fontSize") of the fonts that it
+        should close. Empty until the workers are started. */
+    std::vector<std::vector<std::string>> fontsToClose;
+
+    /** If true, the worker threads should exit. */
+    bool workersShouldExit;
+
+    std::vector<std::thread> workers;
+};
+
+} // End namespace AUI
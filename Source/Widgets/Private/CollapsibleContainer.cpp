@@ -52,13 +52,15 @@ void CollapsibleContainer::setIsCollapsed(bool inIsCollapsed)
         collapsedImage.setIsVisible(false);
     }
 
-    // TODO: Invalidate layout
+    // Our height depends on our collapsed state.
+    invalidateMeasure();
 }
 
 void CollapsibleContainer::setGapSize(float inLogicalGapSize)
 {
     logicalGapSize = inLogicalGapSize;
     scaledGapSize = ScalingHelpers::logicalToActual(logicalGapSize);
+    invalidateMeasure();
 }
 
 SDL_FRect CollapsibleContainer::getHeaderExtent()
@@ -88,8 +90,6 @@ void CollapsibleContainer::setLogicalExtent(const SDL_FRect& inLogicalExtent)
 {
     Widget::setLogicalExtent(inLogicalExtent);
     headerLogicalExtent = inLogicalExtent;
-
-    // TODO: Invalidate layout
 }
 
 EventResult CollapsibleContainer::onMouseDown(MouseButtonType,
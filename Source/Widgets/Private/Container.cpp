@@ -1,5 +1,6 @@
 #include "AUI/Container.h"
 #include "AUI/Internal/Log.h"
+#include "AUI/Internal/AUIAssert.h"
 #include "AUI/SDLHelpers.h"
 #include <algorithm>
 
@@ -8,6 +9,12 @@ namespace AUI
 Container::Container(const SDL_FRect& inLogicalExtent,
                      const std::string& inDebugName)
 : Widget(inLogicalExtent, inDebugName)
+, isRecycling{false}
+, elements{}
+, itemCount{0}
+, itemFactory{}
+, itemBinder{}
+, boundItemIndices{}
 {
 }
 
@@ -46,12 +53,26 @@ std::size_t Container::size()
 
 void Container::clear()
 {
+    std::size_t erasedCount{elements.size()};
     elements.clear();
+
+    // Leave recycling mode, if we were in it.
+    isRecycling = false;
+    itemCount = 0;
+    itemFactory = nullptr;
+    itemBinder = nullptr;
+    boundItemIndices.clear();
+
+    onElementsErased(0, erasedCount);
+    invalidateMeasure();
 }
 
 void Container::insert(const_iterator pos, std::unique_ptr<Widget> newElement)
 {
-    elements.insert(pos, std::move(newElement));
+    newElement->setParent(this);
+    auto newElementIt{elements.insert(pos, std::move(newElement))};
+    onElementsInserted((newElementIt - elements.begin()), 1);
+    invalidateMeasure();
 }
 
 void Container::erase(std::size_t index)
@@ -64,16 +85,23 @@ void Container::erase(std::size_t index)
     }
 
     elements.erase(elements.begin() + index);
+    onElementsErased(index, 1);
+    invalidateMeasure();
 }
 
 void Container::erase(const_iterator pos)
 {
-    elements.erase(pos);
+    auto nextElementIt{elements.erase(pos)};
+    onElementsErased((nextElementIt - elements.begin()), 1);
+    invalidateMeasure();
 }
 
 void Container::erase(const_iterator first, const_iterator last)
 {
-    elements.erase(first, last);
+    std::size_t erasedCount{static_cast<std::size_t>(last - first)};
+    auto nextElementIt{elements.erase(first, last)};
+    onElementsErased((nextElementIt - elements.begin()), erasedCount);
+    invalidateMeasure();
 }
 
 void Container::erase(Widget* widget)
@@ -87,7 +115,9 @@ void Container::erase(Widget* widget)
 
     // If we found it, erase it.
     if (widgetIt != elements.end()) {
-        elements.erase(widgetIt);
+        auto nextElementIt{elements.erase(widgetIt)};
+        onElementsErased((nextElementIt - elements.begin()), 1);
+        invalidateMeasure();
     }
     else {
         // We didn't find it, error.
@@ -99,7 +129,116 @@ void Container::erase(Widget* widget)
 
 void Container::push_back(std::unique_ptr<Widget> newElement)
 {
+    newElement->setParent(this);
     elements.push_back(std::move(newElement));
+    onElementsInserted((elements.size() - 1), 1);
+    invalidateMeasure();
+}
+
+void Container::setRecycledItems(std::size_t inItemCount,
+                                 ItemFactory inItemFactory,
+                                 ItemBinder inItemBinder)
+{
+    AUI_ASSERT(inItemFactory && inItemBinder,
+               "Tried to recycle items without a factory and binder.");
+
+    // Clear any existing elements (this also clears any existing pool).
+    clear();
+
+    isRecycling = true;
+    itemCount = inItemCount;
+    itemFactory = std::move(inItemFactory);
+    itemBinder = std::move(inItemBinder);
+}
+
+void Container::setItemCount(std::size_t inItemCount)
+{
+    itemCount = inItemCount;
+    refreshItems();
+}
+
+void Container::refreshItems()
+{
+    std::fill(boundItemIndices.begin(), boundItemIndices.end(),
+              UNBOUND_INDEX);
+    invalidateMeasure();
+}
+
+std::size_t Container::getItemCount() const
+{
+    return (isRecycling ? itemCount : elements.size());
+}
+
+void Container::onElementsInserted(std::size_t, std::size_t) {}
+
+void Container::onElementsErased(std::size_t, std::size_t) {}
+
+Widget& Container::getItemWidget(std::size_t itemIndex)
+{
+    if (!isRecycling) {
+        return *(elements[itemIndex]);
+    }
+
+    AUI_ASSERT(elements.size() > 0,
+               "Tried to get item widget while the pool was empty.");
+
+    // If the item isn't bound yet, bind it.
+    // Note: We're mid-layout and our caller will measure the widget in this
+    //       same pass, so we don't let the binder's invalidation reach our
+    //       ancestors (it would cause a redundant second layout pass).
+    std::size_t poolIndex{itemIndex % elements.size()};
+    if (boundItemIndices[poolIndex] != itemIndex) {
+        runWithoutInvalidatingAncestors(
+            [&]() { bindItemWidget(itemIndex); });
+    }
+
+    return *(elements[poolIndex]);
+}
+
+void Container::bindItemWidgets(std::size_t firstIndex, std::size_t lastIndex)
+{
+    if (!isRecycling || ((lastIndex - firstIndex) > elements.size())) {
+        return;
+    }
+
+    for (std::size_t i{firstIndex}; i < lastIndex; ++i) {
+        bindItemWidget(i);
+    }
+}
+
+void Container::bindItemWidget(std::size_t itemIndex)
+{
+    // Each item maps to a fixed slot in the pool. As long as the items in
+    // use are a contiguous range that fits in the pool, they'll never
+    // collide. When we scroll, only the slots whose item changed need to be
+    // re-bound.
+    // Note: The widget may now be a different size, so we always invalidate
+    //       it (even if the binder didn't) to make sure it gets measured.
+    std::size_t poolIndex{itemIndex % elements.size()};
+    if (boundItemIndices[poolIndex] != itemIndex) {
+        Widget& widget{*(elements[poolIndex])};
+        itemBinder(widget, itemIndex);
+        widget.invalidateMeasure();
+        boundItemIndices[poolIndex] = itemIndex;
+    }
+}
+
+void Container::reserveItemWidgets(std::size_t widgetCount)
+{
+    if (!isRecycling || (elements.size() >= widgetCount)) {
+        return;
+    }
+
+    // Construct the new widgets.
+    while (elements.size() < widgetCount) {
+        std::unique_ptr<Widget> newElement{itemFactory()};
+        newElement->setParent(this);
+        elements.push_back(std::move(newElement));
+    }
+
+    // The item -> pool slot mapping depends on the pool size, so everything
+    // needs to be re-bound.
+    boundItemIndices.assign(elements.size(), UNBOUND_INDEX);
 }
 
 void Container::onTick(double timestepS)
@@ -114,8 +253,8 @@ void Container::onTick(double timestepS)
 
 void Container::render(const SDL_FPoint& windowTopLeft)
 {
-    // If this widget is fully clipped, don't render it.
-    if (SDL_RectEmptyFloat(&clippedExtent)) {
+    // If this widget is fully clipped or culled, don't render it.
+    if (isRenderCulled(windowTopLeft)) {
         return;
     }
 
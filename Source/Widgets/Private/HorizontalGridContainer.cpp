@@ -3,6 +3,7 @@
 #include "AUI/WidgetLocator.h"
 #include "AUI/Internal/Log.h"
 #include <cmath>
+#include <algorithm>
 #include "AUI/Core.h"
 #include "AUI/SDLHelpers.h"
 
@@ -18,24 +19,31 @@ HorizontalGridContainer::HorizontalGridContainer(
 , scaledCellHeight{ScalingHelpers::logicalToActual(logicalCellHeight)}
 , isScrollingEnabled{true}
 , columnScroll{0}
+, firstArrangedIndex{0}
+, lastArrangedIndex{0}
+, lastUsedScreenSize{0, 0}
+, lastUsedLogicalExtent{0, 0, 0, 0}
 {
 }
 
 void HorizontalGridContainer::setNumRows(unsigned int inNumRows)
 {
     numRows = inNumRows;
+    invalidateMeasure();
 }
 
 void HorizontalGridContainer::setCellWidth(float inLogicalCellWidth)
 {
     logicalCellWidth = inLogicalCellWidth;
     scaledCellWidth = ScalingHelpers::logicalToActual(logicalCellWidth);
+    invalidateMeasure();
 }
 
 void HorizontalGridContainer::setCellHeight(float inLogicalCellHeight)
 {
     logicalCellHeight = inLogicalCellHeight;
     scaledCellHeight = ScalingHelpers::logicalToActual(logicalCellHeight);
+    invalidateMeasure();
 }
 
 void HorizontalGridContainer::setScrollingEnabled(bool isEnabled)
@@ -70,11 +78,33 @@ void HorizontalGridContainer::measure(const SDL_FRect& availableExtent)
     scaledCellWidth = ScalingHelpers::logicalToActual(logicalCellWidth);
     scaledCellHeight = ScalingHelpers::logicalToActual(logicalCellHeight);
 
-    // Give our elements a chance to update their logical extent.
-    for (auto& element : elements) {
-        // Note: We measure/arrange all elements, even if they're invisible,
-        //       so we can get the rest of the elements offsets correct.
-        element->measure(logicalExtent);
+    // If we're recycling, make sure we have enough widgets to fill our
+    // visible columns.
+    if (isRecycling) {
+        reserveItemWidgets(calcVisibleCellCount());
+    }
+
+    // If the UI scaling or our extent changed, all of our elements need to be
+    // re-measured.
+    if ((lastUsedScreenSize != Core::getActualScreenSize())
+        || !SDL_RectsEqualFloat(&lastUsedLogicalExtent, &logicalExtent)) {
+        for (auto& element : elements) {
+            element->measure(logicalExtent);
+        }
+
+        lastUsedScreenSize = Core::getActualScreenSize();
+        lastUsedLogicalExtent = logicalExtent;
+    }
+
+    // Give the elements in our visible columns a chance to update their
+    // logical extent. Offscreen elements will be measured when they're
+    // scrolled into view (during arrange()).
+    auto [firstIndex, lastIndex] = calcVisibleElementRange();
+    for (std::size_t i{firstIndex}; i < lastIndex; ++i) {
+        Widget& element{getItemWidget(i)};
+        if (element.getIsMeasureDirty()) {
+            element.measure(logicalExtent);
+        }
     }
 }
 
@@ -91,8 +121,17 @@ void HorizontalGridContainer::arrange(const SDL_FPoint& startPosition,
         return;
     }
 
-    // Lay out our elements in a vertical grid.
-    for (std::size_t i{0}; i < elements.size(); ++i) {
+    // Lay out our elements in a horizontal grid.
+    // Note: Only the elements in our visible columns are arranged. Offscreen
+    //       elements are left out of the locator and aren't rendered.
+    auto [firstIndex, lastIndex] = calcVisibleElementRange();
+    for (std::size_t i{firstIndex}; i < lastIndex; ++i) {
+        // If this element was invalidated while it was offscreen, measure it.
+        Widget& element{getItemWidget(i)};
+        if (element.getIsMeasureDirty()) {
+            element.measure(logicalExtent);
+        }
+
         // Get the cell coordinates for this element.
         std::size_t cellRow{i % numRows};
         std::size_t cellColumn{i / numRows};
@@ -107,15 +146,66 @@ void HorizontalGridContainer::arrange(const SDL_FPoint& startPosition,
         // Add this widget's offset to get our final offset.
         float finalX{fullExtent.x + cellXOffset};
         float finalY{fullExtent.y + cellYOffset};
-        elements[i]->arrange({finalX, finalY}, clippedExtent, widgetLocator);
+        element.arrange({finalX, finalY}, clippedExtent, widgetLocator);
+    }
+
+    firstArrangedIndex = firstIndex;
+    lastArrangedIndex = lastIndex;
+}
+
+void HorizontalGridContainer::render(const SDL_FPoint& windowTopLeft)
+{
+    // If this widget is fully clipped or culled, don't render it.
+    if (isRenderCulled(windowTopLeft)) {
+        return;
     }
+
+    // Render our children.
+    Widget::render(windowTopLeft);
+
+    // Render the visible elements that were last arranged.
+    // Note: Elements outside of this range may have stale extents.
+    lastArrangedIndex = std::min(lastArrangedIndex, getItemCount());
+    for (std::size_t i{firstArrangedIndex}; i < lastArrangedIndex; ++i) {
+        Widget& element{getItemWidget(i)};
+        if (element.getIsVisible()) {
+            element.render(windowTopLeft);
+        }
+    }
+}
+
+std::pair<std::size_t, std::size_t>
+    HorizontalGridContainer::calcVisibleElementRange()
+{
+    // Columns are filled down the rows, so each visible column holds a
+    // contiguous range of elements.
+    std::size_t firstIndex{columnScroll * static_cast<std::size_t>(numRows)};
+    std::size_t lastIndex{firstIndex + calcVisibleCellCount()};
+
+    return {std::min(firstIndex, getItemCount()),
+            std::min(lastIndex, getItemCount())};
+}
+
+std::size_t HorizontalGridContainer::calcVisibleCellCount()
+{
+    // If our cells or extent have no size, nothing is visible.
+    if ((scaledCellWidth <= 0) || (scaledExtent.w <= 0)) {
+        return 0;
+    }
+
+    // Calc how many columns fit within our extent, including a partial
+    // column.
+    std::size_t visibleColumns{static_cast<std::size_t>(
+        std::ceil(scaledExtent.w / scaledCellWidth))};
+
+    return (visibleColumns * numRows);
 }
 
 void HorizontalGridContainer::scrollElements(bool scrollLeft)
 {
     // Calc how many columns are currently present.
     int currentColumns{static_cast<int>(
-        std::ceil(elements.size() / static_cast<float>(numRows)))};
+        std::ceil(getItemCount() / static_cast<float>(numRows)))};
 
     // Calc how many columns can fit onscreen at once.
     int maxVisibleColumns{static_cast<int>(logicalExtent.w / logicalCellWidth)};
@@ -124,6 +214,7 @@ void HorizontalGridContainer::scrollElements(bool scrollLeft)
     if (scrollLeft && (columnScroll > 0)) {
         // Scroll left 1 row.
         columnScroll--;
+        invalidateArrange();
     }
     else if (!scrollLeft) {
         // Else if we're being asked to scroll right, calculate if there are
@@ -134,8 +225,15 @@ void HorizontalGridContainer::scrollElements(bool scrollLeft)
         // If there are any elements offscreen, scroll to the right 1 column.
         if (columnsRight > 0) {
             columnScroll++;
+            invalidateArrange();
         }
     }
+
+    // Bind any items that were scrolled into view now, so that any
+    // invalidation caused by the binder is handled in the upcoming layout
+    // pass.
+    auto [firstIndex, lastIndex] = calcVisibleElementRange();
+    bindItemWidgets(firstIndex, lastIndex);
 }
 
 } // namespace AUI
@@ -14,6 +14,7 @@ Image::Image(const SDL_FRect& inLogicalExtent, const std::string& inDebugName)
 , imageType{nullptr}
 , lastScaledExtent{scaledExtent}
 , alphaMod{1.0}
+, isOpaque{false}
 {
 }
 
@@ -23,6 +24,9 @@ void Image::setSimpleImage(const std::string& textureID,
     imageType = std::make_unique<SimpleImage>();
     SimpleImage* simpleImage{static_cast<SimpleImage*>(imageType.get())};
     simpleImage->set(textureID, scaleMode);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setSimpleImage(const std::string& textureID, SDL_FRect texExtent,
@@ -31,15 +35,44 @@ void Image::setSimpleImage(const std::string& textureID, SDL_FRect texExtent,
     imageType = std::make_unique<SimpleImage>();
     SimpleImage* simpleImage{static_cast<SimpleImage*>(imageType.get())};
     simpleImage->set(textureID, texExtent, scaleMode);
+
+    invalidateRender();
+    invalidateOpacity();
+}
+
+void Image::setSimpleImageAsync(const std::string& textureID,
+                                SDL_ScaleMode scaleMode)
+{
+    imageType = std::make_unique<SimpleImage>();
+    SimpleImage* simpleImage{static_cast<SimpleImage*>(imageType.get())};
+    simpleImage->setAsync(textureID, scaleMode);
+
+    invalidateRender();
+    invalidateOpacity();
+}
+
+void Image::setSimpleImageAsync(const std::string& textureID,
+                                SDL_FRect texExtent, SDL_ScaleMode scaleMode)
+{
+    imageType = std::make_unique<SimpleImage>();
+    SimpleImage* simpleImage{static_cast<SimpleImage*>(imageType.get())};
+    simpleImage->setAsync(textureID, texExtent, scaleMode);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setNineSliceImage(const std::string& textureID,
-                              NineSliceImage::SliceSizes sliceSizes)
+                              NineSliceImage::SliceSizes sliceSizes,
+                              NineSliceImage::RenderMode renderMode)
 {
     imageType = std::make_unique<NineSliceImage>();
     NineSliceImage* nineSliceImage{
         static_cast<NineSliceImage*>(imageType.get())};
-    nineSliceImage->set(textureID, sliceSizes, scaledExtent);
+    nineSliceImage->set(textureID, sliceSizes, scaledExtent, renderMode);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setMultiResImage(
@@ -59,6 +92,9 @@ void Image::setMultiResImage(
                                          info.texExtent, info.scaleMode);
         }
     }
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setTiledImage(const std::string& imagePath)
@@ -66,11 +102,17 @@ void Image::setTiledImage(const std::string& imagePath)
     imageType = std::make_unique<TiledImage>();
     TiledImage* tiledImage{static_cast<TiledImage*>(imageType.get())};
     tiledImage->set(imagePath, scaledExtent);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setCustomImage(std::unique_ptr<ImageType> inImageType)
 {
     imageType = std::move(inImageType);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setSimpleImage(SDL_Texture* texture, const std::string& textureID,
@@ -81,6 +123,9 @@ void Image::setSimpleImage(SDL_Texture* texture, const std::string& textureID,
     imageType = std::make_unique<SimpleImage>();
     SimpleImage* simpleImage{static_cast<SimpleImage*>(imageType.get())};
     simpleImage->set(textureID, scaleMode);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setSimpleImage(SDL_Texture* texture, const std::string& textureID,
@@ -91,18 +136,25 @@ void Image::setSimpleImage(SDL_Texture* texture, const std::string& textureID,
     imageType = std::make_unique<SimpleImage>();
     SimpleImage* simpleImage{static_cast<SimpleImage*>(imageType.get())};
     simpleImage->set(textureID, texExtent, scaleMode);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setNineSliceImage(SDL_Texture* texture,
                               const std::string& textureID,
-                              NineSliceImage::SliceSizes inSliceSizes)
+                              NineSliceImage::SliceSizes inSliceSizes,
+                              NineSliceImage::RenderMode renderMode)
 {
     Core::getAssetCache().addTexture(texture, textureID);
 
     imageType = std::make_unique<NineSliceImage>();
     NineSliceImage* nineSliceImage{
         static_cast<NineSliceImage*>(imageType.get())};
-    nineSliceImage->set(textureID, inSliceSizes, scaledExtent);
+    nineSliceImage->set(textureID, inSliceSizes, scaledExtent, renderMode);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setMultiResImage(
@@ -123,6 +175,9 @@ void Image::setMultiResImage(
                                          info.texExtent, info.scaleMode);
         }
     }
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setTiledImage(SDL_Texture* texture, const std::string& textureID)
@@ -132,11 +187,26 @@ void Image::setTiledImage(SDL_Texture* texture, const std::string& textureID)
     imageType = std::make_unique<TiledImage>();
     TiledImage* tiledImage{static_cast<TiledImage*>(imageType.get())};
     tiledImage->set(textureID, scaledExtent);
+
+    invalidateRender();
+    invalidateOpacity();
 }
 
 void Image::setAlphaMod(float newAlphaMod)
 {
     alphaMod = newAlphaMod;
+
+    invalidateRender();
+    invalidateOpacity();
+}
+
+void Image::setIsOpaque(bool inIsOpaque)
+{
+    isOpaque = inIsOpaque;
+
+    // Windows underneath us may need to be re-drawn.
+    invalidateRender();
+    invalidateOpacity();
 }
 
 SDL_FRect Image::getCurrentImageTextureExtent() const
@@ -145,6 +215,28 @@ SDL_FRect Image::getCurrentImageTextureExtent() const
     return imageType->currentTexExtent;
 }
 
+SDL_Texture* Image::getCurrentTexture() const
+{
+    if (imageType == nullptr) {
+        return nullptr;
+    }
+
+    return imageType->currentTexture.get();
+}
+
+bool Image::getIsOpaque() const
+{
+    // If we have no texture yet or are still waiting on one, we can't say.
+    if ((imageType == nullptr) || (imageType->currentTexture == nullptr)
+        || imageType->isTexturePending) {
+        return false;
+    }
+
+    return (alphaMod >= 1.f)
+           && (isOpaque
+               || !SDL_ISPIXELFORMAT_ALPHA(imageType->currentTexture->format));
+}
+
 void Image::measure(const SDL_FRect& availableExtent)
 {
     // Run the normal measure step (sets our scaledExtent).
@@ -186,6 +278,46 @@ void Image::render(const SDL_FPoint& windowTopLeft)
         return;
     }
 
+    // If we're waiting on an async texture, check if it's ready.
+    // Note: If it isn't, we invalidate so that a cached window will render
+    //       us again next frame.
+    if (imageType->isTexturePending) {
+        imageType->updatePendingTexture();
+        if (imageType->isTexturePending) {
+            invalidateRender();
+        }
+        else {
+            // Our texture changed, which may change our opacity.
+            invalidateOpacity();
+        }
+    }
+
+    // If we're outside of the region being rendered, there's nothing to do.
+    // Note: We check for culling after updating the pending texture, so that
+    //       a culled image still invalidates itself until its texture loads.
+    if (isRenderCulled(windowTopLeft)) {
+        return;
+    }
+
+    // Calc our final screen extents.
+    SDL_FRect finalFullExtent{fullExtent};
+    finalFullExtent.x += windowTopLeft.x;
+    finalFullExtent.y += windowTopLeft.y;
+    SDL_FRect finalExtent{clippedExtent};
+    finalExtent.x += windowTopLeft.x;
+    finalExtent.y += windowTopLeft.y;
+
+    // If the image type draws itself, let it.
+    if (imageType->render(finalFullExtent, finalExtent, alphaMod)) {
+        return;
+    }
+
+    // If we don't have a texture (e.g. no placeholder while loading),
+    // there's nothing to render.
+    if (imageType->currentTexture == nullptr) {
+        return;
+    }
+
     // If this widget is partially clipped, calculate a matching clipped
     // extent for the texture.
     SDL_FRect clippedTexExtent{imageType->currentTexExtent};
@@ -207,15 +339,10 @@ void Image::render(const SDL_FPoint& windowTopLeft)
         clippedTexExtent.h = clippedExtent.h * heightDiffFactor;
     }
 
-    // Apply the current alpha mod.
-    SDL_SetTextureAlphaModFloat(imageType->currentTexture.get(), alphaMod);
-
-    // Render the image.
-    SDL_FRect finalExtent{clippedExtent};
-    finalExtent.x += windowTopLeft.x;
-    finalExtent.y += windowTopLeft.y;
-    SDL_RenderTexture(Core::getRenderer(), imageType->currentTexture.get(),
-                      &clippedTexExtent, &finalExtent);
+    // Render the image with the current alpha mod.
+    Core::getRenderCommandList().addTexturedQuad(
+        imageType->currentTexture.get(), clippedTexExtent, finalExtent,
+        alphaMod);
 }
 
 } // namespace AUI
@@ -5,4 +5,33 @@ namespace AUI
 
 void ImageType::refresh(const SDL_FRect&) {}
 
+void ImageType::updatePendingTexture() {}
+
+bool ImageType::render(const SDL_FRect&, const SDL_FRect&, float)
+{
+    return false;
+}
+
+void ImageType::addQuad(std::vector<SDL_Vertex>& vertices,
+                        std::vector<int>& indices, const SDL_FRect& destRect,
+                        const SDL_FRect& texCoords, const SDL_FColor& color)
+{
+    int baseIndex{static_cast<int>(vertices.size())};
+    float right{destRect.x + destRect.w};
+    float bottom{destRect.y + destRect.h};
+    float texRight{texCoords.x + texCoords.w};
+    float texBottom{texCoords.y + texCoords.h};
+
+    vertices.push_back(
+        {{destRect.x, destRect.y}, color, {texCoords.x, texCoords.y}});
+    vertices.push_back({{right, destRect.y}, color, {texRight, texCoords.y}});
+    vertices.push_back({{right, bottom}, color, {texRight, texBottom}});
+    vertices.push_back(
+        {{destRect.x, bottom}, color, {texCoords.x, texBottom}});
+
+    for (int index : {0, 1, 2, 0, 2, 3}) {
+        indices.push_back(baseIndex + index);
+    }
+}
+
 } // namespace AUI
@@ -5,23 +5,26 @@
 
 namespace AUI
 {
+/** The scale mode that our source textures use.
+    We assume that nine slice textures will want to use "nearest" scaling to
+    maintain sharpness. */
+static constexpr SDL_ScaleMode SOURCE_SCALE_MODE{SDL_SCALEMODE_NEAREST};
+
 void NineSliceImage::set(const std::string& textureID, SliceSizes inSliceSizes,
-                         const SDL_FRect& scaledExtent)
+                         const SDL_FRect& scaledExtent,
+                         RenderMode inRenderMode)
 {
     // Attempt to load the image.
-    // Note: We assume that nine slice textures will want to use "nearest"
-    //       scaling to maintain sharpness.
     if ((sourceTexture = Core::getAssetCache().requestTexture(
-             textureID, SDL_SCALEMODE_NEAREST))) {
-        // Save the new slice sizes (will be used by the regenerate function).
+             textureID, SOURCE_SCALE_MODE))) {
+        // Save the new source ID and slice sizes (will be used by the
+        // regenerate function).
+        sourceTextureID = textureID;
         sliceSizes = inSliceSizes;
+        renderMode = inRenderMode;
 
-        // We're going to generate a texture as large as the given extent.
-        currentTexExtent.w = scaledExtent.w;
-        currentTexExtent.h = scaledExtent.h;
-
-        // Re-generate our nine slice texture.
-        regenerateNineSliceTexture();
+        // Set the desired extent and re-generate our texture if necessary.
+        refresh(scaledExtent);
     }
 }
 
@@ -31,11 +34,73 @@ void NineSliceImage::refresh(const SDL_FRect& scaledExtent)
     currentTexExtent.w = scaledExtent.w;
     currentTexExtent.h = scaledExtent.h;
 
+    // If we're drawing the slices directly, there's nothing to generate.
+    if (renderMode == RenderMode::Geometry) {
+        currentTexture = nullptr;
+        return;
+    }
+
     // Re-generate our nine slice texture.
     regenerateNineSliceTexture();
 }
 
+bool NineSliceImage::render(const SDL_FRect& fullExtent,
+                            const SDL_FRect& clippedExtent, float alphaMod)
+{
+    // If we're using a generated texture, let Image draw it.
+    if ((renderMode != RenderMode::Geometry) || !sourceTexture) {
+        return false;
+    }
+
+    float sourceWidth{};
+    float sourceHeight{};
+    SDL_GetTextureSize(sourceTexture.get(), &sourceWidth, &sourceHeight);
+
+    // Calc the column and row boundaries of the 3x3 grid, in the source
+    // texture and on the screen.
+    // Note: The corners aren't scaled, so the slice sizes are the same in
+    //       both spaces.
+    float sourceXs[4]{0, sliceSizes.left, (sourceWidth - sliceSizes.right),
+                      sourceWidth};
+    float sourceYs[4]{0, sliceSizes.top, (sourceHeight - sliceSizes.bottom),
+                      sourceHeight};
+    float fullRight{fullExtent.x + fullExtent.w};
+    float fullBottom{fullExtent.y + fullExtent.h};
+    float destXs[4]{fullExtent.x, (fullExtent.x + sliceSizes.left),
+                    (fullRight - sliceSizes.right), fullRight};
+    float destYs[4]{fullExtent.y, (fullExtent.y + sliceSizes.top),
+                    (fullBottom - sliceSizes.bottom), fullBottom};
+
+    // Add a quad for each slice.
+    vertices.clear();
+    indices.clear();
+    SDL_FColor color{1.f, 1.f, 1.f, alphaMod};
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            SDL_FRect sourceRect{sourceXs[column], sourceYs[row],
+                                 (sourceXs[column + 1] - sourceXs[column]),
+                                 (sourceYs[row + 1] - sourceYs[row])};
+            SDL_FRect destRect{destXs[column], destYs[row],
+                               (destXs[column + 1] - destXs[column]),
+                               (destYs[row + 1] - destYs[row])};
+            addSliceQuad(sourceRect, destRect, clippedExtent, sourceWidth,
+                         sourceHeight, color);
+        }
+    }
+
+    Core::getRenderCommandList().addGeometry(sourceTexture.get(), vertices,
+                                             indices, {0, 0}, nullptr);
+    return true;
+}
+
 void NineSliceImage::regenerateNineSliceTexture()
+{
+    // Get the texture from the cache, generating it if necessary.
+    currentTexture = Core::getAssetCache().requestGeneratedTexture(
+        getGeneratedTextureID(), [this] { return generateNineSliceTexture(); });
+}
+
+SDL_Texture* NineSliceImage::generateNineSliceTexture()
 {
     // Get the texture's pixel format and size.
     SDL_PixelFormat pixelFormat{sourceTexture->format};
@@ -57,16 +122,14 @@ void NineSliceImage::regenerateNineSliceTexture()
     if (rawTexture == nullptr) {
         AUI_LOG_FATAL("Failed to create texture: %s", SDL_GetError());
     }
-    std::shared_ptr<SDL_Texture> nineSliceTexture{
-        rawTexture, [](SDL_Texture* p) { SDL_DestroyTexture(p); }};
 
     // Set the blend mode (default is NONE, which causes black backgrounds).
-    SDL_SetTextureBlendMode(nineSliceTexture.get(), SDL_BLENDMODE_BLEND);
+    SDL_SetTextureBlendMode(rawTexture, SDL_BLENDMODE_BLEND);
 
     // Save the previous render target so we can restore it later, and set the 
     // new texture as the render target.
     SDL_Texture* previousRenderTarget{SDL_GetRenderTarget(Core::getRenderer())};
-    SDL_SetRenderTarget(Core::getRenderer(), nineSliceTexture.get());
+    SDL_SetRenderTarget(Core::getRenderer(), rawTexture);
 
     // Clear the texture (newly created textures are uninitialized).
     SDL_Color previousDrawColor{};
@@ -85,8 +148,23 @@ void NineSliceImage::regenerateNineSliceTexture()
     // Set the render target back to what it was.
     SDL_SetRenderTarget(Core::getRenderer(), previousRenderTarget);
 
-    // Set the generated texture as our new current texture.
-    currentTexture = nineSliceTexture;
+    return rawTexture;
+}
+
+std::string NineSliceImage::getGeneratedTextureID() const
+{
+    // Build the ID
+    // ("AUI_NineSlice_sourceID_top_right_bottom_left_widthxheight_scaleMode").
+    std::string idString{"AUI_NineSlice_"};
+    idString += sourceTextureID;
+    idString += "_" + std::to_string(sliceSizes.top);
+    idString += "_" + std::to_string(sliceSizes.right);
+    idString += "_" + std::to_string(sliceSizes.bottom);
+    idString += "_" + std::to_string(sliceSizes.left);
+    idString += "_" + std::to_string(static_cast<int>(currentTexExtent.w));
+    idString += "x" + std::to_string(static_cast<int>(currentTexExtent.h));
+    idString += "_" + std::to_string(static_cast<int>(SOURCE_SCALE_MODE));
+    return idString;
 }
 
 void NineSliceImage::copyCorners(float sourceWidth, float sourceHeight)
@@ -182,4 +260,30 @@ void NineSliceImage::copyCenter(float sourceWidth, float sourceHeight)
                       &destRect);
 }
 
+void NineSliceImage::addSliceQuad(const SDL_FRect& sourceRect,
+                                  const SDL_FRect& destRect,
+                                  const SDL_FRect& clippedExtent,
+                                  float sourceWidth, float sourceHeight,
+                                  const SDL_FColor& color)
+{
+    // Clip the slice. If it's fully clipped (or has no size, e.g. because
+    // we're smaller than our corners), skip it.
+    SDL_FRect finalRect{};
+    if (!SDL_GetRectIntersectionFloat(&destRect, &clippedExtent,
+                                      &finalRect)) {
+        return;
+    }
+
+    // Clip the source rect to match, and normalize it.
+    float xScale{sourceRect.w / destRect.w};
+    float yScale{sourceRect.h / destRect.h};
+    SDL_FRect texCoords{
+        ((sourceRect.x + ((finalRect.x - destRect.x) * xScale)) / sourceWidth),
+        ((sourceRect.y + ((finalRect.y - destRect.y) * yScale)) / sourceHeight),
+        ((finalRect.w * xScale) / sourceWidth),
+        ((finalRect.h * yScale) / sourceHeight)};
+
+    addQuad(vertices, indices, finalRect, texCoords, color);
+}
+
 } // namespace AUI
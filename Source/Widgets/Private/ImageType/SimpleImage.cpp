@@ -6,6 +6,8 @@ namespace AUI
 {
 void SimpleImage::set(const std::string& textureID, SDL_ScaleMode scaleMode)
 {
+    isTexturePending = false;
+
     // Attempt to load the image.
     if ((currentTexture
          = Core::getAssetCache().requestTexture(textureID, scaleMode))) {
@@ -18,6 +20,8 @@ void SimpleImage::set(const std::string& textureID, SDL_ScaleMode scaleMode)
 void SimpleImage::set(const std::string& textureID,
                       const SDL_FRect& inTexExtent, SDL_ScaleMode scaleMode)
 {
+    isTexturePending = false;
+
     // Attempt to load the image.
     if ((currentTexture
          = Core::getAssetCache().requestTexture(textureID, scaleMode))) {
@@ -26,10 +30,82 @@ void SimpleImage::set(const std::string& textureID,
     }
 }
 
+void SimpleImage::setAsync(const std::string& textureID,
+                           SDL_ScaleMode scaleMode)
+{
+    pendingTextureID = textureID;
+    pendingScaleMode = scaleMode;
+    pendingTexExtent = std::nullopt;
+
+    setTextureOrPlaceholder(
+        Core::getAssetCache().requestTextureAsync(textureID, scaleMode));
+}
+
+void SimpleImage::setAsync(const std::string& textureID,
+                           const SDL_FRect& inTexExtent,
+                           SDL_ScaleMode scaleMode)
+{
+    pendingTextureID = textureID;
+    pendingScaleMode = scaleMode;
+    pendingTexExtent = inTexExtent;
+
+    setTextureOrPlaceholder(
+        Core::getAssetCache().requestTextureAsync(textureID, scaleMode));
+}
+
 void SimpleImage::clear()
 {
     currentTexture = nullptr;
     currentTexExtent = SDL_FRect{};
+    isTexturePending = false;
+}
+
+void SimpleImage::updatePendingTexture()
+{
+    // If the texture is still loading, keep waiting.
+    AssetCache& assetCache{Core::getAssetCache()};
+    if (assetCache.isTextureLoadPending(pendingTextureID)) {
+        return;
+    }
+
+    // If the load failed, leave the image empty (the failure was already
+    // logged).
+    if (assetCache.didTextureLoadFail(pendingTextureID)) {
+        clear();
+        return;
+    }
+
+    // The load finished. This will usually be a cache hit. If the texture
+    // was already pruned, this will queue another load.
+    setTextureOrPlaceholder(
+        assetCache.requestTextureAsync(pendingTextureID, pendingScaleMode));
+}
+
+void SimpleImage::setTextureOrPlaceholder(
+    std::shared_ptr<SDL_Texture> texture)
+{
+    // If the texture was already in the cache, use it.
+    if (texture) {
+        isTexturePending = false;
+        currentTexture = std::move(texture);
+        if (pendingTexExtent) {
+            currentTexExtent = pendingTexExtent.value();
+        }
+        else {
+            SDL_GetTextureSize(currentTexture.get(), &(currentTexExtent.w),
+                               &(currentTexExtent.h));
+        }
+        return;
+    }
+
+    // The texture is loading, display the placeholder until it's ready.
+    isTexturePending = true;
+    currentTexture = Core::getAssetCache().getAsyncPlaceholder();
+    currentTexExtent = SDL_FRect{};
+    if (currentTexture) {
+        SDL_GetTextureSize(currentTexture.get(), &(currentTexExtent.w),
+                           &(currentTexExtent.h));
+    }
 }
 
 } // namespace AUI
@@ -3,6 +3,7 @@
 #include "AUI/AssetCache.h"
 #include "AUI/Internal/Log.h"
 #include <SDL3/SDL_render.h>
+#include <cmath>
 
 namespace AUI
 {
@@ -14,89 +15,71 @@ void TiledImage::set(const std::string& textureID,
     //       to maintain sharpness.
     if ((sourceTexture = Core::getAssetCache().requestTexture(
              textureID, SDL_SCALEMODE_NEAREST))) {
-        // We're going to generate a texture as large as the given extent.
-        currentTexExtent.w = scaledExtent.w;
-        currentTexExtent.h = scaledExtent.h;
-
-        // Re-generate our tiled texture.
-        regenerateTiledTexture();
+        refresh(scaledExtent);
     }
 }
 
 void TiledImage::refresh(const SDL_FRect& scaledExtent)
 {
-    // Set the new desired extent.
+    // Set the new extent. The tiles are drawn on the fly, so there's nothing
+    // to regenerate.
     currentTexExtent.w = scaledExtent.w;
     currentTexExtent.h = scaledExtent.h;
-
-    // Re-generate our tiled texture.
-    regenerateTiledTexture();
 }
 
-void TiledImage::regenerateTiledTexture()
+bool TiledImage::render(const SDL_FRect& fullExtent,
+                        const SDL_FRect& clippedExtent, float alphaMod)
 {
-    // Get the texture's pixel format and size.
-    SDL_PixelFormat pixelFormat{sourceTexture->format};
-    float sourceWidth{};
-    float sourceHeight{};
-    SDL_GetTextureSize(sourceTexture.get(), &sourceWidth, &sourceHeight);
-
-    // Allocate the new texture.
-    SDL_Texture* rawTexture{SDL_CreateTexture(
-        Core::getRenderer(), pixelFormat, SDL_TEXTUREACCESS_TARGET,
-        static_cast<int>(currentTexExtent.w),
-        static_cast<int>(currentTexExtent.h))};
-    if (rawTexture == nullptr) {
-        AUI_LOG_FATAL("Failed to create texture: %s", SDL_GetError());
+    // If we failed to load the image, there's nothing to draw.
+    if (!sourceTexture) {
+        return true;
     }
-    currentTexture = std::shared_ptr<SDL_Texture>(
-        rawTexture, [](SDL_Texture* p) { SDL_DestroyTexture(p); });
-
-    // Save the previous render target so we can restore it later, and set the 
-    // new texture as the render target.
-    SDL_Texture* previousRenderTarget{SDL_GetRenderTarget(Core::getRenderer())};
-    SDL_SetRenderTarget(Core::getRenderer(), currentTexture.get());
-
-    // Clear the texture (newly created textures are uninitialized).
-    SDL_Color previousDrawColor{};
-    SDL_GetRenderDrawColor(Core::getRenderer(), &previousDrawColor.r, 
-        &previousDrawColor.g, &previousDrawColor.b, &previousDrawColor.a);
-    SDL_SetRenderDrawColor(Core::getRenderer(), 0, 0, 0, 0);
-    SDL_RenderClear(Core::getRenderer());
-    SDL_SetRenderDrawColor(Core::getRenderer(), previousDrawColor.r, 
-        previousDrawColor.g, previousDrawColor.b, previousDrawColor.a);
 
-    // Tile the image to cover the given extent.
-    for (float y{0}; y < currentTexExtent.h; y += sourceHeight) {
-        for (float x{0}; x < currentTexExtent.w; x += sourceWidth) {
-            // Set up the tile's extents.
-            SDL_FRect tileExtent{x, y, sourceWidth, sourceHeight};
-            SDL_FRect tileTexExtent{0, 0, sourceWidth, sourceHeight};
+    float tileWidth{};
+    float tileHeight{};
+    SDL_GetTextureSize(sourceTexture.get(), &tileWidth, &tileHeight);
+    if ((tileWidth <= 0) || (tileHeight <= 0)) {
+        return true;
+    }
 
-            // If the tile is too wide to fit, clip it.
-            float tileRight{tileExtent.x + tileExtent.w};
-            float offsetRight{currentTexExtent.x + currentTexExtent.w};
-            if (tileRight > offsetRight) {
-                tileExtent.w -= (tileRight - offsetRight);
-                tileTexExtent.w -= (tileRight - offsetRight);
-            }
+    // Find the first visible tile. Tiles start at our full extent's top
+    // left, and are clipped at the right and bottom edges.
+    float firstColumn{std::floor((clippedExtent.x - fullExtent.x) / tileWidth)};
+    float firstRow{std::floor((clippedExtent.y - fullExtent.y) / tileHeight)};
+    float startX{fullExtent.x + (firstColumn * tileWidth)};
+    float startY{fullExtent.y + (firstRow * tileHeight)};
+    float clippedRight{clippedExtent.x + clippedExtent.w};
+    float clippedBottom{clippedExtent.y + clippedExtent.h};
 
-            // If the tile is too tall to fit, clip it.
-            float tileBottom{tileExtent.y + tileExtent.h};
-            float offsetBottom{currentTexExtent.y + currentTexExtent.h};
-            if (tileBottom > offsetBottom) {
-                tileExtent.h -= (tileBottom - offsetBottom);
-                tileTexExtent.h -= (tileBottom - offsetBottom);
+    // Add a quad for each visible tile, clipping the ones on the edges.
+    vertices.clear();
+    indices.clear();
+    SDL_FColor color{1.f, 1.f, 1.f, alphaMod};
+    for (float y{startY}; y < clippedBottom; y += tileHeight) {
+        for (float x{startX}; x < clippedRight; x += tileWidth) {
+            SDL_FRect tileExtent{x, y, tileWidth, tileHeight};
+            SDL_FRect finalExtent{};
+            if (!SDL_GetRectIntersectionFloat(&tileExtent, &clippedExtent,
+                                              &finalExtent)) {
+                continue;
             }
 
-            // Render the tile.
-            SDL_RenderTexture(Core::getRenderer(), sourceTexture.get(),
-                              &tileTexExtent, &tileExtent);
+            SDL_FRect texCoords{((finalExtent.x - x) / tileWidth),
+                                ((finalExtent.y - y) / tileHeight),
+                                (finalExtent.w / tileWidth),
+                                (finalExtent.h / tileHeight)};
+            addQuad(vertices, indices, finalExtent, texCoords, color);
         }
     }
 
-    // Set the render target back to what it was.
-    SDL_SetRenderTarget(Core::getRenderer(), previousRenderTarget);
+    Core::getRenderCommandList().addGeometry(sourceTexture.get(), vertices,
+                                             indices, {0, 0}, nullptr);
+    return true;
+}
+
+const std::vector<SDL_Vertex>& TiledImage::getVertices() const
+{
+    return vertices;
 }
 
 } // namespace AUI
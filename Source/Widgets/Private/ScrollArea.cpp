@@ -43,6 +43,7 @@ void ScrollArea::setScrollOrientation(Orientation inScrollOrientation)
 void ScrollArea::setScrollOrigin(ScrollOrigin inScrollOrigin)
 {
     scrollOrigin = inScrollOrigin;
+    invalidateArrange();
 }
 
 float ScrollArea::getScrollDistanceX()
@@ -85,6 +86,9 @@ void ScrollArea::measure(const SDL_FRect& availableExtent)
     Widget::measure(availableExtent);
 
     // Give our content widget a chance to update its logical extent.
+    // Note: content may have been replaced since the last pass, so we re-set
+    //       its parent every time.
+    content->setParent(this);
     content->measure(logicalExtent);
 
     // Refresh the scroll step.
@@ -150,8 +154,8 @@ void ScrollArea::arrange(const SDL_FPoint& startPosition,
 
 void ScrollArea::render(const SDL_FPoint& windowTopLeft)
 {
-    // If this widget is fully clipped, don't render it.
-    if (SDL_RectEmptyFloat(&clippedExtent)) {
+    // If this widget is fully clipped or culled, don't render it.
+    if (isRenderCulled(windowTopLeft)) {
         return;
     }
 
@@ -180,6 +184,7 @@ void ScrollArea::handleMouseScrollHorizontal(float amountScrolled)
 
     // Clamp the scroll distance so we don't go too far.
     scrollDistanceX = std::clamp(scrollDistanceX, 0.f, maxScrollDistance);
+    invalidateArrange();
 }
 
 void ScrollArea::handleMouseScrollVertical(float amountScrolled)
@@ -208,6 +213,7 @@ void ScrollArea::handleMouseScrollVertical(float amountScrolled)
 
     // Clamp the scroll distance so we don't go too far.
     scrollDistanceY = std::clamp(scrollDistanceY, 0.f, maxScrollDistance);
+    invalidateArrange();
 }
 
 SDL_FRect ScrollArea::calcContentExtent() const
@@ -1,12 +1,32 @@
 #include "AUI/Text.h"
 #include "AUI/Core.h"
 #include "AUI/ScalingHelpers.h"
+#include "AUI/GlyphAtlas.h"
 #include "AUI/Internal/Log.h"
 #include "AUI/SDLHelpers.h"
 #include <SDL3/SDL_render.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
 
 namespace AUI
 {
+/** The pixel format of the textures that we manage ourselves. Surfaces in
+    other formats (e.g. the palettized surfaces from RenderMode::Solid) are
+    converted to it, so that any surface can be copied into our texture. */
+static constexpr SDL_PixelFormat TEXT_TEXTURE_FORMAT{SDL_PIXELFORMAT_ARGB8888};
+
+Text::TextureStats Text::textureStats{};
+
+/**
+ * Mixes the given value into the given hash.
+ */
+static void hashCombine(std::size_t& hash, std::size_t value)
+{
+    hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+}
+
 Text::Text(const SDL_FRect& inLogicalExtent, const std::string& inDebugName)
 : Widget(inLogicalExtent, inDebugName)
 , fontPath{""}
@@ -17,6 +37,10 @@ Text::Text(const SDL_FRect& inLogicalExtent, const std::string& inDebugName)
 , color{0, 0, 0, 255}
 , backgroundColor{0, 0, 0, 0}
 , renderMode{RenderMode::Blended}
+, renderBackend{RenderBackend::Texture}
+, textureSharingEnabled{false}
+, asyncRasterizationEnabled{false}
+, pendingRasterJobID{0}
 , wordWrapEnabled{true}
 , autoHeightEnabled{false}
 , text{"Initialized"}
@@ -25,7 +49,11 @@ Text::Text(const SDL_FRect& inLogicalExtent, const std::string& inDebugName)
 , lastUsedScreenSize{0, 0}
 , textureIsDirty{true}
 , alignmentIsDirty{true}
+, characterOffsets{}
+, lineHeight{0}
+, characterOffsetsAreDirty{true}
 , textTexture{nullptr}
+, glyphBatches{}
 , textureExtent{}
 , textExtent{}
 , textOffset{0}
@@ -34,6 +62,11 @@ Text::Text(const SDL_FRect& inLogicalExtent, const std::string& inDebugName)
 {
 }
 
+Text::~Text()
+{
+    cancelPendingRasterization();
+}
+
 void Text::setFont(std::string_view inFontPath, float inLogicalFontSize,
                    int inLogicalFontOutlineSize)
 {
@@ -46,24 +79,68 @@ void Text::setFont(std::string_view inFontPath, float inLogicalFontSize,
     refreshFontObject();
 
     textureIsDirty = true;
+    invalidateMeasure();
 }
 
 void Text::setColor(const SDL_Color& inColor)
 {
     color = inColor;
     textureIsDirty = true;
+    invalidateMeasure();
 }
 
 void Text::setBackgroundColor(const SDL_Color& inBackgroundColor)
 {
     backgroundColor = inBackgroundColor;
     textureIsDirty = true;
+    invalidateMeasure();
 }
 
 void Text::setRenderMode(RenderMode inRenderMode)
 {
     renderMode = inRenderMode;
     textureIsDirty = true;
+    invalidateMeasure();
+}
+
+void Text::setRenderBackend(RenderBackend inRenderBackend)
+{
+    renderBackend = inRenderBackend;
+
+    // Free whichever resources the old backend was using.
+    if (renderBackend == RenderBackend::Texture) {
+        glyphBatches.clear();
+    }
+    else {
+        textTexture = nullptr;
+    }
+
+    // Only the GlyphAtlas backend uses an outlined font, so load or free it.
+    if (font && (logicalFontOutlineSize > 0)) {
+        refreshFontObject();
+    }
+
+    textureIsDirty = true;
+    invalidateMeasure();
+}
+
+void Text::setTextureSharingEnabled(bool inTextureSharingEnabled)
+{
+    textureSharingEnabled = inTextureSharingEnabled;
+
+    // Drop our current texture, so we never copy into a shared texture (or
+    // hold onto an unshared one).
+    textTexture = nullptr;
+
+    textureIsDirty = true;
+    invalidateMeasure();
+}
+
+void Text::setAsyncRasterizationEnabled(bool inAsyncRasterizationEnabled)
+{
+    asyncRasterizationEnabled = inAsyncRasterizationEnabled;
+    textureIsDirty = true;
+    invalidateMeasure();
 }
 
 void Text::setText(std::string_view inText)
@@ -71,6 +148,8 @@ void Text::setText(std::string_view inText)
     if (text != inText) {
         text = inText;
         textureIsDirty = true;
+        characterOffsetsAreDirty = true;
+        invalidateMeasure();
     }
 }
 
@@ -78,27 +157,32 @@ void Text::setVerticalAlignment(VerticalAlignment inVerticalAlignment)
 {
     verticalAlignment = inVerticalAlignment;
     alignmentIsDirty = true;
+    invalidateMeasure();
 }
 
 void Text::setHorizontalAlignment(HorizontalAlignment inHorizontalAlignment)
 {
     horizontalAlignment = inHorizontalAlignment;
     alignmentIsDirty = true;
+    invalidateMeasure();
 }
 
 void Text::setWordWrapEnabled(bool inWordWrapEnabled)
 {
     wordWrapEnabled = inWordWrapEnabled;
+    invalidateMeasure();
 }
 
 void Text::setAutoHeightEnabled(bool inAutoHeightEnabled)
 {
     autoHeightEnabled = inAutoHeightEnabled;
+    invalidateMeasure();
 }
 
 void Text::setTextOffset(float inTextOffset)
 {
     textOffset = inTextOffset;
+    invalidateArrange();
 }
 
 void Text::insertText(std::string_view inText, std::size_t index)
@@ -106,6 +190,8 @@ void Text::insertText(std::string_view inText, std::size_t index)
     // Insert the given text at the given index.
     text.insert(index, inText);
     textureIsDirty = true;
+    characterOffsetsAreDirty = true;
+    invalidateMeasure();
 }
 
 bool Text::eraseCharacter(std::size_t index)
@@ -114,6 +200,8 @@ bool Text::eraseCharacter(std::size_t index)
     if (text.length() > index) {
         text.erase(text.begin() + index);
         textureIsDirty = true;
+        characterOffsetsAreDirty = true;
+        invalidateMeasure();
         return true;
     }
     else {
@@ -135,54 +223,50 @@ void Text::refreshTexture()
                       debugName.c_str());
     }
 
-    // Create a temporary surface on the cpu and render our text image using the
-    // current renderMode.
-    SDL_Surface* surface{getSurface(font.get(), color, backgroundColor)};
-
-    // If we have an outline, create an outlined background surface and blit
-    // the text image onto it.
-    if (logicalFontOutlineSize > 0) {
-        // Create a temporary surface using the outlined background text.
-        SDL_Color blackColor{0, 0, 0, 0};
-        SDL_Surface* backgroundSurface{
-            getSurface(outlinedFont.get(), blackColor, blackColor)};
-
-        // Calculate the foreground text's offset to center it on the
-        // outlined background text.
-        int actualOutlineSize{
-            ScalingHelpers::logicalToActual(logicalFontOutlineSize)};
-        SDL_Rect foregroundExtent{actualOutlineSize, actualOutlineSize,
-                                  surface->w - actualOutlineSize,
-                                  surface->h - actualOutlineSize};
-
-        // Blit the foreground text onto the background outlined text.
-        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND);
-        SDL_BlitSurface(surface, nullptr, backgroundSurface, &foregroundExtent);
+    // If we're waiting on an async rasterization, its result is now stale.
+    cancelPendingRasterization();
+    textureIsDirty = false;
 
-        // Free the old foreground surface and set the new combined surface
-        // as the one to use.
-        SDL_DestroySurface(surface);
-        surface = backgroundSurface;
+    // If we're using the glyph atlas, we just need to re-build our quads.
+    if (renderBackend == RenderBackend::GlyphAtlas) {
+        refreshGlyphBatches();
+        setTextureSize(textureExtent.w, textureExtent.h);
+        return;
     }
 
-    // Move the image to a texture on the gpu.
-    SDL_Texture* texture{
-        SDL_CreateTextureFromSurface(Core::getRenderer(), surface)};
-    SDL_DestroySurface(surface);
-    if (texture == nullptr) {
-        AUI_LOG_FATAL("Failed to create texture.");
+    // If texture sharing is enabled, try to get a matching texture from the
+    // asset cache.
+    // Note: If we're rasterizing async, we don't generate one here. It'll
+    //       be added to the cache when our job finishes.
+    if (textureSharingEnabled) {
+        std::shared_ptr<SDL_Texture> sharedTexture{
+            Core::getAssetCache().requestGeneratedTexture(
+                getSharedTextureID(), [this]() -> SDL_Texture* {
+                    return (asyncRasterizationEnabled ? nullptr
+                                                      : generateTextTexture());
+                })};
+        if (sharedTexture) {
+            textTexture = std::move(sharedTexture);
+            float textureWidth{};
+            float textureHeight{};
+            SDL_GetTextureSize(textTexture.get(), &textureWidth,
+                               &textureHeight);
+            setTextureSize(textureWidth, textureHeight);
+            return;
+        }
     }
 
-    // Give ownership of the texture pointer to our smart pointer.
-    textTexture = std::unique_ptr<SDL_Texture, TextureDeleter>(texture);
-
-    // Save the width and height of the new texture.
-    SDL_GetTextureSize(textTexture.get(), &(textureExtent.w),
-                       &(textureExtent.h));
-    textExtent = {0, 0, textureExtent.w, textureExtent.h};
+    // If we're rasterizing async, queue a job. Our old texture will stay
+    // visible until it finishes.
+    if (asyncRasterizationEnabled) {
+        pendingRasterJobID
+            = Core::getAssetCache().getTextRasterizer().requestRasterization(
+                buildRasterRequest());
+        return;
+    }
 
-    textureIsDirty = false;
-    alignmentIsDirty = true;
+    // Render our text into our own texture.
+    applyTextSurface(generateTextSurface());
 }
 
 const std::string& Text::asString()
@@ -192,16 +276,13 @@ const std::string& Text::asString()
 
 SDL_FRect Text::calcCharacterOffset(std::size_t index)
 {
-    // Get a null-terminated substring containing all characters up to index.
-    std::string relevantChars{text, 0, index};
+    if (characterOffsetsAreDirty) {
+        refreshCharacterOffsets();
+    }
 
-    // Get the x offset and height from the relevant characters.
-    int offsetExtentX{0};
-    int offsetExtentH{0};
-    TTF_GetStringSize(font.get(), relevantChars.c_str(), relevantChars.size(),
-                      &offsetExtentX, &offsetExtentH);
-    SDL_FRect offsetExtent{static_cast<float>(offsetExtentX), 0, 0,
-                           static_cast<float>(offsetExtentH)};
+    // Get the x offset and height of the given character.
+    index = std::min(index, (characterOffsets.size() - 1));
+    SDL_FRect offsetExtent{characterOffsets[index], 0, 0, lineHeight};
 
     // Account for our alignment/position by adding the text extent's offset.
     offsetExtent.x += textExtent.x;
@@ -213,6 +294,42 @@ SDL_FRect Text::calcCharacterOffset(std::size_t index)
     return offsetExtent;
 }
 
+std::size_t Text::calcCharacterIndex(float offsetX)
+{
+    if (characterOffsetsAreDirty) {
+        refreshCharacterOffsets();
+    }
+
+    // Make the offset relative to the start of the text (undoing the
+    // adjustments that calcCharacterOffset() makes).
+    offsetX -= (textExtent.x + textOffset);
+
+    // Find the first character boundary at or after the given offset.
+    // Note: Bytes within a multi-byte character share an offset, so this
+    //       will always land on the start of a character.
+    auto nextIt{std::lower_bound(characterOffsets.begin(),
+                                 characterOffsets.end(), offsetX)};
+    if (nextIt == characterOffsets.begin()) {
+        return 0;
+    }
+    else if (nextIt == characterOffsets.end()) {
+        return (characterOffsets.size() - 1);
+    }
+
+    // Find the start of the previous character.
+    auto previousIt{std::lower_bound(characterOffsets.begin(), nextIt,
+                                     *(nextIt - 1))};
+
+    // Return whichever boundary is closer.
+    if ((offsetX - *previousIt) < (*nextIt - offsetX)) {
+        return static_cast<std::size_t>(previousIt
+                                        - characterOffsets.begin());
+    }
+    else {
+        return static_cast<std::size_t>(nextIt - characterOffsets.begin());
+    }
+}
+
 int Text::calcStringWidth(const std::string& string)
 {
     // Calculate the width that the given string would have if rendered using
@@ -244,6 +361,16 @@ float Text::getTextOffset()
     return textOffset;
 }
 
+const Text::TextureStats& Text::getTextureStats()
+{
+    return textureStats;
+}
+
+void Text::resetTextureStats()
+{
+    textureStats = {};
+}
+
 void Text::setLogicalExtent(const SDL_FRect& inLogicalExtent)
 {
     // Scale and set the extent.
@@ -265,6 +392,11 @@ void Text::measure(const SDL_FRect& availableExtent)
         refreshTexture();
     }
 
+    // If we're waiting on an async rasterization, check if it finished.
+    if (pendingRasterJobID != 0) {
+        updatePendingRasterization();
+    }
+
     // If auto-height is enabled, set this widget's height to match the texture.
     // Note: We don't adjust to fit availableExtent because we want to match
     //       the texture's size, not the parent's size. We'll clip in arrange()
@@ -315,12 +447,40 @@ void Text::arrange(const SDL_FPoint& startPosition,
 
 void Text::render(const SDL_FPoint& windowTopLeft)
 {
-    // If this widget is fully clipped, don't render it.
-    if (SDL_RectEmptyFloat(&clippedExtent)) {
+    // If we're waiting on an async rasterization, check if it finished.
+    // Note: If it did, we need to re-measure to pick it up. If it didn't, we
+    //       invalidate so that a cached window will render us again next
+    //       frame.
+    if (pendingRasterJobID != 0) {
+        if (Core::getAssetCache().getTextRasterizer().isJobComplete(
+                pendingRasterJobID)) {
+            invalidateMeasure();
+        }
+        else {
+            invalidateRender();
+        }
+    }
+
+    // If this widget is fully clipped or culled, don't render it.
+    // Note: We check for culling after checking our pending rasterization,
+    //       so that culled text still gets updated once it finishes.
+    if (isRenderCulled(windowTopLeft)) {
+        return;
+    }
+
+    // If we're using the glyph atlas, render our quads.
+    if (renderBackend == RenderBackend::GlyphAtlas) {
+        renderGlyphBatches(windowTopLeft);
         return;
     }
 
     if (!textTexture) {
+        // If our first async rasterization hasn't finished, there's nothing
+        // to render yet.
+        if (pendingRasterJobID != 0) {
+            return;
+        }
+
         AUI_LOG_FATAL("Tried to render Font with no texture. DebugName: %s",
                       debugName.c_str());
     }
@@ -329,8 +489,8 @@ void Text::render(const SDL_FPoint& windowTopLeft)
     SDL_FRect finalExtent{offsetClippedTextExtent};
     finalExtent.x += windowTopLeft.x;
     finalExtent.y += windowTopLeft.y;
-    SDL_RenderTexture(Core::getRenderer(), textTexture.get(),
-                      &offsetClippedTextureExtent, &finalExtent);
+    Core::getRenderCommandList().addTexturedQuad(
+        textTexture.get(), offsetClippedTextureExtent, finalExtent);
 }
 
 void Text::refreshScaling()
@@ -339,6 +499,7 @@ void Text::refreshScaling()
     refreshFontObject();
 
     // Re-render the text texture.
+    textureIsDirty = true;
     refreshTexture();
 }
 
@@ -389,9 +550,15 @@ void Text::refreshFontObject()
     // Attempt to load the desired font (errors on failure).
     AssetCache& assetCache{Core::getAssetCache()};
     font = assetCache.requestFont(fontPath, actualFontSize, 0);
+    characterOffsetsAreDirty = true;
 
-    // If we have an outline, load the outlined font as well.
-    if (logicalFontOutlineSize > 0) {
+    // If we have an outline and are using the glyph atlas, load the outlined
+    // font as well.
+    // Note: The Texture backend builds its outlines from the text's alpha
+    //       (see TextRasterizer), so it doesn't need an outlined font.
+    outlinedFont = nullptr;
+    if ((logicalFontOutlineSize > 0)
+        && (renderBackend == RenderBackend::GlyphAtlas)) {
         int actualFontOutlineSize{
             ScalingHelpers::logicalToActual(logicalFontOutlineSize)};
         outlinedFont = assetCache.requestFont(fontPath, actualFontSize,
@@ -399,74 +566,462 @@ void Text::refreshFontObject()
     }
 }
 
-SDL_Surface* Text::getSurface(TTF_Font* font, const SDL_Color& fontColor,
-                              const SDL_Color& fontBackgroundColor)
+TextRasterizer::Request Text::buildRasterRequest() const
 {
-    // If the text string is empty, render a space instead.
-    std::string spaceText{" "};
-    std::string_view textToRender{text};
-    if (text == "") {
-        textToRender = " ";
+    TextRasterizer::Request request{};
+    request.fontPath = fontPath;
+    request.fontSize = ScalingHelpers::logicalToActual(logicalFontSize);
+    if (logicalFontOutlineSize > 0) {
+        request.fontOutlineSize
+            = ScalingHelpers::logicalToActual(logicalFontOutlineSize);
     }
+    request.text = text;
+    request.renderMode = renderMode;
+    request.color = color;
+    request.backgroundColor = backgroundColor;
 
-    // Create a temporary surface on the cpu and render our image using the
-    // set renderMode.
-    SDL_Surface* surface{nullptr};
+    // Note: We need to manually scale our width since it may not yet have
+    //       been updated.
     if (wordWrapEnabled) {
-        // Note: We need to manually scale our width since it may not yet have
-        //       been updated.
-        int scaledWidth{
-            static_cast<int>(ScalingHelpers::logicalToActual(logicalExtent.w))};
-        switch (renderMode) {
-            case RenderMode::Solid:
-                surface = TTF_RenderText_Solid_Wrapped(
-                    font, textToRender.data(), textToRender.size(), fontColor,
-                    scaledWidth);
-                break;
-            case RenderMode::Shaded:
-                surface = TTF_RenderText_Shaded_Wrapped(
-                    font, textToRender.data(), textToRender.size(), fontColor,
-                    fontBackgroundColor, scaledWidth);
-                break;
-            case RenderMode::Blended:
-                surface = TTF_RenderText_Blended_Wrapped(
-                    font, textToRender.data(), textToRender.size(), fontColor,
-                    scaledWidth);
-                break;
-            case RenderMode::LCD:
-                surface = TTF_RenderText_LCD_Wrapped(
-                    font, textToRender.data(), textToRender.size(), fontColor,
-                    fontBackgroundColor, scaledWidth);
-                break;
+        request.wrapWidth = static_cast<int>(
+            ScalingHelpers::logicalToActual(logicalExtent.w));
+    }
+
+    return request;
+}
+
+SDL_Surface* Text::generateTextSurface()
+{
+    // Create a temporary surface on the cpu and render our text image using the
+    // current renderMode.
+    SDL_Surface* surface{
+        TextRasterizer::rasterize(buildRasterRequest(), font.get())};
+    if (surface == nullptr) {
+        AUI_LOG_FATAL("Failed to create surface.");
+    }
+
+    return surface;
+}
+
+SDL_Texture* Text::generateTextTexture()
+{
+    // Move the image to a texture on the gpu.
+    SDL_Surface* surface{generateTextSurface()};
+    SDL_Texture* texture{
+        SDL_CreateTextureFromSurface(Core::getRenderer(), surface)};
+    SDL_DestroySurface(surface);
+    if (texture == nullptr) {
+        AUI_LOG_FATAL("Failed to create texture.");
+    }
+
+    return texture;
+}
+
+void Text::updateTextTexture(SDL_Surface* surface)
+{
+    // Convert the surface to our texture's format, if necessary.
+    if (surface->format != TEXT_TEXTURE_FORMAT) {
+        SDL_Surface* convertedSurface{
+            SDL_ConvertSurface(surface, TEXT_TEXTURE_FORMAT)};
+        SDL_DestroySurface(surface);
+        if (convertedSurface == nullptr) {
+            AUI_LOG_FATAL("Failed to convert surface: %s", SDL_GetError());
         }
+        surface = convertedSurface;
+    }
+
+    // If the surface doesn't fit in our texture, or our texture is far
+    // bigger than it needs to be, allocate a new texture with 25% headroom.
+    int desiredWidth{surface->w + (surface->w / 4)};
+    int desiredHeight{surface->h + (surface->h / 4)};
+    if (!textTexture || (surface->w > textTexture->w)
+        || (surface->h > textTexture->h)
+        || (textTexture->w > (desiredWidth * 2))
+        || (textTexture->h > (desiredHeight * 2))) {
+        SDL_Texture* texture{SDL_CreateTexture(
+            Core::getRenderer(), TEXT_TEXTURE_FORMAT,
+            SDL_TEXTUREACCESS_STREAMING, desiredWidth, desiredHeight)};
+        if (texture == nullptr) {
+            AUI_LOG_FATAL("Failed to create texture: %s", SDL_GetError());
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        textTexture = std::shared_ptr<SDL_Texture>(
+            texture, [](SDL_Texture* p) { SDL_DestroyTexture(p); });
+        textureStats.reallocationCount++;
     }
     else {
-        switch (renderMode) {
-            case RenderMode::Solid:
-                surface = TTF_RenderText_Solid(font, textToRender.data(),
-                                               textToRender.size(), fontColor);
-                break;
-            case RenderMode::Shaded:
-                surface = TTF_RenderText_Shaded(font, textToRender.data(),
-                                                textToRender.size(), fontColor,
-                                                fontBackgroundColor);
-                break;
-            case RenderMode::Blended:
-                surface = TTF_RenderText_Blended(
-                    font, textToRender.data(), textToRender.size(), fontColor);
-                break;
-            case RenderMode::LCD:
-                surface = TTF_RenderText_LCD(font, textToRender.data(),
-                                             textToRender.size(), fontColor,
-                                             fontBackgroundColor);
-                break;
+        textureStats.inPlaceUpdateCount++;
+    }
+
+    // Copy the surface into the top left of the texture.
+    // Note: Locked texture memory is write-only and starts out undefined, so
+    //       we clear everything outside of the surface. This also keeps
+    //       filtering from picking up old text at the edges.
+    void* pixels{nullptr};
+    int pitch{0};
+    if (!SDL_LockTexture(textTexture.get(), nullptr, &pixels, &pitch)) {
+        AUI_LOG_FATAL("Failed to lock texture: %s", SDL_GetError());
+    }
+
+    std::size_t bytesPerPixel{SDL_BYTESPERPIXEL(TEXT_TEXTURE_FORMAT)};
+    std::size_t surfaceRowBytes{surface->w * bytesPerPixel};
+    std::size_t textureRowBytes{textTexture->w * bytesPerPixel};
+    for (int y = 0; y < textTexture->h; ++y) {
+        Uint8* textureRow{static_cast<Uint8*>(pixels) + (y * pitch)};
+        std::size_t copiedBytes{0};
+        if (y < surface->h) {
+            std::memcpy(textureRow,
+                        static_cast<Uint8*>(surface->pixels)
+                            + (y * surface->pitch),
+                        surfaceRowBytes);
+            copiedBytes = surfaceRowBytes;
+        }
+        std::memset(textureRow + copiedBytes, 0,
+                    (textureRowBytes - copiedBytes));
+    }
+
+    SDL_UnlockTexture(textTexture.get());
+    SDL_DestroySurface(surface);
+}
+
+void Text::applyTextSurface(SDL_Surface* surface)
+{
+    float textureWidth{static_cast<float>(surface->w)};
+    float textureHeight{static_cast<float>(surface->h)};
+
+    if (textureSharingEnabled) {
+        // Upload the surface and add it to the cache.
+        textTexture = Core::getAssetCache().requestGeneratedTexture(
+            getSharedTextureID(), [surface] {
+                return SDL_CreateTextureFromSurface(Core::getRenderer(),
+                                                    surface);
+            });
+        SDL_DestroySurface(surface);
+        if (!textTexture) {
+            AUI_LOG_FATAL("Failed to create texture.");
         }
     }
+    else {
+        updateTextTexture(surface);
+    }
+
+    setTextureSize(textureWidth, textureHeight);
+}
+
+void Text::setTextureSize(float width, float height)
+{
+    textureExtent.w = width;
+    textureExtent.h = height;
+    textExtent = {0, 0, width, height};
+    alignmentIsDirty = true;
+}
+
+void Text::updatePendingRasterization()
+{
+    // If the job hasn't finished, keep waiting.
+    SDL_Surface* surface{nullptr};
+    if (!(Core::getAssetCache().getTextRasterizer().takeResult(
+            pendingRasterJobID, surface))) {
+        return;
+    }
+    pendingRasterJobID = 0;
+
     if (surface == nullptr) {
-        AUI_LOG_FATAL("Failed to create surface.");
+        AUI_LOG_FATAL("Failed to create surface. DebugName: %s",
+                      debugName.c_str());
     }
 
-    return surface;
+    applyTextSurface(surface);
+}
+
+void Text::cancelPendingRasterization()
+{
+    if (pendingRasterJobID != 0) {
+        Core::getAssetCache().getTextRasterizer().cancelJob(pendingRasterJobID);
+        pendingRasterJobID = 0;
+    }
+}
+
+std::string Text::getSharedTextureID() const
+{
+    // Hash everything that affects the texture's contents (font path, font
+    // size, outline size, render mode, colors, wrap width, and text).
+    // Note: The wrap width is -1 if word wrapping is disabled.
+    int wrapWidth{-1};
+    if (wordWrapEnabled) {
+        wrapWidth = static_cast<int>(
+            ScalingHelpers::logicalToActual(logicalExtent.w));
+    }
+
+    std::size_t hash{std::hash<std::string>{}(fontPath)};
+    hashCombine(hash, std::hash<float>{}(
+                          ScalingHelpers::logicalToActual(logicalFontSize)));
+    hashCombine(hash, std::hash<int>{}(ScalingHelpers::logicalToActual(
+                          logicalFontOutlineSize)));
+    hashCombine(hash, std::hash<int>{}(static_cast<int>(renderMode)));
+    for (const SDL_Color& idColor : {color, backgroundColor}) {
+        Uint32 packedColor{(Uint32{idColor.r} << 24) | (Uint32{idColor.g} << 16)
+                           | (Uint32{idColor.b} << 8) | Uint32{idColor.a}};
+        hashCombine(hash, std::hash<Uint32>{}(packedColor));
+    }
+    hashCombine(hash, std::hash<int>{}(wrapWidth));
+    hashCombine(hash, std::hash<std::string>{}(text));
+
+    // Build the ID ("AUI_Text_hash").
+    return "AUI_Text_" + std::to_string(hash);
+}
+
+void Text::refreshGlyphBatches()
+{
+    glyphBatches.clear();
+
+    // Lay out our glyphs.
+    float textWidth{0};
+    int lineCount{0};
+    std::vector<GlyphPosition> glyphPositions{
+        layoutGlyphs(textWidth, lineCount)};
+
+    // If we have an outline, add the outlined glyphs first so they're drawn
+    // behind the foreground glyphs.
+    // Note: To match the Texture backend, the foreground glyphs are offset to
+    //       center them on the outlined glyphs.
+    float actualOutlineSize{0};
+    if (logicalFontOutlineSize > 0) {
+        actualOutlineSize = static_cast<float>(
+            ScalingHelpers::logicalToActual(logicalFontOutlineSize));
+        addGlyphQuads(glyphPositions, outlinedFont.get(), {0, 0, 0, 255},
+                      {0, 0});
+    }
+
+    // Add the foreground glyphs.
+    addGlyphQuads(glyphPositions, font.get(), color,
+                  {actualOutlineSize, actualOutlineSize});
+
+    // Set our texture extent to the size of the laid out text.
+    float lineSkip{static_cast<float>(TTF_GetFontLineSkip(font.get()))};
+    float fontHeight{static_cast<float>(TTF_GetFontHeight(font.get()))};
+    textureExtent.x = 0;
+    textureExtent.y = 0;
+    textureExtent.w = textWidth + (actualOutlineSize * 2);
+    textureExtent.h
+        = ((lineCount - 1) * lineSkip) + fontHeight + (actualOutlineSize * 2);
+}
+
+std::vector<Text::GlyphPosition> Text::layoutGlyphs(float& outTextWidth,
+                                                    int& outLineCount)
+{
+    GlyphAtlas& glyphAtlas{Core::getAssetCache().getGlyphAtlas()};
+    float lineSkip{static_cast<float>(TTF_GetFontLineSkip(font.get()))};
+
+    // Note: We need to manually scale our width since it may not yet have
+    //       been updated.
+    float wrapWidth{ScalingHelpers::logicalToActual(logicalExtent.w)};
+
+    std::vector<GlyphPosition> glyphPositions{};
+    outTextWidth = 0;
+    outLineCount = 1;
+
+    // The index of the first glyph in the current line.
+    std::size_t lineStartIndex{0};
+    // The index of the glyph after the last space in the current line. If
+    // equal to lineStartIndex, there's nowhere to wrap the line.
+    std::size_t wrapIndex{0};
+
+    // Walk through each character in our text.
+    float penX{0};
+    float lineY{0};
+    Uint32 previousCodepoint{0};
+    const char* textPtr{text.c_str()};
+    std::size_t remainingBytes{text.size()};
+    while (remainingBytes > 0) {
+        Uint32 codepoint{SDL_StepUTF8(&textPtr, &remainingBytes)};
+
+        // If this is a newline, move to the next line.
+        if (codepoint == '\n') {
+            outTextWidth = std::max(outTextWidth, penX);
+            penX = 0;
+            lineY += lineSkip;
+            outLineCount++;
+            lineStartIndex = glyphPositions.size();
+            wrapIndex = lineStartIndex;
+            previousCodepoint = 0;
+            continue;
+        }
+
+        // Calc where this glyph should go.
+        const GlyphAtlas::Glyph& glyph{
+            glyphAtlas.getGlyph(font.get(), codepoint)};
+        int kerning{0};
+        if (previousCodepoint != 0) {
+            TTF_GetGlyphKerning(font.get(), previousCodepoint, codepoint,
+                                &kerning);
+        }
+        float glyphX{penX + kerning};
+
+        // If this glyph would go past our width, move the current word to
+        // the next line.
+        if (wordWrapEnabled && (codepoint != ' ')
+            && ((glyphX + glyph.advance) > wrapWidth)
+            && (wrapIndex > lineStartIndex)) {
+            float wrapX{(wrapIndex < glyphPositions.size())
+                            ? glyphPositions[wrapIndex].x
+                            : glyphX};
+            outTextWidth = std::max(outTextWidth, wrapX);
+
+            for (std::size_t i{wrapIndex}; i < glyphPositions.size(); ++i) {
+                glyphPositions[i].x -= wrapX;
+                glyphPositions[i].y += lineSkip;
+            }
+            glyphX -= wrapX;
+            lineY += lineSkip;
+            outLineCount++;
+            lineStartIndex = wrapIndex;
+        }
+
+        glyphPositions.push_back({codepoint, glyphX, lineY});
+        penX = glyphX + glyph.advance;
+
+        // If this is a space, we can wrap after it.
+        if (codepoint == ' ') {
+            wrapIndex = glyphPositions.size();
+        }
+
+        previousCodepoint = codepoint;
+    }
+    outTextWidth = std::max(outTextWidth, penX);
+
+    return glyphPositions;
+}
+
+void Text::addGlyphQuads(const std::vector<GlyphPosition>& glyphPositions,
+                         TTF_Font* glyphFont, const SDL_Color& glyphColor,
+                         const SDL_FPoint& offset)
+{
+    GlyphAtlas& glyphAtlas{Core::getAssetCache().getGlyphAtlas()};
+    SDL_FColor vertexColor{glyphColor.r / 255.f, glyphColor.g / 255.f,
+                           glyphColor.b / 255.f, glyphColor.a / 255.f};
+    constexpr float PAGE_SIZE{static_cast<float>(GlyphAtlas::PAGE_SIZE)};
+
+    // Note: We only add to batches that were created during this call, so
+    //       that each call's quads are drawn on top of the previous call's.
+    std::size_t firstBatchIndex{glyphBatches.size()};
+    for (const GlyphPosition& glyphPosition : glyphPositions) {
+        const GlyphAtlas::Glyph& glyph{
+            glyphAtlas.getGlyph(glyphFont, glyphPosition.codepoint)};
+        if (glyph.page == nullptr) {
+            // No image (e.g. a space).
+            continue;
+        }
+
+        // Find the batch for this glyph's page.
+        auto batchIt{std::find_if(glyphBatches.begin() + firstBatchIndex,
+                                  glyphBatches.end(),
+                                  [&](const GlyphBatch& batch) {
+                                      return (batch.page == glyph.page);
+                                  })};
+        if (batchIt == glyphBatches.end()) {
+            glyphBatches.push_back({glyph.page, {}, {}});
+            batchIt = (glyphBatches.end() - 1);
+        }
+
+        // Add the glyph's quad.
+        const SDL_FRect& tex{glyph.texExtent};
+        float left{offset.x + glyphPosition.x + glyph.xOffset};
+        float top{offset.y + glyphPosition.y};
+        float right{left + tex.w};
+        float bottom{top + tex.h};
+        float texLeft{tex.x / PAGE_SIZE};
+        float texTop{tex.y / PAGE_SIZE};
+        float texRight{(tex.x + tex.w) / PAGE_SIZE};
+        float texBottom{(tex.y + tex.h) / PAGE_SIZE};
+
+        int firstVertex{static_cast<int>(batchIt->vertices.size())};
+        batchIt->vertices.push_back(
+            {{left, top}, vertexColor, {texLeft, texTop}});
+        batchIt->vertices.push_back(
+            {{right, top}, vertexColor, {texRight, texTop}});
+        batchIt->vertices.push_back(
+            {{right, bottom}, vertexColor, {texRight, texBottom}});
+        batchIt->vertices.push_back(
+            {{left, bottom}, vertexColor, {texLeft, texBottom}});
+        for (int index : {0, 1, 2, 0, 2, 3}) {
+            batchIt->indices.push_back(firstVertex + index);
+        }
+    }
+}
+
+void Text::renderGlyphBatches(const SDL_FPoint& windowTopLeft)
+{
+    // If our text is fully clipped, don't render it.
+    if (SDL_RectEmptyFloat(&offsetClippedTextExtent)) {
+        return;
+    }
+
+    // Clip the glyphs to our clipped text extent.
+    // Note: The command list will respect any clip rect that's already set.
+    SDL_FRect finalExtent{offsetClippedTextExtent};
+    finalExtent.x += windowTopLeft.x;
+    finalExtent.y += windowTopLeft.y;
+    int clipLeft{static_cast<int>(std::lround(finalExtent.x))};
+    int clipTop{static_cast<int>(std::lround(finalExtent.y))};
+    SDL_Rect clipRect{
+        clipLeft, clipTop,
+        static_cast<int>(std::lround(finalExtent.x + finalExtent.w)) - clipLeft,
+        static_cast<int>(std::lround(finalExtent.y + finalExtent.h)) - clipTop};
+
+    // Our vertices are relative to the top left of the text, offset them to
+    // the text's final position.
+    // Note: offsetClippedTextureExtent holds how far the clipped extent is
+    //       from the text's top left.
+    float textX{finalExtent.x - offsetClippedTextureExtent.x};
+    float textY{finalExtent.y - offsetClippedTextureExtent.y};
+    for (const GlyphBatch& batch : glyphBatches) {
+        Core::getRenderCommandList().addGeometry(batch.page, batch.vertices,
+                                                 batch.indices, {textX, textY},
+                                                 &clipRect);
+    }
+}
+
+void Text::refreshCharacterOffsets()
+{
+    characterOffsets.assign((text.size() + 1), 0);
+    if (!font) {
+        lineHeight = 0;
+        return;
+    }
+    lineHeight = static_cast<float>(TTF_GetFontHeight(font.get()));
+
+    // Walk through each character in our text, accumulating its advance.
+    float penX{0};
+    Uint32 previousCodepoint{0};
+    const char* textPtr{text.c_str()};
+    std::size_t remainingBytes{text.size()};
+    while (remainingBytes > 0) {
+        std::size_t charIndex{text.size() - remainingBytes};
+        Uint32 codepoint{SDL_StepUTF8(&textPtr, &remainingBytes)};
+        std::size_t nextCharIndex{text.size() - remainingBytes};
+
+        int kerning{0};
+        if (previousCodepoint != 0) {
+            TTF_GetGlyphKerning(font.get(), previousCodepoint, codepoint,
+                                &kerning);
+        }
+        int advance{0};
+        TTF_GetGlyphMetrics(font.get(), codepoint, nullptr, nullptr, nullptr,
+                            nullptr, &advance);
+
+        // Any continuation bytes within this character share its offset.
+        for (std::size_t i{charIndex + 1}; i < nextCharIndex; ++i) {
+            characterOffsets[i] = characterOffsets[charIndex];
+        }
+
+        penX += static_cast<float>(kerning + advance);
+        characterOffsets[nextCharIndex] = penX;
+        previousCodepoint = codepoint;
+    }
+
+    characterOffsetsAreDirty = false;
 }
 
 } // namespace AUI
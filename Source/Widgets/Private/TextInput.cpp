@@ -4,6 +4,7 @@
 #include "AUI/ScalingHelpers.h"
 #include "AUI/SDLHelpers.h"
 #include <cstring>
+#include <algorithm>
 
 namespace AUI
 {
@@ -38,6 +39,7 @@ TextInput::TextInput(const SDL_FRect& inLogicalExtent,
 , logicalCursorWidth{2}
 , scaledCursorWidth{ScalingHelpers::logicalToActual(logicalCursorWidth)}
 , cursorIndex{0}
+, clickedCursorIndex{}
 , cursorIsVisible{false}
 , isTextScrollOffsetDirty{false}
 , lastCommittedText{""}
@@ -96,6 +98,7 @@ void TextInput::disable()
 
     // Refresh the text position to account for the change.
     isTextScrollOffsetDirty = true;
+    invalidateMeasure();
 }
 
 void TextInput::setPadding(Padding inLogicalPadding)
@@ -109,17 +112,20 @@ void TextInput::setPadding(Padding inLogicalPadding)
 
     // Refresh the text position to account for the change.
     isTextScrollOffsetDirty = true;
+    invalidateMeasure();
 }
 
 void TextInput::setCursorColor(const SDL_Color& inCursorColor)
 {
     cursorColor = inCursorColor;
+    invalidateRender();
 }
 
 void TextInput::setCursorWidth(float inCursorWidth)
 {
     logicalCursorWidth = inCursorWidth;
     scaledCursorWidth = ScalingHelpers::logicalToActual(logicalCursorWidth);
+    invalidateRender();
 }
 
 TextInput::State TextInput::getCurrentState()
@@ -148,6 +154,7 @@ void TextInput::setText(std::string_view inText)
 
     // Refresh the text position to account for the change.
     isTextScrollOffsetDirty = true;
+    invalidateMeasure();
 }
 
 const std::string& TextInput::getText()
@@ -176,6 +183,12 @@ void TextInput::setTextColor(const SDL_Color& inColor)
     }
 }
 
+void TextInput::setTextAsyncRasterizationEnabled(
+    bool inAsyncRasterizationEnabled)
+{
+    text.setAsyncRasterizationEnabled(inAsyncRasterizationEnabled);
+}
+
 void TextInput::setHintText(std::string_view inHintText)
 {
     hintText = inHintText;
@@ -220,7 +233,7 @@ void TextInput::setOnTextCommitted(std::function<void(void)> inOnTextCommitted)
 }
 
 EventResult TextInput::onMouseDown(MouseButtonType buttonType,
-                                   const SDL_FPoint&)
+                                   const SDL_FPoint& cursorPosition)
 {
     // Only respond to the left mouse button.
     if (buttonType != MouseButtonType::Left) {
@@ -231,6 +244,27 @@ EventResult TextInput::onMouseDown(MouseButtonType buttonType,
         return EventResult{.wasHandled{false}};
     }
 
+    // Find the character that was clicked on.
+    // Note: If hint text is active, there's no user text to click on.
+    if (!hintTextActive) {
+        // Note: Character offsets are relative to our extent.
+        std::size_t clickedIndex{
+            text.calcCharacterIndex(cursorPosition.x - fullExtent.x)};
+
+        // If we're already focused, move the cursor to the clicked character.
+        // Else, onFocusGained() will be called after this and will use it.
+        if (currentState == State::Focused) {
+            cursorIndex = clickedIndex;
+            cursorIsVisible = true;
+            accumulatedBlinkTime = 0;
+            isTextScrollOffsetDirty = true;
+            invalidateMeasure();
+        }
+        else {
+            clickedCursorIndex = clickedIndex;
+        }
+    }
+
     // Note: Since we're handling a MouseDown, we'll be given focus.
     return EventResult{.wasHandled{true}};
 }
@@ -287,11 +321,17 @@ EventResult TextInput::onFocusGained()
     cursorIsVisible = true;
     accumulatedBlinkTime = 0;
 
-    // Move the cursor to the end.
+    // If we were clicked on, move the cursor to the clicked character. Else,
+    // move it to the end.
     cursorIndex = text.asString().length();
+    if (clickedCursorIndex) {
+        cursorIndex = std::min(*clickedCursorIndex, cursorIndex);
+        clickedCursorIndex.reset();
+    }
 
     // Refresh the text position to account for the change.
     isTextScrollOffsetDirty = true;
+    invalidateMeasure();
 
     return EventResult{.wasHandled{true}};
 }
@@ -311,6 +351,7 @@ void TextInput::onFocusLost(FocusLostType focusLostType)
 
     // Reset the text cursor's state.
     cursorIsVisible = false;
+    invalidateRender();
 
     // If we lost focus because of an Escape key press, revert to the last
     // committed text state.
@@ -333,6 +374,7 @@ void TextInput::onFocusLost(FocusLostType focusLostType)
 
         // Refresh the text position to account for the change.
         isTextScrollOffsetDirty = true;
+        invalidateMeasure();
 
         // If a callback is registered, signal that the text was committed.
         if (onTextCommitted) {
@@ -419,6 +461,7 @@ EventResult TextInput::onTextInput(const std::string& inputText)
 
     // Refresh the text position to account for the change.
     isTextScrollOffsetDirty = true;
+    invalidateMeasure();
 
     // Make the cursor visible and reset the blink time so it stays solid
     // while interacting.
@@ -446,6 +489,7 @@ void TextInput::onTick(double timestepS)
             }
 
             accumulatedBlinkTime -= CURSOR_BLINK_RATE_S;
+            invalidateRender();
         }
     }
 
@@ -471,8 +515,8 @@ void TextInput::measure(const SDL_FRect& availableExtent)
 
 void TextInput::render(const SDL_FPoint& windowTopLeft)
 {
-    // If this widget is fully clipped, don't render it.
-    if (SDL_RectEmptyFloat(&clippedExtent)) {
+    // If this widget is fully clipped or culled, don't render it.
+    if (isRenderCulled(windowTopLeft)) {
         return;
     }
 
@@ -499,6 +543,7 @@ EventResult TextInput::handleBackspaceEvent()
 
         // Refresh the text position to account for the change.
         isTextScrollOffsetDirty = true;
+        invalidateMeasure();
 
         // If a callback is registered, signal that the text was changed.
         if (onTextChanged) {
@@ -520,6 +565,7 @@ EventResult TextInput::handleDeleteEvent()
 
         // Refresh the text position to account for the change.
         isTextScrollOffsetDirty = true;
+        invalidateMeasure();
 
         // If a callback is registered, signal that the the text was changed.
         if (onTextChanged) {
@@ -563,6 +609,7 @@ EventResult TextInput::handleCutEvent()
 
             // Refresh the text position to account for the change.
             isTextScrollOffsetDirty = true;
+            invalidateMeasure();
 
             // If a callback is registered, signal that the the text was
             // changed.
@@ -592,6 +639,7 @@ EventResult TextInput::handlePasteEvent()
 
             // Refresh the text position to account for the change.
             isTextScrollOffsetDirty = true;
+            invalidateMeasure();
 
             // If a callback is registered, signal that the the text was
             // changed.
@@ -612,12 +660,14 @@ EventResult TextInput::handleLeftEvent()
 
         // Refresh the text position to account for the change.
         isTextScrollOffsetDirty = true;
+        invalidateMeasure();
     }
 
     // Make the cursor visible and reset the blink time so it stays
     // solid while interacting.
     cursorIsVisible = true;
     accumulatedBlinkTime = 0;
+    invalidateRender();
 
     return EventResult{.wasHandled{true}};
 }
@@ -630,12 +680,14 @@ EventResult TextInput::handleRightEvent()
 
         // Refresh the text position to account for the change.
         isTextScrollOffsetDirty = true;
+        invalidateMeasure();
     }
 
     // Make the cursor visible and reset the blink time so it stays
     // solid while interacting.
     cursorIsVisible = true;
     accumulatedBlinkTime = 0;
+    invalidateRender();
 
     return EventResult{.wasHandled{true}};
 }
@@ -647,6 +699,7 @@ EventResult TextInput::handleHomeEvent()
 
     // Refresh the text position to account for the change.
     isTextScrollOffsetDirty = true;
+    invalidateMeasure();
 
     return EventResult{.wasHandled{true}};
 }
@@ -658,6 +711,7 @@ EventResult TextInput::handleEndEvent()
 
     // Refresh the text position to account for the change.
     isTextScrollOffsetDirty = true;
+    invalidateMeasure();
 
     return EventResult{.wasHandled{true}};
 }
@@ -763,12 +817,6 @@ void TextInput::refreshTextScrollOffset()
 
 void TextInput::renderTextCursor(const SDL_FPoint& windowTopLeft)
 {
-    // Save the current draw color to re-apply later.
-    SDL_Color originalColor{};
-    SDL_GetRenderDrawColor(Core::getRenderer(), &originalColor.r,
-                           &originalColor.g, &originalColor.b,
-                           &originalColor.a);
-
     // Calc where the cursor should be.
     SDL_FRect cursorOffsetExtent{text.calcCharacterOffset(cursorIndex)};
     cursorOffsetExtent.x += clippedExtent.x + windowTopLeft.x;
@@ -776,14 +824,8 @@ void TextInput::renderTextCursor(const SDL_FPoint& windowTopLeft)
     cursorOffsetExtent.w = scaledCursorWidth;
 
     // Draw the cursor.
-    SDL_SetRenderDrawColor(Core::getRenderer(), cursorColor.r, cursorColor.g,
-                           cursorColor.b, cursorColor.a);
-
-    SDL_RenderFillRect(Core::getRenderer(), &cursorOffsetExtent);
-
-    // Re-apply the original draw color.
-    SDL_SetRenderDrawColor(Core::getRenderer(), originalColor.r,
-                           originalColor.g, originalColor.b, originalColor.a);
+    Core::getRenderCommandList().addFilledRect(cursorOffsetExtent,
+                                               cursorColor);
 }
 
 } // namespace AUI
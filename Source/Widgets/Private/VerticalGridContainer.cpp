@@ -1,9 +1,11 @@
 #include "AUI/VerticalGridContainer.h"
+#include "AUI/Core.h"
 #include "AUI/ScalingHelpers.h"
 #include "AUI/WidgetLocator.h"
 #include "AUI/Internal/Log.h"
 #include "AUI/SDLHelpers.h"
 #include <cmath>
+#include <algorithm>
 
 namespace AUI
 {
@@ -17,24 +19,31 @@ VerticalGridContainer::VerticalGridContainer(const SDL_FRect& inLogicalExtent,
 , scaledCellHeight{ScalingHelpers::logicalToActual(logicalCellHeight)}
 , rowScroll{0}
 , isScrollingEnabled{true}
+, firstArrangedIndex{0}
+, lastArrangedIndex{0}
+, lastUsedScreenSize{0, 0}
+, lastUsedLogicalExtent{0, 0, 0, 0}
 {
 }
 
 void VerticalGridContainer::setNumColumns(unsigned int inNumColumns)
 {
     numColumns = inNumColumns;
+    invalidateMeasure();
 }
 
 void VerticalGridContainer::setCellWidth(float inLogicalCellWidth)
 {
     logicalCellWidth = inLogicalCellWidth;
     scaledCellWidth = ScalingHelpers::logicalToActual(logicalCellWidth);
+    invalidateMeasure();
 }
 
 void VerticalGridContainer::setCellHeight(float inLogicalCellHeight)
 {
     logicalCellHeight = inLogicalCellHeight;
     scaledCellHeight = ScalingHelpers::logicalToActual(logicalCellHeight);
+    invalidateMeasure();
 }
 
 void VerticalGridContainer::setScrollingEnabled(bool isEnabled)
@@ -69,11 +78,33 @@ void VerticalGridContainer::measure(const SDL_FRect& availableExtent)
     scaledCellWidth = ScalingHelpers::logicalToActual(logicalCellWidth);
     scaledCellHeight = ScalingHelpers::logicalToActual(logicalCellHeight);
 
-    // Give our elements a chance to update their logical extent.
-    for (auto& element : elements) {
-        // Note: We measure/arrange all elements, even if they're invisible,
-        //       so we can get the rest of the elements offsets correct.
-        element->measure(logicalExtent);
+    // If we're recycling, make sure we have enough widgets to fill our
+    // visible rows.
+    if (isRecycling) {
+        reserveItemWidgets(calcVisibleCellCount());
+    }
+
+    // If the UI scaling or our extent changed, all of our elements need to be
+    // re-measured.
+    if ((lastUsedScreenSize != Core::getActualScreenSize())
+        || !SDL_RectsEqualFloat(&lastUsedLogicalExtent, &logicalExtent)) {
+        for (auto& element : elements) {
+            element->measure(logicalExtent);
+        }
+
+        lastUsedScreenSize = Core::getActualScreenSize();
+        lastUsedLogicalExtent = logicalExtent;
+    }
+
+    // Give the elements in our visible rows a chance to update their logical
+    // extent. Offscreen elements will be measured when they're scrolled into
+    // view (during arrange()).
+    auto [firstIndex, lastIndex] = calcVisibleElementRange();
+    for (std::size_t i{firstIndex}; i < lastIndex; ++i) {
+        Widget& element{getItemWidget(i)};
+        if (element.getIsMeasureDirty()) {
+            element.measure(logicalExtent);
+        }
     }
 }
 
@@ -91,7 +122,16 @@ void VerticalGridContainer::arrange(const SDL_FPoint& startPosition,
     }
 
     // Lay out our elements in a vertical grid.
-    for (std::size_t i = 0; i < elements.size(); ++i) {
+    // Note: Only the elements in our visible rows are arranged. Offscreen
+    //       elements are left out of the locator and aren't rendered.
+    auto [firstIndex, lastIndex] = calcVisibleElementRange();
+    for (std::size_t i{firstIndex}; i < lastIndex; ++i) {
+        // If this element was invalidated while it was offscreen, measure it.
+        Widget& element{getItemWidget(i)};
+        if (element.getIsMeasureDirty()) {
+            element.measure(logicalExtent);
+        }
+
         // Get the cell coordinates for this element.
         std::size_t cellColumn{i % numColumns};
         std::size_t cellRow{i / numColumns};
@@ -106,15 +146,65 @@ void VerticalGridContainer::arrange(const SDL_FPoint& startPosition,
         // Add this widget's offset to get our final offset.
         float finalX{fullExtent.x + cellXOffset};
         float finalY{fullExtent.y + cellYOffset};
-        elements[i]->arrange({finalX, finalY}, clippedExtent, widgetLocator);
+        element.arrange({finalX, finalY}, clippedExtent, widgetLocator);
+    }
+
+    firstArrangedIndex = firstIndex;
+    lastArrangedIndex = lastIndex;
+}
+
+void VerticalGridContainer::render(const SDL_FPoint& windowTopLeft)
+{
+    // If this widget is fully clipped or culled, don't render it.
+    if (isRenderCulled(windowTopLeft)) {
+        return;
     }
+
+    // Render our children.
+    Widget::render(windowTopLeft);
+
+    // Render the visible elements that were last arranged.
+    // Note: Elements outside of this range may have stale extents.
+    lastArrangedIndex = std::min(lastArrangedIndex, getItemCount());
+    for (std::size_t i{firstArrangedIndex}; i < lastArrangedIndex; ++i) {
+        Widget& element{getItemWidget(i)};
+        if (element.getIsVisible()) {
+            element.render(windowTopLeft);
+        }
+    }
+}
+
+std::pair<std::size_t, std::size_t>
+    VerticalGridContainer::calcVisibleElementRange()
+{
+    // Rows are filled across the columns, so each visible row holds a
+    // contiguous range of elements.
+    std::size_t firstIndex{rowScroll * static_cast<std::size_t>(numColumns)};
+    std::size_t lastIndex{firstIndex + calcVisibleCellCount()};
+
+    return {std::min(firstIndex, getItemCount()),
+            std::min(lastIndex, getItemCount())};
+}
+
+std::size_t VerticalGridContainer::calcVisibleCellCount()
+{
+    // If our cells or extent have no size, nothing is visible.
+    if ((scaledCellHeight <= 0) || (scaledExtent.h <= 0)) {
+        return 0;
+    }
+
+    // Calc how many rows fit within our extent, including a partial row.
+    std::size_t visibleRows{static_cast<std::size_t>(
+        std::ceil(scaledExtent.h / scaledCellHeight))};
+
+    return (visibleRows * numColumns);
 }
 
 void VerticalGridContainer::scrollElements(bool scrollUp)
 {
     // Calc how many rows are currently present.
     int currentRows{static_cast<int>(
-        std::ceil(elements.size() / static_cast<float>(numColumns)))};
+        std::ceil(getItemCount() / static_cast<float>(numColumns)))};
 
     // Calc how many rows can fit onscreen at once.
     int maxVisibleRows{static_cast<int>(logicalExtent.h / logicalCellHeight)};
@@ -123,6 +213,7 @@ void VerticalGridContainer::scrollElements(bool scrollUp)
     if (scrollUp && (rowScroll > 0)) {
         // Scroll up 1 row.
         rowScroll--;
+        invalidateArrange();
     }
     else if (!scrollUp) {
         // Else if we're being asked to scroll down, calculate if there are
@@ -133,8 +224,15 @@ void VerticalGridContainer::scrollElements(bool scrollUp)
         // If there are any elements offscreen below, scroll down 1 row.
         if (rowsBelow > 0) {
             rowScroll++;
+            invalidateArrange();
         }
     }
+
+    // Bind any items that were scrolled into view now, so that any
+    // invalidation caused by the binder is handled in the upcoming layout
+    // pass.
+    auto [firstIndex, lastIndex] = calcVisibleElementRange();
+    bindItemWidgets(firstIndex, lastIndex);
 }
 
 } // namespace AUI
@@ -1,7 +1,9 @@
 #include "AUI/VerticalListContainer.h"
+#include "AUI/Core.h"
 #include "AUI/ScalingHelpers.h"
 #include "AUI/WidgetLocator.h"
 #include "AUI/Internal/Log.h"
+#include "AUI/Internal/AUIAssert.h"
 #include <cmath>
 #include "AUI/SDLHelpers.h"
 #include <algorithm>
@@ -17,6 +19,16 @@ VerticalListContainer::VerticalListContainer(const SDL_FRect& inLogicalExtent,
 , scaledGapSize{0}
 , flowDirection{FlowDirection::TopToBottom}
 , scrollDistance{0}
+, isVirtualized{false}
+, logicalItemHeight{0}
+, scaledItemHeight{0}
+, elementHeights{}
+, elementOffsets{0}
+, firstDirtyOffsetIndex{0}
+, firstArrangedIndex{0}
+, lastArrangedIndex{0}
+, lastUsedScreenSize{0, 0}
+, lastUsedLogicalWidth{0}
 {
 }
 
@@ -24,6 +36,10 @@ void VerticalListContainer::setGapSize(float inLogicalGapSize)
 {
     logicalGapSize = inLogicalGapSize;
     scaledGapSize = ScalingHelpers::logicalToActual(logicalGapSize);
+
+    // All of our element offsets include the gap size.
+    firstDirtyOffsetIndex = 0;
+    invalidateMeasure();
 }
 
 void VerticalListContainer::setScrollHeight(float inLogicalScrollHeight)
@@ -38,6 +54,62 @@ void VerticalListContainer::setFlowDirection(FlowDirection inFlowDirection)
 
     // Reset the scroll distance since it's going in the other direction now.
     scrollDistance = 0;
+    invalidateArrange();
+}
+
+void VerticalListContainer::setIsVirtualized(bool inIsVirtualized)
+{
+    AUI_ASSERT(!isRecycling || inIsVirtualized,
+               "Tried to disable virtualization while recycling items.");
+    isVirtualized = inIsVirtualized;
+
+    // Reset our cached element data. If we're now virtualized, every element
+    // will be measured during the next measure pass.
+    elementHeights.assign((isVirtualized ? getItemCount() : 0),
+                          UNMEASURED_HEIGHT);
+    elementOffsets.assign((elementHeights.size() + 1), 0);
+    firstDirtyOffsetIndex = 0;
+    firstArrangedIndex = 0;
+    lastArrangedIndex = 0;
+
+    invalidateMeasure();
+}
+
+void VerticalListContainer::setRecycledItems(std::size_t inItemCount,
+                                             float inLogicalItemHeight,
+                                             ItemFactory inItemFactory,
+                                             ItemBinder inItemBinder)
+{
+    AUI_ASSERT(inLogicalItemHeight > 0,
+               "Tried to recycle items without a valid item height.");
+    Container::setRecycledItems(inItemCount, std::move(inItemFactory),
+                                std::move(inItemBinder));
+
+    logicalItemHeight = inLogicalItemHeight;
+    scaledItemHeight = ScalingHelpers::logicalToActual(logicalItemHeight);
+
+    // Track each item's offset. Every item will start at scaledItemHeight
+    // during the next measure pass.
+    setIsVirtualized(true);
+}
+
+void VerticalListContainer::setItemCount(std::size_t inItemCount)
+{
+    AUI_ASSERT(isRecycling,
+               "Tried to set the item count while not recycling items.");
+    Container::setItemCount(inItemCount);
+
+    // Add or remove entries to match. New items will start at
+    // scaledItemHeight during the next measure pass.
+    std::size_t oldItemCount{elementHeights.size()};
+    elementHeights.resize(inItemCount, UNMEASURED_HEIGHT);
+    elementOffsets.resize((inItemCount + 1), 0);
+    firstDirtyOffsetIndex
+        = std::min({firstDirtyOffsetIndex, oldItemCount, inItemCount});
+
+    // Our arranged range may no longer be accurate.
+    firstArrangedIndex = 0;
+    lastArrangedIndex = 0;
 }
 
 EventResult VerticalListContainer::onMouseWheel(float amountScrolled)
@@ -65,26 +137,69 @@ EventResult VerticalListContainer::onMouseWheel(float amountScrolled)
 
     // Clamp the scroll distance so we don't go too far.
     scrollDistance = std::clamp(scrollDistance, 0.f, maxScrollDistance);
+    invalidateArrange();
+
+    // If we're recycling, bind any items that were scrolled into view now,
+    // so that any invalidation caused by the binder is handled in the
+    // upcoming layout pass.
+    if (isRecycling) {
+        auto [firstIndex, lastIndex] = calcVisibleElementRange();
+        reserveItemWidgets(lastIndex - firstIndex);
+        bindItemWidgets(firstIndex, lastIndex);
+    }
 
     return EventResult{.wasHandled{true}};
 }
 
+void VerticalListContainer::onTick(double timestepS)
+{
+    // If we aren't virtualized, tick all of our elements.
+    if (!isVirtualized) {
+        Container::onTick(timestepS);
+        return;
+    }
+
+    // Call every visible child's onTick().
+    Widget::onTick(timestepS);
+
+    // Call onTick() for the visible elements that were last arranged.
+    for (std::size_t i{firstArrangedIndex}; i < lastArrangedIndex; ++i) {
+        Widget& element{getItemWidget(i)};
+        if (element.getIsVisible()) {
+            element.onTick(timestepS);
+        }
+    }
+}
+
 void VerticalListContainer::measure(const SDL_FRect& availableExtent)
 {
     // Run the normal measure step (sets our scaledExtent).
     Widget::measure(availableExtent);
 
-    // Give our elements a chance to update their logical extent.
-    for (auto& element : elements) {
-        // Note: We measure/arrange all elements, even if they're invisible,
-        //       so we can get the rest of the elements offsets correct.
-        element->measure(logicalExtent);
-    }
-
     // Refresh the scroll height and gap size.
     scaledScrollHeight = ScalingHelpers::logicalToActual(logicalScrollHeight);
     scaledGapSize = ScalingHelpers::logicalToActual(logicalGapSize);
 
+    // If we're recycling, make sure we have enough widgets to fill our
+    // viewport.
+    if (isRecycling) {
+        scaledItemHeight = ScalingHelpers::logicalToActual(logicalItemHeight);
+        reserveItemWidgets(calcRecycledWidgetCount());
+    }
+
+    // Give our elements a chance to update their logical extent.
+    if (isVirtualized) {
+        measureVirtualizedElements();
+    }
+    else {
+        for (auto& element : elements) {
+            // Note: We measure/arrange all elements, even if they're
+            //       invisible, so we can get the rest of the elements offsets
+            //       correct.
+            element->measure(logicalExtent);
+        }
+    }
+
     // If our content changed and is now shorter than this widget, reset the
     // scroll distance.
     float contentHeight{calcContentHeight()};
@@ -113,7 +228,10 @@ void VerticalListContainer::arrange(const SDL_FPoint& startPosition,
     }
 
     // Lay out our elements in the appropriate direction.
-    if (flowDirection == FlowDirection::TopToBottom) {
+    if (isVirtualized) {
+        arrangeVirtualizedElements(widgetLocator);
+    }
+    else if (flowDirection == FlowDirection::TopToBottom) {
         arrangeElementsTopToBottom(widgetLocator);
     }
     else {
@@ -121,8 +239,99 @@ void VerticalListContainer::arrange(const SDL_FPoint& startPosition,
     }
 }
 
+void VerticalListContainer::render(const SDL_FPoint& windowTopLeft)
+{
+    // If we aren't virtualized, render all of our elements.
+    if (!isVirtualized) {
+        Container::render(windowTopLeft);
+        return;
+    }
+
+    // If this widget is fully clipped or culled, don't render it.
+    if (isRenderCulled(windowTopLeft)) {
+        return;
+    }
+
+    // Render our children.
+    Widget::render(windowTopLeft);
+
+    // Render the visible elements that were last arranged.
+    // Note: Elements outside of this range may have stale extents.
+    for (std::size_t i{firstArrangedIndex}; i < lastArrangedIndex; ++i) {
+        Widget& element{getItemWidget(i)};
+        if (element.getIsVisible()) {
+            element.render(windowTopLeft);
+        }
+    }
+}
+
+void VerticalListContainer::onElementsInserted(std::size_t index,
+                                               std::size_t count)
+{
+    if (!isVirtualized) {
+        return;
+    }
+
+    // Add entries for the new elements. They'll be measured during the next
+    // measure pass.
+    elementHeights.insert(elementHeights.begin() + index, count,
+                          UNMEASURED_HEIGHT);
+    elementOffsets.insert(elementOffsets.begin() + index + 1, count, 0);
+    firstDirtyOffsetIndex = std::min(firstDirtyOffsetIndex, index);
+
+    // Our arranged range is no longer accurate.
+    firstArrangedIndex = 0;
+    lastArrangedIndex = 0;
+}
+
+void VerticalListContainer::onElementsErased(std::size_t index,
+                                             std::size_t count)
+{
+    if (!isVirtualized) {
+        return;
+    }
+
+    // If we were cleared, reset our entries.
+    // Note: If we were recycling, our entries were for items instead of
+    //       elements, so we can't just erase the erased elements' entries.
+    if (elements.empty()) {
+        elementHeights.clear();
+        elementOffsets.assign(1, 0);
+        firstDirtyOffsetIndex = 0;
+        firstArrangedIndex = 0;
+        lastArrangedIndex = 0;
+        return;
+    }
+
+    // Remove the erased elements' entries.
+    elementHeights.erase(elementHeights.begin() + index,
+                         elementHeights.begin() + index + count);
+    elementOffsets.erase(elementOffsets.begin() + index + 1,
+                         elementOffsets.begin() + index + 1 + count);
+    firstDirtyOffsetIndex = std::min(firstDirtyOffsetIndex, index);
+
+    // Our arranged range is no longer accurate.
+    firstArrangedIndex = 0;
+    lastArrangedIndex = 0;
+}
+
 float VerticalListContainer::calcContentHeight()
 {
+    // If we're virtualized, our offsets already hold the content height.
+    // Note: elementOffsets has 1 more entry than elements (or items).
+    if (isVirtualized) {
+        refreshElementOffsets();
+        if (elementOffsets.size() <= 1) {
+            return 0;
+        }
+        return (elementOffsets.back() - scaledGapSize);
+    }
+
+    // If we have no elements, there's no gap to subtract.
+    if (elements.empty()) {
+        return 0;
+    }
+
     // Calc the content height by summing our element's heights and adding the
     // gaps.
     float contentHeight{0};
@@ -190,4 +399,191 @@ void VerticalListContainer::arrangeElementsBottomToTop(
     }
 }
 
+void VerticalListContainer::measureVirtualizedElements()
+{
+    // If the UI scaling or our width changed, all of our elements need to be
+    // re-measured.
+    bool remeasureAll{false};
+    if ((lastUsedScreenSize != Core::getActualScreenSize())
+        || (lastUsedLogicalWidth != logicalExtent.w)) {
+        std::fill(elementHeights.begin(), elementHeights.end(),
+                  UNMEASURED_HEIGHT);
+        firstDirtyOffsetIndex = 0;
+        remeasureAll = true;
+        lastUsedScreenSize = Core::getActualScreenSize();
+        lastUsedLogicalWidth = logicalExtent.w;
+    }
+
+    // Measure any elements that haven't been measured yet.
+    // Note: Unmeasured elements are always at or after firstDirtyOffsetIndex,
+    //       so we don't need to check the whole list.
+    // Note: We measure all elements, even if they're invisible, so we can
+    //       get the rest of the elements offsets correct.
+    // Note: If we're recycling, we can't measure offscreen items (they don't
+    //       have a widget), so we use the given item height instead.
+    for (std::size_t i{firstDirtyOffsetIndex}; i < elementHeights.size();
+         ++i) {
+        if (elementHeights[i] != UNMEASURED_HEIGHT) {
+            continue;
+        }
+
+        if (isRecycling) {
+            elementHeights[i] = scaledItemHeight;
+        }
+        else {
+            measureElement(i);
+        }
+    }
+    refreshElementOffsets();
+
+    // If we're recycling and need to re-measure everything, our bound items
+    // were just given estimated heights. Invalidate their widgets, so
+    // they'll be measured for real once they're visible.
+    if (isRecycling && remeasureAll) {
+        runWithoutInvalidatingAncestors([&]() {
+            for (std::unique_ptr<Widget>& element : elements) {
+                element->invalidateMeasure();
+            }
+        });
+    }
+
+    // Re-measure any visible elements that have changed.
+    measureDirtyVisibleElements();
+}
+
+void VerticalListContainer::measureDirtyVisibleElements()
+{
+    // Note: If we're recycling, the visible items may have only had an
+    //       estimated height. Measuring them can change which items are
+    //       visible, so we repeat until the visible range settles (growing
+    //       the pool if more widgets are needed).
+    std::pair<std::size_t, std::size_t> visibleRange{
+        calcVisibleElementRange()};
+    while (true) {
+        auto [firstIndex, lastIndex] = visibleRange;
+        reserveItemWidgets(lastIndex - firstIndex);
+        for (std::size_t i{firstIndex}; i < lastIndex; ++i) {
+            if (getItemWidget(i).getIsMeasureDirty()) {
+                measureElement(i);
+            }
+        }
+
+        refreshElementOffsets();
+
+        std::pair<std::size_t, std::size_t> newVisibleRange{
+            calcVisibleElementRange()};
+        if (!isRecycling || (newVisibleRange == visibleRange)) {
+            break;
+        }
+        visibleRange = newVisibleRange;
+    }
+}
+
+void VerticalListContainer::measureElement(std::size_t index)
+{
+    Widget& element{getItemWidget(index)};
+    element.measure(logicalExtent);
+
+    // If the element's height changed, its following offsets are dirty.
+    float newHeight{element.getScaledExtent().h};
+    if (newHeight != elementHeights[index]) {
+        elementHeights[index] = newHeight;
+        firstDirtyOffsetIndex = std::min(firstDirtyOffsetIndex, index);
+    }
+}
+
+void VerticalListContainer::refreshElementOffsets()
+{
+    // Each element's offset is the previous element's offset, plus its height
+    // and a gap.
+    for (std::size_t i{firstDirtyOffsetIndex}; i < elementHeights.size();
+         ++i) {
+        elementOffsets[i + 1]
+            = elementOffsets[i] + elementHeights[i] + scaledGapSize;
+    }
+
+    firstDirtyOffsetIndex = elementHeights.size();
+}
+
+std::pair<std::size_t, std::size_t>
+    VerticalListContainer::calcVisibleElementRange()
+{
+    // Calc the part of our content that's within our viewport.
+    // Note: Since offsets are measured from the start of the content in the
+    //       flow direction, this is the same for both directions.
+    float viewportStart{scrollDistance};
+    float viewportEnd{scrollDistance + scaledExtent.h};
+
+    // Find the first element that ends after the viewport start, and the
+    // first element that starts at or after the viewport end.
+    auto offsetsEnd{elementOffsets.end() - 1};
+    auto firstIt{std::upper_bound(elementOffsets.begin(), offsetsEnd,
+                                  viewportStart)};
+    auto lastIt{
+        std::lower_bound(elementOffsets.begin(), offsetsEnd, viewportEnd)};
+    std::size_t firstIndex{static_cast<std::size_t>(
+        std::max<std::ptrdiff_t>((firstIt - elementOffsets.begin()) - 1, 0))};
+    std::size_t lastIndex{
+        static_cast<std::size_t>(lastIt - elementOffsets.begin())};
+
+    // Add the overscan.
+    firstIndex = (firstIndex > VIRTUALIZATION_OVERSCAN_COUNT)
+                     ? (firstIndex - VIRTUALIZATION_OVERSCAN_COUNT)
+                     : 0;
+    lastIndex = std::min((lastIndex + VIRTUALIZATION_OVERSCAN_COUNT),
+                         getItemCount());
+
+    return {firstIndex, lastIndex};
+}
+
+std::size_t VerticalListContainer::calcRecycledWidgetCount()
+{
+    // Note: setRecycledItems() asserts that the item height is valid, but
+    //       we check it here too since it's our divisor.
+    if (scaledItemHeight <= 0) {
+        return (VIRTUALIZATION_OVERSCAN_COUNT * 2);
+    }
+
+    // Calc how many items fit within our viewport, including a partial item
+    // at each end.
+    std::size_t visibleCount{static_cast<std::size_t>(
+        std::ceil(scaledExtent.h / scaledItemHeight) + 1)};
+
+    return (visibleCount + (VIRTUALIZATION_OVERSCAN_COUNT * 2));
+}
+
+void VerticalListContainer::arrangeVirtualizedElements(
+    WidgetLocator* widgetLocator)
+{
+    // If any elements that are newly in view have changed (e.g. because we
+    // scrolled to them), re-measure them.
+    measureDirtyVisibleElements();
+
+    // Lay out the visible elements.
+    auto [firstIndex, lastIndex] = calcVisibleElementRange();
+    for (std::size_t i{firstIndex}; i < lastIndex; ++i) {
+        // Figure out where the element should be placed.
+        Widget& element{getItemWidget(i)};
+        SDL_FRect elementExtent{element.getScaledExtent()};
+        elementExtent.x += fullExtent.x;
+        if (flowDirection == FlowDirection::TopToBottom) {
+            elementExtent.y += fullExtent.y;
+            elementExtent.y += elementOffsets[i];
+            elementExtent.y -= scrollDistance;
+        }
+        else {
+            elementExtent.y += (fullExtent.y + fullExtent.h);
+            elementExtent.y -= (elementOffsets[i] + elementHeights[i]);
+            elementExtent.y += scrollDistance;
+        }
+
+        // Arrange the element, passing it the calculated start position.
+        element.arrange({elementExtent.x, elementExtent.y}, clippedExtent,
+                        widgetLocator);
+    }
+
+    firstArrangedIndex = firstIndex;
+    lastArrangedIndex = lastIndex;
+}
+
 } // namespace AUI
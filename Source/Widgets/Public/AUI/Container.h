@@ -3,6 +3,8 @@
 #include "AUI/Widget.h"
 #include <vector>
 #include <memory>
+#include <functional>
+#include <limits>
 
 namespace AUI
 {
@@ -13,6 +15,10 @@ namespace AUI
  * For example, a VerticalGridContainer will lay out widgets in a grid that
  * grows vertically.
  *
+ * Some containers support item recycling (see setRecycledItems()). In this
+ * mode, the container only owns enough widgets to fill its visible area,
+ * and re-binds them to different items as the user scrolls.
+ *
  * TODO: Make this templated to support different underlying containers.
  *       Add push_front().
  */
@@ -23,6 +29,12 @@ public:
     using iterator = container_type::iterator;
     using const_iterator = container_type::const_iterator;
 
+    /** Constructs a new widget to add to the recycling pool. */
+    using ItemFactory = std::function<std::unique_ptr<Widget>(void)>;
+    /** Updates the given pooled widget to display the item at the given
+        index. */
+    using ItemBinder = std::function<void(Widget&, std::size_t)>;
+
     virtual ~Container() = default;
 
     /**
@@ -106,12 +118,134 @@ protected:
     Container(const SDL_FRect& inLogicalExtent,
               const std::string& inDebugName = "Container");
 
+    /**
+     * Called after elements are inserted into this container.
+     *
+     * Derived containers can override this to keep any per-element caches
+     * in sync with the elements vector.
+     *
+     * @param index The index of the first inserted element.
+     * @param count The number of inserted elements.
+     */
+    virtual void onElementsInserted(std::size_t index, std::size_t count);
+
+    /**
+     * Called after elements are erased from this container.
+     *
+     * @param index The index of the first erased element.
+     * @param count The number of erased elements.
+     */
+    virtual void onElementsErased(std::size_t index, std::size_t count);
+
+    /**
+     * Puts this container into item recycling mode.
+     *
+     * Instead of owning a widget for every item, the container will use
+     * itemFactory to construct only as many widgets as it needs to fill its
+     * visible area. When an item is scrolled into view, its widget will be
+     * passed to itemBinder along with the item's index. Bound widgets are
+     * always re-measured, so the binder doesn't need to invalidate them.
+     *
+     * Any existing elements will be cleared. While recycling, the element
+     * functions (push_back(), erase(), etc) shouldn't be used. Call clear()
+     * to leave recycling mode.
+     *
+     * Derived containers that support recycling should expose this, and must
+     * use getItemCount() and getItemWidget() instead of accessing elements
+     * directly.
+     */
+    void setRecycledItems(std::size_t inItemCount, ItemFactory inItemFactory,
+                          ItemBinder inItemBinder);
+
+    /**
+     * Sets the number of items that are available while recycling.
+     *
+     * All visible widgets will be re-bound during the next layout pass.
+     */
+    void setItemCount(std::size_t inItemCount);
+
+    /**
+     * Re-binds all visible widgets during the next layout pass. Call this if
+     * your item data changes.
+     */
+    void refreshItems();
+
+    /**
+     * If recycling, returns the number of items. Else, returns the number
+     * of elements.
+     */
+    std::size_t getItemCount() const;
+
+    /**
+     * Returns the widget for the item at the given index.
+     *
+     * If recycling, the widget will be taken from the pool and bound to the
+     * item if necessary. Else, returns the element at the given index.
+     *
+     * Note: While recycling, only a contiguous range of items that's no
+     *       larger than the pool can be used at once.
+     * Note: This is meant to be called during layout, with the caller
+     *       measuring the returned widget if it's dirty. If a widget has to
+     *       be bound here, its invalidation won't reach our ancestors.
+     */
+    Widget& getItemWidget(std::size_t itemIndex);
+
+    /**
+     * If recycling, binds the items in the range [firstIndex, lastIndex) to
+     * widgets from the pool.
+     *
+     * Call this outside of layout whenever the visible range changes (e.g.
+     * when scrolling), so that any invalidation caused by the binder is
+     * handled in the upcoming layout pass instead of causing another one.
+     *
+     * Does nothing if the range doesn't fit in the pool (the items will
+     * instead be bound by getItemWidget() once the pool has grown).
+     */
+    void bindItemWidgets(std::size_t firstIndex, std::size_t lastIndex);
+
+    /**
+     * If recycling, grows the pool of widgets to the given size using the
+     * item factory. Does nothing if the pool is already large enough.
+     *
+     * Note: This doesn't invalidate this container's layout, so that it may
+     *       be called during measure().
+     */
+    void reserveItemWidgets(std::size_t widgetCount);
+
+    /** If true, this container is in item recycling mode. */
+    bool isRecycling;
+
     /** This container's child elements. This container owns the elements in
         this vector and must render them according to its layout logic.
 
         We can't reuse Widget::children because it only contains references.
-        Containers must actually own their children. */
+        Containers must actually own their children.
+
+        If recycling, this holds the pool of widgets. */
     std::vector<std::unique_ptr<Widget>> elements;
+
+private:
+    /** Used in boundItemIndices to show that a widget isn't bound. */
+    static constexpr std::size_t UNBOUND_INDEX{
+        std::numeric_limits<std::size_t>::max()};
+
+    /** If recycling, the number of items that are available. */
+    std::size_t itemCount;
+
+    /** If recycling, used to construct the pooled widgets. */
+    ItemFactory itemFactory;
+
+    /** If recycling, used to bind a pooled widget to an item. */
+    ItemBinder itemBinder;
+
+    /** If recycling, the index of the item that each element is currently
+        bound to. Parallel to elements. */
+    std::vector<std::size_t> boundItemIndices;
+
+    /**
+     * Binds the given item to its pool slot, if it isn't already bound.
+     */
+    void bindItemWidget(std::size_t itemIndex);
 };
 
 } // namespace AUI
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "AUI/Container.h"
+#include "AUI/ScreenResolution.h"
+#include <utility>
 
 namespace AUI
 {
 /**
  * Lays out widgets in a grid that grows horizontally.
  *
+ * Only the columns that are within this container's extent are measured,
+ * arranged, and rendered, so large grids scroll at a constant cost.
+ * Offscreen elements that are invalidated will be re-measured when they're
+ * scrolled into view.
+ *
  * Supports horizontal scrolling with the mouse wheel.
  *
  * TODO: After scrolling the list, our elements still have hover states based
@@ -47,6 +54,17 @@ public:
      */
     void setScrollingEnabled(bool isEnabled);
 
+    /**
+     * See Container::setRecycledItems().
+     *
+     * Only the widgets needed to fill this container's visible columns will
+     * be constructed.
+     */
+    using Container::setRecycledItems;
+    using Container::setItemCount;
+    using Container::refreshItems;
+    using Container::getItemCount;
+
     //-------------------------------------------------------------------------
     // Base class overrides
     //-------------------------------------------------------------------------
@@ -58,10 +76,24 @@ public:
                  const SDL_FRect& availableExtent,
                  WidgetLocator* widgetLocator) override;
 
+    void render(const SDL_FPoint& windowTopLeft) override;
+
 private:
     /** The default logical pixel width of this container's cells. */
     static constexpr float LOGICAL_DEFAULT_CELL_WIDTH{100};
 
+    /**
+     * Returns the [first, last) range of element indices that are in the
+     * columns within this container's extent.
+     */
+    std::pair<std::size_t, std::size_t> calcVisibleElementRange();
+
+    /**
+     * Returns the number of cells in the columns within this container's
+     * extent, including any partially visible column.
+     */
+    std::size_t calcVisibleCellCount();
+
     /**
      * Scrolls the visible elements in the container left or right, bringing
      * offscreen elements onto the screen.
@@ -93,6 +125,17 @@ private:
 
     /** How many columns to the right we're currently scrolled. */
     unsigned int columnScroll;
+
+    /** The element index range that was used during the last arrange().
+        Elements outside of this range may have stale layouts, so we don't
+        render them. */
+    std::size_t firstArrangedIndex;
+    std::size_t lastArrangedIndex;
+
+    /** The screen size and logical extent that were used during the last
+        measure(). If either changes, all elements need to be re-measured. */
+    ScreenResolution lastUsedScreenSize;
+    SDL_FRect lastUsedLogicalExtent;
 };
 
 } // namespace AUI
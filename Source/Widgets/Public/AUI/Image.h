@@ -68,6 +68,32 @@ public:
     void setSimpleImage(const std::string& textureID, SDL_FRect texExtent,
                         SDL_ScaleMode scaleMode = SDL_SCALEMODE_NEAREST);
 
+    /**
+     * Sets this widget to render a SimpleImage, decoding the image file in
+     * the background if it isn't already in the cache.
+     *
+     * Until the image is ready, AssetCache's async placeholder is rendered
+     * (or nothing, if there's no placeholder).
+     *
+     * @param textureID A user-defined ID (for manually added textures), or the
+     *                  full path to an image file.
+     * @param scaleMode The filtering/scaling mode that this texture should use
+     *                  ("nearest" by default, to maximize sharpness).
+     */
+    void setSimpleImageAsync(const std::string& textureID,
+                             SDL_ScaleMode scaleMode = SDL_SCALEMODE_NEAREST);
+
+    /**
+     * Overload to specify texExtent. Use this if you only want to display a
+     * portion of the image.
+     *
+     * @param inTexExtent The extent within the texture to display.
+     * @param scaleMode The filtering/scaling mode that this texture should use
+     *                  ("nearest" by default, to maximize sharpness).
+     */
+    void setSimpleImageAsync(const std::string& textureID, SDL_FRect texExtent,
+                             SDL_ScaleMode scaleMode = SDL_SCALEMODE_NEAREST);
+
     /**
      * Sets this widget to render a NineSliceImage (see class comment).
      *
@@ -76,9 +102,13 @@ public:
      * @param textureID A user-defined ID (for manually added textures), or the
      *                  full path to an image file.
      * @param sliceSizes How far to slice into the image, in each direction.
+     * @param renderMode How the slices should be drawn. See
+     *                   NineSliceImage::RenderMode.
      */
     void setNineSliceImage(const std::string& textureID,
-                           NineSliceImage::SliceSizes inSliceSizes);
+                           NineSliceImage::SliceSizes inSliceSizes,
+                           NineSliceImage::RenderMode renderMode
+                           = NineSliceImage::RenderMode::GeneratedTexture);
 
     struct MultiResImagePathInfo {
         /** The screen resolution that this texture should be used for. */
@@ -147,7 +177,9 @@ public:
                         SDL_FRect texExtent,
                         SDL_ScaleMode scaleMode = SDL_SCALEMODE_NEAREST);
     void setNineSliceImage(SDL_Texture* texture, const std::string& textureID,
-                           NineSliceImage::SliceSizes inSliceSizes);
+                           NineSliceImage::SliceSizes inSliceSizes,
+                           NineSliceImage::RenderMode renderMode
+                           = NineSliceImage::RenderMode::GeneratedTexture);
     void setMultiResImage(
         const std::vector<MultiResImageTextureInfo>& imageInfo);
     void setTiledImage(SDL_Texture* texture, const std::string& textureID);
@@ -158,14 +190,38 @@ public:
      */
     void setAlphaMod(float newAlphaMod);
 
+    /**
+     * Tells us whether our image is fully opaque.
+     *
+     * Since checking every pixel would be expensive, textures with an alpha
+     * channel (e.g. almost every PNG) are otherwise treated as translucent.
+     * Set this for images that you know have no translucent pixels (e.g. a
+     * background), so that windows underneath them can skip rendering.
+     */
+    void setIsOpaque(bool inIsOpaque);
+
     /**
      * Returns the extent of the current image texture.
      */
     SDL_FRect getCurrentImageTextureExtent() const;
 
+    /**
+     * Returns the texture that's currently drawn by this image, or nullptr
+     * if there isn't one (e.g. the image type draws straight from its source
+     * texture, or hasn't been set).
+     */
+    SDL_Texture* getCurrentTexture() const;
+
     //-------------------------------------------------------------------------
     // Base class overrides
     //-------------------------------------------------------------------------
+    /**
+     * Returns true if our texture is loaded, is drawn without an alpha mod,
+     * and either has no alpha channel or was marked as opaque through
+     * setIsOpaque().
+     */
+    bool getIsOpaque() const override;
+
     void measure(const SDL_FRect& availableExtent);
 
     /**
@@ -188,6 +244,9 @@ private:
 
     /** The alpha mod to apply to the image texture. */
     float alphaMod;
+
+    /** If true, our image is known to be fully opaque. See setIsOpaque(). */
+    bool isOpaque;
 };
 
 } // namespace AUI
@@ -4,6 +4,7 @@
 #include <SDL3/SDL_render.h>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace AUI
 {
@@ -20,16 +21,54 @@ public:
      */
     virtual void refresh(const SDL_FRect& scaledExtent);
 
+    /**
+     * If this image is waiting for an async texture load, checks if the
+     * texture is ready and swaps it in.
+     *
+     * Called by Image::render() while isTexturePending is true.
+     */
+    virtual void updatePendingTexture();
+
+    /**
+     * Gives the derived type a chance to draw itself, instead of having
+     * Image draw currentTexture.
+     *
+     * Types that draw straight from a source texture (instead of generating
+     * one) override this and return true.
+     *
+     * @param fullExtent  The Image's full extent, in actual screen space.
+     * @param clippedExtent  The Image's clipped extent, in actual screen
+     *                       space. Nothing should be drawn outside of it.
+     * @param alphaMod  The alpha to draw with, from 0.0 - 1.0.
+     * @return true if the image was drawn, else false.
+     */
+    virtual bool render(const SDL_FRect& fullExtent,
+                        const SDL_FRect& clippedExtent, float alphaMod);
+
 protected:
     // Friend class so Image::render() can use these fields, but outside users
     // have to go through a derived class's setter.
     friend class Image;
 
+    /**
+     * Appends a quad that covers destRect to the given geometry. For use by
+     * derived types that override render().
+     *
+     * @param texCoords The normalized extent within the texture to draw.
+     */
+    static void addQuad(std::vector<SDL_Vertex>& vertices,
+                        std::vector<int>& indices, const SDL_FRect& destRect,
+                        const SDL_FRect& texCoords, const SDL_FColor& color);
+
     /** The current texture to display. */
     std::shared_ptr<SDL_Texture> currentTexture{};
 
     /** The extent within currentTexture to display. */
     SDL_FRect currentTexExtent{};
+
+    /** If true, currentTexture is a placeholder (or nullptr) and we're
+        waiting for an async texture load to finish. */
+    bool isTexturePending{false};
 };
 
 } // namespace AUI
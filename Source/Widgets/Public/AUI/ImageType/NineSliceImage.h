@@ -3,6 +3,7 @@
 #include "AUI/ImageType/ImageType.h"
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace AUI
 {
@@ -15,6 +16,18 @@ namespace AUI
  * (vertical for the left/right sides, horizontal for the top/bottom. The
  * center gets scaling in both directions.
  *
+ * By default, the slices are drawn into a generated texture that matches
+ * the widget's size. Widgets that get resized often (resizable panels,
+ * animated windows) should use RenderMode::Geometry instead, which draws the
+ * slices straight from the source texture and never allocates a texture.
+ *
+ * Generated textures are shared through AssetCache, keyed on the source
+ * texture, slice sizes, and size. Images that match on all of these (e.g. a
+ * screen full of identical buttons) share a single texture.
+ * Note: If you replace a source texture through AssetCache::addTexture(),
+ *       textures that were already generated from it aren't updated. Use a
+ *       new texture ID instead.
+ *
  * TODO: Add support for tiled borders.
  */
 class NineSliceImage : public ImageType
@@ -32,6 +45,18 @@ public:
         float left{0};
     };
 
+    /**
+     * How the slices get drawn.
+     */
+    enum class RenderMode {
+        /** The slices are drawn into a generated texture whenever our size
+            changes, which is then drawn as a single quad. */
+        GeneratedTexture,
+        /** The slices are drawn straight from the source texture as 9 quads
+            (a single batchable geometry command). Resizing costs nothing. */
+        Geometry
+    };
+
     /**
      * Sets the image that this widget will slice and render.
      *
@@ -39,32 +64,71 @@ public:
      *                  addTexture()), or the full path to an image file.
      * @param inSliceSizes How far to slice into the image, in each direction.
      * @param scaledExtent The desired size of the generated texture.
+     * @param inRenderMode How the slices should be drawn.
      */
     void set(const std::string& textureID, SliceSizes inSliceSizes,
-             const SDL_FRect& scaledExtent);
+             const SDL_FRect& scaledExtent,
+             RenderMode inRenderMode = RenderMode::GeneratedTexture);
 
     /**
-     * Overridden to generate a new nine slice texture.
+     * Overridden to generate a new nine slice texture (if we're using one).
      */
     void refresh(const SDL_FRect& scaledExtent) override;
 
+    /**
+     * Overridden to draw the slices directly, if we're in Geometry mode.
+     */
+    bool render(const SDL_FRect& fullExtent, const SDL_FRect& clippedExtent,
+                float alphaMod) override;
+
 private:
     /**
-     * Generates a new nine slice texture, based on sourceTexture.
+     * Sets currentTexture to a nine slice texture that matches our current
+     * state, generating it if the asset cache doesn't already have one.
      */
     void regenerateNineSliceTexture();
 
+    /**
+     * Generates a new nine slice texture, based on sourceTexture.
+     */
+    SDL_Texture* generateNineSliceTexture();
+
+    /**
+     * Returns the ID that our generated texture should use in the asset
+     * cache. Includes everything that affects the texture's contents.
+     */
+    std::string getGeneratedTextureID() const;
+
     // Functions for copying the slices into the current render target (our
     // new texture). Used by regenerateNineSliceTexture().
     void copyCorners(float sourceWidth, float sourceHeight);
     void copySides(float sourceWidth, float sourceHeight);
     void copyCenter(float sourceWidth, float sourceHeight);
 
+    /**
+     * Adds a quad to vertices and indices that draws sourceRect into
+     * destRect, clipped to clippedExtent. Used by render().
+     */
+    void addSliceQuad(const SDL_FRect& sourceRect, const SDL_FRect& destRect,
+                      const SDL_FRect& clippedExtent, float sourceWidth,
+                      float sourceHeight, const SDL_FColor& color);
+
+    /** The ID of the source texture that we were given. */
+    std::string sourceTextureID;
+
     /** The source texture that we were given. */
     std::shared_ptr<SDL_Texture> sourceTexture;
 
     /** How far to slice into sourceTexture, in each direction. */
     SliceSizes sliceSizes;
+
+    /** How the slices get drawn. */
+    RenderMode renderMode{RenderMode::GeneratedTexture};
+
+    /** Used by render() to build our geometry. Kept as members to avoid
+        re-allocating them every frame. */
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
 };
 
 } // namespace AUI
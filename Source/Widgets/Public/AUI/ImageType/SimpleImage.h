@@ -2,6 +2,7 @@
 
 #include "AUI/ImageType/ImageType.h"
 #include <string>
+#include <optional>
 
 namespace AUI
 {
@@ -10,6 +11,9 @@ namespace AUI
  *
  * If the render extent is larger or smaller than the source image, the image
  * will be squashed or stretched.
+ *
+ * If setAsync() is used, the image file will be decoded in the background.
+ * Until it's ready, AssetCache's async placeholder (if any) will be displayed.
  */
 class SimpleImage : public ImageType
 {
@@ -38,10 +42,54 @@ public:
     void set(const std::string& textureID, const SDL_FRect& inTexExtent,
              SDL_ScaleMode scaleMode = SDL_SCALEMODE_NEAREST);
 
+    /**
+     * Sets the image that this widget will render, loading it in the
+     * background if it isn't already in the cache. See class comment.
+     *
+     * @param textureID A user-defined ID (for manually added textures), or the
+     *                  full path to an image file.
+     * @param scaleMode The filtering/scaling mode that this texture should use
+     *                  ("nearest" by default, to maximize sharpness).
+     */
+    void setAsync(const std::string& textureID,
+                  SDL_ScaleMode scaleMode = SDL_SCALEMODE_NEAREST);
+
+    /**
+     * Overload to specify texExtent. Use this if you only want to display a
+     * portion of the texture.
+     *
+     * Note: The placeholder is displayed in full, ignoring inTexExtent.
+     *
+     * @param inTexExtent The extent within the texture to display.
+     * @param scaleMode The filtering/scaling mode that this texture should use
+     *                  ("nearest" by default, to maximize sharpness).
+     */
+    void setAsync(const std::string& textureID, const SDL_FRect& inTexExtent,
+                  SDL_ScaleMode scaleMode = SDL_SCALEMODE_NEAREST);
+
     /**
      * Clears this image's current texture.
      */
     void clear();
+
+    void updatePendingTexture() override;
+
+private:
+    /**
+     * Sets currentTexture to the given texture, or to the async placeholder
+     * if it's nullptr.
+     */
+    void setTextureOrPlaceholder(std::shared_ptr<SDL_Texture> texture);
+
+    /** The ID of the texture that we're waiting on. */
+    std::string pendingTextureID{};
+
+    /** The scale mode of the texture that we're waiting on. */
+    SDL_ScaleMode pendingScaleMode{SDL_SCALEMODE_NEAREST};
+
+    /** The extent to display once the pending texture is ready. If empty,
+        the full texture will be displayed. */
+    std::optional<SDL_FRect> pendingTexExtent{};
 };
 
 } // namespace AUI
@@ -2,6 +2,7 @@
 
 #include "AUI/ImageType/ImageType.h"
 #include <memory>
+#include <vector>
 
 namespace AUI
 {
@@ -10,6 +11,11 @@ namespace AUI
  *
  * If the given image doesn't tile perfectly, it will be clipped at the right
  * and bottom edges.
+ *
+ * The tiles are drawn straight from the source texture each frame (as a
+ * single geometry command), so resizing is free and no extra texture memory
+ * is used. Only the tiles that are visible within the widget's clipped
+ * extent are drawn.
  */
 class TiledImage : public ImageType
 {
@@ -21,23 +27,33 @@ public:
      *
      * @param textureID A user-defined ID (for manually added textures), or the
      *                  full path to an image file.
-     * @param scaledExtent The desired size of the generated texture.
+     * @param scaledExtent The extent to tile the image across.
      */
     void set(const std::string& textureID, const SDL_FRect& scaledExtent);
 
     /**
-     * Overridden to generate a new tiled image texture.
+     * Overridden to track our new size.
      */
     void refresh(const SDL_FRect& scaledExtent) override;
 
-private:
     /**
-     * Generates a new tiled texture, based on sourceTexture.
+     * Overridden to draw the visible tiles.
      */
-    void regenerateTiledTexture();
+    bool render(const SDL_FRect& fullExtent, const SDL_FRect& clippedExtent,
+                float alphaMod) override;
+
+    // Testing interface, you probably don't need to use these.
+    /** Returns the geometry that was drawn by the last render(). */
+    const std::vector<SDL_Vertex>& getVertices() const;
 
+private:
     /** The source texture that we were given. */
     std::shared_ptr<SDL_Texture> sourceTexture;
+
+    /** Used by render() to build our geometry. Kept as members to avoid
+        re-allocating them every frame. */
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
 };
 
 } // namespace AUI
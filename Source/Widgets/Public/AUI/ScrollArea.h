@@ -74,7 +74,9 @@ public:
     //-------------------------------------------------------------------------
     /** This scroll area's child content widget.
         We use this instead of adding it to Widget::children so that we can
-        control its layout independent of our own. */
+        control its layout independent of our own.
+        Note: If you replace this after the first layout pass, call
+              invalidateMeasure() so the new content gets laid out. */
     std::unique_ptr<Widget> content;
 
     //-------------------------------------------------------------------------
@@ -2,10 +2,12 @@
 
 #include "AUI/Widget.h"
 #include "AUI/AssetCache.h" // FontHandle
+#include "AUI/TextRasterizer.h"
 #include "AUI/ScreenResolution.h"
 #include <SDL3_ttf/SDL_ttf.h>
 #include <string_view>
 #include <string>
+#include <vector>
 
 namespace AUI
 {
@@ -23,7 +25,19 @@ namespace AUI
  * This is placed within the widget extent, offset through the alignment
  * and textOffset parameters, and is finally clipped by the widget extent
  * before rendering.
-
+ *
+ * By default, the text is rasterized into its own texture whenever it
+ * changes. For text that changes often (timers, stats, etc), consider using
+ * the GlyphAtlas render backend instead (see setRenderBackend()).
+ *
+ * Text that repeats across many widgets (button labels, column headers, item
+ * names) can share its texture through the asset cache instead (see
+ * setTextureSharingEnabled()).
+ *
+ * If many Text widgets get created or re-scaled at once, consider enabling
+ * async rasterization (see setAsyncRasterizationEnabled()), which moves the
+ * rasterization onto worker threads.
+ *
  * Note: Font assets are managed in an internal cache.
  */
 class Text : public Widget
@@ -34,18 +48,32 @@ public:
     //-------------------------------------------------------------------------
     /**
      * Text render mode, affects the quality of the rendered image.
-     * See SDL_ttf documentation for more.
-     */
-    enum class RenderMode {
-        /** Fastest, lowest quality. */
-        Solid,
-        /** Better quality, but has a box around it. */
-        Shaded,
-        /** Slower, high quality, no box. */
-        Blended,
-        /** Slowest, LCD subpixel quality, but has a box around it.
-            Useful for small font sizes. */
-        LCD
+     * See TextRasterizer::RenderMode.
+     */
+    using RenderMode = TextRasterizer::RenderMode;
+
+    /**
+     * How the text is drawn. See setRenderBackend().
+     */
+    enum class RenderBackend {
+        /** The whole string is rasterized into a texture whenever it changes.
+            Supports every RenderMode. */
+        Texture,
+        /** Glyphs are rasterized once into a shared atlas, and the string is
+            drawn as a batch of quads. Changing the text only costs a layout
+            and vertex update. Always renders as if RenderMode == Blended. */
+        GlyphAtlas
+    };
+
+    /**
+     * Texture update statistics, for checking how often text textures have
+     * to be re-allocated.
+     */
+    struct TextureStats {
+        /** The number of times a Text allocated a new texture. */
+        std::size_t reallocationCount{0};
+        /** The number of times a Text re-used its existing texture. */
+        std::size_t inPlaceUpdateCount{0};
     };
 
     /**
@@ -64,6 +92,8 @@ public:
     Text(const SDL_FRect& inLogicalExtent,
          const std::string& inDebugName = "Text");
 
+    virtual ~Text();
+
     /**
      * Sets the font and size. Uses the internal ID format "font_size".
      *
@@ -90,6 +120,37 @@ public:
      */
     void setRenderMode(RenderMode inRenderMode);
 
+    /**
+     * Sets the backend used to draw the text (see RenderBackend).
+     */
+    void setRenderBackend(RenderBackend inRenderBackend);
+
+    /**
+     * If true, our text texture will be shared through the asset cache with
+     * every other Text that has texture sharing enabled and would render the
+     * same image (same font, size, outline, colors, render mode, wrap width,
+     * and string).
+     *
+     * Shared textures are reference counted. Once no Text uses them, they're
+     * evicted in LRU order whenever the asset cache's generated textures go
+     * over their budget (see AssetCache::setGeneratedTextureBudget(), 16MiB
+     * by default), or by AssetCache::prune(). If your texts change often,
+     * consider lowering that budget or leaving sharing disabled.
+     *
+     * Only affects the Texture render backend. Disabled by default.
+     */
+    void setTextureSharingEnabled(bool inTextureSharingEnabled);
+
+    /**
+     * If true, our text will be rasterized on a worker thread (see
+     * TextRasterizer) instead of during measure(). Our previous texture stays
+     * visible until the new one is ready, at which point we'll invalidate
+     * our measure and pick it up.
+     *
+     * Only affects the Texture render backend. Disabled by default.
+     */
+    void setAsyncRasterizationEnabled(bool inAsyncRasterizationEnabled);
+
     /**
      * Sets the text that this widget will display.
      */
@@ -142,6 +203,7 @@ public:
 
     /**
      * Re-renders the text texture, using all current property values.
+     * If using the GlyphAtlas backend, re-builds the glyph quads instead.
      */
     void refreshTexture();
 
@@ -159,6 +221,17 @@ public:
      */
     SDL_FRect calcCharacterOffset(std::size_t index);
 
+    /**
+     * Used to tell which character is at a particular position within the
+     * widget (e.g. to place a text cursor where the user clicked).
+     *
+     * @param offsetX An x offset, relative to scaledExtent (the same space
+     *                that calcCharacterOffset() returns).
+     * @return The index in the underlying string of the character boundary
+     *         that's closest to the given offset.
+     */
+    std::size_t calcCharacterIndex(float offsetX);
+
     /**
      * Calculates the width that the given string would have if rendered using
      * this widget's current font.
@@ -177,6 +250,17 @@ public:
     HorizontalAlignment getHorizontalAlignment();
     float getTextOffset();
 
+    /**
+     * Returns the texture stats that have accumulated across every Text
+     * since the last resetTextureStats().
+     */
+    static const TextureStats& getTextureStats();
+
+    /**
+     * Resets the texture stats.
+     */
+    static void resetTextureStats();
+
     //-------------------------------------------------------------------------
     // Base class overrides
     //-------------------------------------------------------------------------
@@ -216,11 +300,113 @@ private:
     void refreshFontObject();
 
     /**
-     * Returns a surface for the given font, using our current text, colors,
-     * extent, and renderMode.
+     * Returns a rasterization request that matches our current property
+     * values.
+     */
+    TextRasterizer::Request buildRasterRequest() const;
+
+    /**
+     * Renders our text into a new surface, using all current property values.
      */
-    SDL_Surface* getSurface(TTF_Font* font, const SDL_Color& fontColor,
-                            const SDL_Color& fontBackgroundColor);
+    SDL_Surface* generateTextSurface();
+
+    /**
+     * Renders our text into a new texture, using all current property values.
+     * Used when texture sharing is enabled.
+     */
+    SDL_Texture* generateTextTexture();
+
+    /**
+     * Copies the given surface into textTexture, only re-allocating the
+     * texture if the surface doesn't fit or the texture is far bigger than
+     * it needs to be. Used when texture sharing is disabled.
+     *
+     * Note: Takes ownership of the surface.
+     */
+    void updateTextTexture(SDL_Surface* surface);
+
+    /**
+     * Uploads the given surface into textTexture (either through the asset
+     * cache or updateTextTexture(), depending on whether texture sharing is
+     * enabled), then calls setTextureSize().
+     *
+     * Note: Takes ownership of the surface.
+     */
+    void applyTextSurface(SDL_Surface* surface);
+
+    /**
+     * Sets textureExtent and textExtent to the given size, and flags our
+     * alignment as dirty.
+     */
+    void setTextureSize(float width, float height);
+
+    /**
+     * If our async rasterization job has finished, applies its result.
+     */
+    void updatePendingRasterization();
+
+    /**
+     * If we have an async rasterization job, cancels it.
+     */
+    void cancelPendingRasterization();
+
+    /**
+     * Returns the ID that our text texture should use in the asset cache,
+     * when texture sharing is enabled. Built from a hash of everything that
+     * affects the texture's contents.
+     */
+    std::string getSharedTextureID() const;
+
+    /** The position of a single glyph within our text, relative to the text's
+        top left. */
+    struct GlyphPosition {
+        Uint32 codepoint{0};
+        float x{0};
+        float y{0};
+    };
+
+    /** A set of glyph quads that all use the same atlas page. */
+    struct GlyphBatch {
+        SDL_Texture* page{nullptr};
+        std::vector<SDL_Vertex> vertices{};
+        std::vector<int> indices{};
+    };
+
+    /**
+     * Lays out our text using the glyph atlas and re-builds glyphBatches.
+     * Also sets textureExtent to the size of the laid out text.
+     */
+    void refreshGlyphBatches();
+
+    /**
+     * Lays out our text, returning the position of each glyph. Follows the
+     * same word wrapping rules as the Texture backend.
+     *
+     * @param outTextWidth The width of the widest line.
+     * @param outLineCount The number of lines.
+     */
+    std::vector<GlyphPosition> layoutGlyphs(float& outTextWidth,
+                                            int& outLineCount);
+
+    /**
+     * Adds quads for the given glyphs to glyphBatches.
+     *
+     * @param glyphFont The font to get the glyph images from.
+     * @param offset An offset to apply to every glyph.
+     */
+    void addGlyphQuads(const std::vector<GlyphPosition>& glyphPositions,
+                       TTF_Font* glyphFont, const SDL_Color& glyphColor,
+                       const SDL_FPoint& offset);
+
+    /**
+     * Renders glyphBatches, clipped to offsetClippedTextExtent.
+     */
+    void renderGlyphBatches(const SDL_FPoint& windowTopLeft);
+
+    /**
+     * Re-calculates characterOffsets, using our current text and font.
+     */
+    void refreshCharacterOffsets();
 
     /** Full path to the font file. */
     std::string fontPath;
@@ -235,8 +421,8 @@ private:
     /** The handle to our font object. */
     std::shared_ptr<TTF_Font> font;
 
-    /** If logicalFontOutlineSize > 0, this is the handle to our outlined font
-        object. */
+    /** If logicalFontOutlineSize > 0 and renderBackend == GlyphAtlas, this is
+        the handle to our outlined font object. */
     std::shared_ptr<TTF_Font> outlinedFont;
 
     /** The color of our text. */
@@ -248,6 +434,18 @@ private:
     /** The render mode. Affects the quality of the rendered image. */
     RenderMode renderMode;
 
+    /** The backend used to draw the text. */
+    RenderBackend renderBackend;
+
+    /** If true, our text texture is shared through the asset cache. */
+    bool textureSharingEnabled;
+
+    /** If true, our text is rasterized on a worker thread. */
+    bool asyncRasterizationEnabled;
+
+    /** If non-zero, the ID of our in-progress async rasterization job. */
+    TextRasterizer::JobID pendingRasterJobID;
+
     /** If true, text that is longer than this widget's extent will be wrapped
         at word boundaries. */
     bool wordWrapEnabled;
@@ -280,19 +478,42 @@ private:
         alignment must be refreshed. */
     bool alignmentIsDirty;
 
-    /** A deleter to use with fontTexture. */
-    struct TextureDeleter {
-        void operator()(SDL_Texture* p) { SDL_DestroyTexture(p); }
-    };
+    /** The x offset of each character boundary in our text, relative to the
+        start of the text. Index i holds the width of the first i bytes of
+        our text (bytes within a multi-byte character share the offset of
+        the character's start). Has text.size() + 1 entries.
+        Used to make calcCharacterOffset() and calcCharacterIndex() cheap. */
+    std::vector<float> characterOffsets;
+
+    /** The height of a line of text in our current font. */
+    float lineHeight;
+
+    /** If true, our text or font has changed and characterOffsets must be
+        re-calculated. */
+    bool characterOffsetsAreDirty;
 
     /** The current texture. Shows our text in the desired font.
-        We manage the texture ourselves instead of passing it to the resource
-        manager because it'll only ever be used by this widget. */
-    std::unique_ptr<SDL_Texture, TextureDeleter> textTexture;
+        Unless texture sharing is enabled, we manage the texture ourselves
+        instead of passing it to the asset cache, because it'll only ever be
+        used by this widget.
+        Our own textures are streaming textures with some headroom, so that
+        small changes (e.g. a counter going from "123" to "124") can be
+        copied into the existing texture. The text only occupies the top
+        left textureExtent of the texture. */
+    std::shared_ptr<SDL_Texture> textTexture;
+
+    /** See getTextureStats(). */
+    static TextureStats textureStats;
+
+    /** If renderBackend == GlyphAtlas, the quads to draw, relative to the
+        text's top left. */
+    std::vector<GlyphBatch> glyphBatches;
 
     /** The source extent of the image within the text texture.
-        Since we use the whole texture, this is effectively the size of the
-        texture. */
+        This is the size of the rendered text, which may be smaller than the
+        texture.
+        If renderBackend == GlyphAtlas, this is the size of the laid out
+        text. */
     SDL_FRect textureExtent;
 
     /** Our textureExtent, aligned to our scaledExtent according to our
@@ -4,6 +4,7 @@
 #include "AUI/Text.h"
 #include "AUI/Padding.h"
 #include <functional>
+#include <optional>
 
 namespace AUI
 {
@@ -103,6 +104,8 @@ public:
     void setTextFont(const std::string& fontPath, float inLogicalFontSize);
     /** Sets the user text color. */
     void setTextColor(const SDL_Color& inColor);
+    /** Calls text.setAsyncRasterizationEnabled(). */
+    void setTextAsyncRasterizationEnabled(bool inAsyncRasterizationEnabled);
 
     /**
      * Sets the text that is displayed when no user text is entered, and this
@@ -134,6 +137,9 @@ public:
     //-------------------------------------------------------------------------
     // Base class overrides
     //-------------------------------------------------------------------------
+    /**
+     * Moves the text cursor to the clicked character.
+     */
     EventResult onMouseDown(MouseButtonType buttonType,
                             const SDL_FPoint& cursorPosition) override;
 
@@ -248,6 +254,10 @@ private:
     /** The character index in our text that the cursor is currently at. */
     std::size_t cursorIndex;
 
+    /** If we were clicked while unfocused, this holds the character index
+        that was clicked on. onFocusGained() will move the cursor to it. */
+    std::optional<std::size_t> clickedCursorIndex;
+
     /** Tracks whether the text cursor should be drawn or not. */
     bool cursorIsVisible;
 
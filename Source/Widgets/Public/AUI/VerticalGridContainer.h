@@ -1,12 +1,19 @@
 #pragma once
 
 #include "AUI/Container.h"
+#include "AUI/ScreenResolution.h"
+#include <utility>
 
 namespace AUI
 {
 /**
  * Lays out widgets in a grid that grows vertically.
  *
+ * Only the rows that are within this container's extent are measured,
+ * arranged, and rendered, so large grids scroll at a constant cost.
+ * Offscreen elements that are invalidated will be re-measured when they're
+ * scrolled into view.
+ *
  * TODO: After scrolling the list, our elements still have hover states based
  *       on their pre-scroll positions. We need to find a way to update them.
  */
@@ -45,6 +52,17 @@ public:
      */
     void setScrollingEnabled(bool isEnabled);
 
+    /**
+     * See Container::setRecycledItems().
+     *
+     * Only the widgets needed to fill this container's visible rows will
+     * be constructed.
+     */
+    using Container::setRecycledItems;
+    using Container::setItemCount;
+    using Container::refreshItems;
+    using Container::getItemCount;
+
     //-------------------------------------------------------------------------
     // Base class overrides
     //-------------------------------------------------------------------------
@@ -56,10 +74,24 @@ public:
                  const SDL_FRect& availableExtent,
                  WidgetLocator* widgetLocator) override;
 
+    void render(const SDL_FPoint& windowTopLeft) override;
+
 private:
     /** The default logical pixel width of this container's cells. */
     static constexpr float LOGICAL_DEFAULT_CELL_WIDTH{100};
 
+    /**
+     * Returns the [first, last) range of element indices that are in the
+     * rows within this container's extent.
+     */
+    std::pair<std::size_t, std::size_t> calcVisibleElementRange();
+
+    /**
+     * Returns the number of cells in the rows within this container's
+     * extent, including any partially visible row.
+     */
+    std::size_t calcVisibleCellCount();
+
     /**
      * Scrolls the visible elements in the container up or down, bringing
      * offscreen elements onto the screen.
@@ -91,6 +123,17 @@ private:
     /** If true, mouse wheel events should scroll this container's elements
         vertically. */
     bool isScrollingEnabled;
+
+    /** The element index range that was used during the last arrange().
+        Elements outside of this range may have stale layouts, so we don't
+        render them. */
+    std::size_t firstArrangedIndex;
+    std::size_t lastArrangedIndex;
+
+    /** The screen size and logical extent that were used during the last
+        measure(). If either changes, all elements need to be re-measured. */
+    ScreenResolution lastUsedScreenSize;
+    SDL_FRect lastUsedLogicalExtent;
 };
 
 } // namespace AUI
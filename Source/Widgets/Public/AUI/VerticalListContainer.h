@@ -1,6 +1,9 @@
 #pragma once
 
 #include "AUI/Container.h"
+#include "AUI/ScreenResolution.h"
+#include <vector>
+#include <utility>
 
 namespace AUI
 {
@@ -9,6 +12,8 @@ namespace AUI
  *
  * Supports vertical scrolling with the mouse wheel.
  *
+ * For very long lists, see setIsVirtualized() and setRecycledItems().
+ *
  * TODO: After scrolling the list, our elements still have hover states based
  *       on their pre-scroll positions. We need to find a way to update them.
  * TODO: Remake this using ScrollArea, replacing FlowDirection with ScrollOrigin
@@ -54,17 +59,70 @@ public:
      */
     void setFlowDirection(FlowDirection inFlowDirection);
 
+    /**
+     * If true, this container will only measure, arrange, render, and tick
+     * the elements that intersect its viewport (plus a small overscan).
+     * Element offsets are tracked in a cached index that's updated when
+     * elements are inserted, erased, or resized, so the per-frame cost is
+     * proportional to the number of visible elements instead of the total
+     * number of elements.
+     *
+     * Note: While virtualized, elements outside of the viewport are assumed
+     *       to keep their last measured height until they're scrolled into
+     *       view, and don't receive onTick().
+     */
+    void setIsVirtualized(bool inIsVirtualized);
+
+    /**
+     * See Container::setRecycledItems().
+     *
+     * Only the widgets needed to fill this container's viewport will be
+     * constructed. Recycling implies virtualization (see setIsVirtualized()),
+     * with each item's offset tracked in the same cached index.
+     *
+     * @param inLogicalItemHeight The estimated height of each item. Must be
+     *                            greater than 0. Used as the height of items
+     *                            that haven't been measured yet, and to decide
+     *                            how many widgets to start with. If the
+     *                            visible items turn out to be shorter, more
+     *                            widgets will be constructed.
+     */
+    void setRecycledItems(std::size_t inItemCount, float inLogicalItemHeight,
+                          ItemFactory inItemFactory, ItemBinder inItemBinder);
+
+    /**
+     * See Container::setItemCount().
+     *
+     * New items start out at the height given to setRecycledItems().
+     */
+    void setItemCount(std::size_t inItemCount);
+
+    using Container::refreshItems;
+    using Container::getItemCount;
+
     //-------------------------------------------------------------------------
     // Widget class overrides
     //-------------------------------------------------------------------------
     EventResult onMouseWheel(float amountScrolled) override;
 
+    void onTick(double timestepS) override;
+
     void measure(const SDL_FRect& availableExtent) override;
 
     void arrange(const SDL_FPoint& startPosition,
                  const SDL_FRect& availableExtent,
                  WidgetLocator* widgetLocator) override;
 
+    void render(const SDL_FPoint& windowTopLeft) override;
+
+protected:
+    //-------------------------------------------------------------------------
+    // Container class overrides
+    //-------------------------------------------------------------------------
+    void onElementsInserted(std::size_t index, std::size_t count) override;
+
+    void onElementsErased(std::size_t index, std::size_t count) override;
+
 private:
     /**
      * Calculates the height of this container's content, including gaps.
@@ -83,9 +141,62 @@ private:
      */
     void arrangeElementsBottomToTop(WidgetLocator* widgetLocator);
 
+    /**
+     * Measures any elements that haven't been measured yet (or all elements,
+     * if the UI scaling changed), then re-measures any visible elements that
+     * have been invalidated.
+     */
+    void measureVirtualizedElements();
+
+    /**
+     * Re-measures any elements within the visible range that have been
+     * invalidated, then refreshes the element offsets.
+     *
+     * If recycling, repeats until the visible range stops changing, growing
+     * the pool if the range needs more widgets.
+     */
+    void measureDirtyVisibleElements();
+
+    /**
+     * Measures the element at the given index and updates its cached height.
+     */
+    void measureElement(std::size_t index);
+
+    /**
+     * Recalculates elementOffsets, starting at firstDirtyOffsetIndex.
+     */
+    void refreshElementOffsets();
+
+    /**
+     * Calculates the range of elements that intersect our viewport, plus
+     * overscan.
+     *
+     * @return [first, last) indices of the visible elements.
+     */
+    std::pair<std::size_t, std::size_t> calcVisibleElementRange();
+
+    /**
+     * Lays out the elements in the visible range, in the current flow
+     * direction.
+     */
+    void arrangeVirtualizedElements(WidgetLocator* widgetLocator);
+
     /** The default logical pixel distance of a scroll event. */
     static constexpr float LOGICAL_DEFAULT_SCROLL_DISTANCE{15};
 
+    /** While virtualized, the number of elements past each end of the
+        viewport to lay out. */
+    static constexpr std::size_t VIRTUALIZATION_OVERSCAN_COUNT{2};
+
+    /** Used in elementHeights to mark elements that haven't been measured. */
+    static constexpr float UNMEASURED_HEIGHT{-1};
+
+    /**
+     * If recycling, returns how many widgets are needed to fill our viewport
+     * plus overscan, assuming every item is scaledItemHeight tall.
+     */
+    std::size_t calcRecycledWidgetCount();
+
     /** The height in logical space of a single scroll event. */
     float logicalScrollHeight;
     /** The scaled height in actual space of a single scroll event. */
@@ -102,6 +213,42 @@ private:
 
     /** How far we're currently scrolled, in scaled units. */
     float scrollDistance;
+
+    /** If true, only the elements within our viewport will be laid out. See
+        setIsVirtualized(). */
+    bool isVirtualized;
+
+    /** If recycling, the logical height of each item. See
+        setRecycledItems(). */
+    float logicalItemHeight;
+    /** If recycling, the scaled height of each item. */
+    float scaledItemHeight;
+
+    /** While virtualized, holds the scaled height of each element as of its
+        last measure, or UNMEASURED_HEIGHT.
+        If recycling, holds an entry for each item instead. Items that haven't
+        been measured use scaledItemHeight. */
+    std::vector<float> elementHeights;
+
+    /** While virtualized, holds the scaled distance from the start of our
+        content to the start of each element (including gaps).
+        Has 1 more entry than elements, so the last entry is the total
+        content height (plus 1 trailing gap). */
+    std::vector<float> elementOffsets;
+
+    /** The index of the first element whose following offsets are out of
+        date. If no offsets are out of date, equals elements.size(). */
+    std::size_t firstDirtyOffsetIndex;
+
+    /** The [first, last) range of elements that were arranged during the last
+        virtualized arrange pass. */
+    std::size_t firstArrangedIndex;
+    std::size_t lastArrangedIndex;
+
+    /** The actual screen size and logical width that were used to measure
+        our elements. If either changes, every element must be re-measured. */
+    ScreenResolution lastUsedScreenSize;
+    float lastUsedLogicalWidth;
 };
 
 } // namespace AUI
@@ -0,0 +1,66 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/TextRasterizer.h"
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <string>
+
+using namespace AUI;
+
+TEST_CASE("BenchmarkTextOutline", "[.][benchmark]")
+{
+    // Note: We don't ship a font, so one must be provided.
+    const char* fontPath{SDL_getenv("AUI_BENCHMARK_FONT")};
+    if (fontPath == nullptr) {
+        SKIP("Set AUI_BENCHMARK_FONT to the path of a font file to run this "
+             "benchmark.");
+    }
+
+    constexpr float FONT_SIZE{24};
+    constexpr int OUTLINE_SIZE{2};
+    std::string text{"Health: 100 / 100"};
+    SDL_Color color{255, 255, 255, 255};
+
+    TTF_Font* font{TTF_OpenFont(fontPath, FONT_SIZE)};
+    TTF_Font* outlinedFont{TTF_OpenFont(fontPath, FONT_SIZE)};
+    REQUIRE(font != nullptr);
+    REQUIRE(outlinedFont != nullptr);
+    TTF_SetFontOutline(outlinedFont, OUTLINE_SIZE);
+
+    // The old approach: render the text with a second, outlined font, then
+    // blit the regular text on top of it.
+    BENCHMARK("Outlined font + blit (two surfaces)")
+    {
+        SDL_Surface* surface{
+            TTF_RenderText_Blended(font, text.data(), text.size(), color)};
+        SDL_Surface* backgroundSurface{TTF_RenderText_Blended(
+            outlinedFont, text.data(), text.size(), {0, 0, 0, 255})};
+
+        SDL_Rect foregroundExtent{OUTLINE_SIZE, OUTLINE_SIZE, surface->w,
+                                  surface->h};
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_BLEND);
+        SDL_BlitSurface(surface, nullptr, backgroundSurface, &foregroundExtent);
+
+        int width{backgroundSurface->w};
+        SDL_DestroySurface(surface);
+        SDL_DestroySurface(backgroundSurface);
+        return width;
+    };
+
+    // The current approach: render the text once and dilate its alpha.
+    TextRasterizer::Request request{};
+    request.fontPath = fontPath;
+    request.fontSize = FONT_SIZE;
+    request.fontOutlineSize = OUTLINE_SIZE;
+    request.text = text;
+    request.color = color;
+    BENCHMARK("TextRasterizer::rasterize() (single pass)")
+    {
+        SDL_Surface* surface{TextRasterizer::rasterize(request, font)};
+        int width{surface->w};
+        SDL_DestroySurface(surface);
+        return width;
+    };
+
+    TTF_CloseFont(font);
+    TTF_CloseFont(outlinedFont);
+}
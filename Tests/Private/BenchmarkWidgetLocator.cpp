@@ -0,0 +1,229 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/Screen.h"
+#include "AUI/Image.h"
+#include "AUI/WidgetLocator.h"
+#include "AUI/GridLocatorBackend.h"
+#include "AUI/BVHLocatorBackend.h"
+#include "AUI/Internal/Log.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <algorithm>
+
+using namespace AUI;
+
+extern int SCREEN_WIDTH;
+extern int SCREEN_HEIGHT;
+
+/**
+ * A set of small widgets laid out in a grid that covers the screen.
+ */
+struct WidgetGrid {
+    /**
+     * @param withBackground  If true, a screen-sized widget will be placed
+     *                        behind the grid.
+     */
+    WidgetGrid(std::size_t widgetCount, bool withBackground = false)
+    {
+        if (withBackground) {
+            background = std::make_unique<Image>(screenExtent, "Background");
+            background->measure(screenExtent);
+        }
+
+        // Lay the widgets out in rows of 32x32 widgets.
+        const int widgetsPerRow{SCREEN_WIDTH / 32};
+        for (std::size_t i = 0; i < widgetCount; ++i) {
+            float x{static_cast<float>((i % widgetsPerRow) * 32)};
+            float y{static_cast<float>(((i / widgetsPerRow) * 32)
+                                       % (SCREEN_HEIGHT - 64))};
+            widgets.push_back(
+                std::make_unique<Image>(SDL_FRect{x, y, 32, 32}, "Image"));
+            widgets.back()->measure(screenExtent);
+        }
+    }
+
+    /**
+     * Runs a locator update, moving the first movedCount widgets into a
+     * different locator cell (or back to their original cell, if they were
+     * moved by the last update).
+     */
+    void update(WidgetLocator& locator, std::size_t movedCount)
+    {
+        if (movedCount > 0) {
+            isOffset = !isOffset;
+        }
+
+        locator.beginUpdate();
+        if (background != nullptr) {
+            background->arrange({0, 0}, screenExtent, &locator);
+        }
+        for (std::size_t i = 0; i < widgets.size(); ++i) {
+            SDL_FPoint startPosition{0, 0};
+            if ((i < movedCount) && isOffset) {
+                startPosition.y = 256;
+            }
+            widgets[i]->arrange(startPosition, screenExtent, &locator);
+        }
+        locator.endUpdate();
+    }
+
+    SDL_FRect screenExtent{0, 0, static_cast<float>(SCREEN_WIDTH),
+                           static_cast<float>(SCREEN_HEIGHT)};
+    std::unique_ptr<Image> background;
+    std::vector<std::unique_ptr<Image>> widgets;
+    bool isOffset{false};
+};
+
+/**
+ * Returns a spread of points across the screen, to query locators with.
+ */
+static std::vector<SDL_FPoint> getQueryPoints(std::size_t pointCount)
+{
+    std::vector<SDL_FPoint> points{};
+    for (std::size_t i = 0; i < pointCount; ++i) {
+        points.push_back({static_cast<float>((i * 97) % SCREEN_WIDTH),
+                          static_cast<float>((i * 61) % SCREEN_HEIGHT)});
+    }
+    return points;
+}
+
+/**
+ * Returns true if the given paths hold the same widgets.
+ */
+static bool pathsMatch(const WidgetPath& lhs, const WidgetPath& rhs)
+{
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+TEST_CASE("TestWidgetLocatorBackends")
+{
+    Screen screen{"TestScreen"};
+
+    SDL_FRect screenExtent{0, 0, static_cast<float>(SCREEN_WIDTH),
+                           static_cast<float>(SCREEN_HEIGHT)};
+    WidgetLocator gridLocator{screenExtent};
+    WidgetLocator bvhLocator{screenExtent};
+    bvhLocator.setBackend(std::make_unique<BVHLocatorBackend>());
+
+    WidgetGrid grid{1000, true};
+    grid.update(gridLocator, 0);
+    grid.update(bvhLocator, 0);
+
+    SECTION("Backends find the same paths")
+    {
+        for (const SDL_FPoint& point : getQueryPoints(500)) {
+            WidgetPath gridPath{gridLocator.getPathUnderPoint(point)};
+            WidgetPath bvhPath{bvhLocator.getPathUnderPoint(point)};
+            REQUIRE(!(gridPath.empty()));
+            REQUIRE(pathsMatch(gridPath, bvhPath));
+        }
+    }
+
+    SECTION("Backends handle moved widgets")
+    {
+        grid.update(gridLocator, 100);
+        grid.update(bvhLocator, 100);
+
+        for (const SDL_FPoint& point : getQueryPoints(500)) {
+            REQUIRE(pathsMatch(gridLocator.getPathUnderPoint(point),
+                               bvhLocator.getPathUnderPoint(point)));
+        }
+    }
+
+    SECTION("Points within the reuse extent find the same path")
+    {
+        for (WidgetLocator* locator : {&gridLocator, &bvhLocator}) {
+            for (const SDL_FPoint& point : getQueryPoints(200)) {
+                SDL_FRect reuseExtent{};
+                WidgetPath path{
+                    locator->getPathUnderPoint(point, &reuseExtent)};
+                if ((reuseExtent.w == 0) || (reuseExtent.h == 0)) {
+                    continue;
+                }
+
+                SDL_FPoint reuseCenter{(reuseExtent.x + (reuseExtent.w / 2)),
+                                       (reuseExtent.y + (reuseExtent.h / 2))};
+                REQUIRE(pathsMatch(path,
+                                   locator->getPathUnderPoint(reuseCenter)));
+            }
+        }
+    }
+}
+
+TEST_CASE("BenchmarkWidgetLocatorBackends", "[.][benchmark]")
+{
+    Screen screen{"TestScreen"};
+
+    SDL_FRect screenExtent{0, 0, static_cast<float>(SCREEN_WIDTH),
+                           static_cast<float>(SCREEN_HEIGHT)};
+    std::vector<SDL_FPoint> queryPoints{getQueryPoints(1000)};
+
+    for (std::size_t widgetCount : {100, 1000, 10000}) {
+        for (bool useBVH : {false, true}) {
+            WidgetLocator locator{screenExtent};
+            if (useBVH) {
+                locator.setBackend(std::make_unique<BVHLocatorBackend>());
+            }
+            WidgetGrid grid{widgetCount, true};
+            grid.update(locator, 0);
+
+            std::string name{(useBVH ? "BVH, " : "Grid, ")
+                             + std::to_string(widgetCount) + " widgets: "};
+
+            // Note: The BVH is rebuilt lazily, so we query once after each
+            //       update to include the rebuild.
+            BENCHMARK(name + "Insert all")
+            {
+                locator.clear();
+                grid.update(locator, 0);
+                return locator.getPathUnderPoint(queryPoints[0]).size();
+            };
+
+            BENCHMARK(name + "Update, 10% moved")
+            {
+                grid.update(locator, (widgetCount / 10));
+                return locator.getPathUnderPoint(queryPoints[0]).size();
+            };
+
+            BENCHMARK(name + "1000 point queries")
+            {
+                std::size_t hitCount{0};
+                for (const SDL_FPoint& point : queryPoints) {
+                    hitCount += locator.getPathUnderPoint(point).size();
+                }
+                return hitCount;
+            };
+        }
+    }
+}
+
+TEST_CASE("BenchmarkWidgetLocator", "[.][benchmark]")
+{
+    Screen screen{"TestScreen"};
+
+    WidgetLocator locator({0, 0, static_cast<float>(SCREEN_WIDTH),
+                           static_cast<float>(SCREEN_HEIGHT)});
+    WidgetGrid grid{2000};
+    grid.update(locator, 0);
+
+    BENCHMARK("Clear and rebuild 2000 widgets")
+    {
+        locator.clear();
+        grid.update(locator, 0);
+    };
+
+    BENCHMARK("Incremental update, 0 of 2000 widgets moved")
+    {
+        grid.update(locator, 0);
+    };
+
+    BENCHMARK("Incremental update, 20 of 2000 widgets moved")
+    {
+        grid.update(locator, 20);
+    };
+
+    BENCHMARK("Incremental update, 2000 of 2000 widgets moved")
+    {
+        grid.update(locator, 2000);
+    };
+}
@@ -0,0 +1,81 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/Screen.h"
+#include "AUI/Image.h"
+#include "AUI/WidgetWeakRef.h"
+#include "AUI/WidgetPath.h"
+#include "AUI/Internal/Log.h"
+#include <vector>
+#include <memory>
+
+using namespace AUI;
+
+TEST_CASE("BenchmarkWidgetWeakRef", "[.][benchmark]")
+{
+    Screen screen{"TestScreen"};
+    Image widget{{0, 0, 32, 32}, "Image"};
+
+    // A large window-sized widget can end up with hundreds of refs (e.g. one
+    // per occupied locator cell). Construct and destruct them in LIFO and
+    // FIFO order.
+    BENCHMARK("Construct then destruct 500 refs to 1 widget")
+    {
+        std::vector<WidgetWeakRef> refs;
+        refs.reserve(500);
+        for (int i = 0; i < 500; ++i) {
+            refs.emplace_back(widget);
+        }
+        return refs.size();
+    };
+
+    BENCHMARK("Construct then erase 500 refs from the front")
+    {
+        std::vector<WidgetWeakRef> refs;
+        refs.reserve(500);
+        for (int i = 0; i < 500; ++i) {
+            refs.emplace_back(widget);
+        }
+        while (!(refs.empty())) {
+            refs.erase(refs.begin());
+        }
+        return refs.size();
+    };
+
+    // Copying and moving paths happens every time an event is routed.
+    WidgetPath path;
+    std::vector<std::unique_ptr<Image>> pathWidgets;
+    for (int i = 0; i < 16; ++i) {
+        pathWidgets.push_back(
+            std::make_unique<Image>(SDL_FRect{0, 0, 32, 32}, "Image"));
+        path.push_back(*(pathWidgets.back()));
+    }
+
+    BENCHMARK("Copy a 16-element path")
+    {
+        WidgetPath pathCopy{path};
+        return pathCopy.size();
+    };
+
+    BENCHMARK("Check validity of a 16-element path")
+    {
+        std::size_t validCount{0};
+        for (const WidgetWeakRef& ref : path) {
+            if (ref.isValid()) {
+                validCount++;
+            }
+        }
+        return validCount;
+    };
+
+    BENCHMARK("Construct and destruct 100 widgets with 1 ref each")
+    {
+        std::size_t validCount{0};
+        for (int i = 0; i < 100; ++i) {
+            Image tempWidget{{0, 0, 32, 32}, "Image"};
+            WidgetWeakRef ref{tempWidget};
+            if (ref.isValid()) {
+                validCount++;
+            }
+        }
+        return validCount;
+    };
+}
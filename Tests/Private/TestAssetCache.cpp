@@ -0,0 +1,211 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/AssetCache.h"
+#include "AUI/Core.h"
+#include "AUI/Internal/Log.h"
+#include <SDL3/SDL_timer.h>
+#include <vector>
+#include <string>
+
+using namespace AUI;
+
+/**
+ * Returns a new 16x16 texture.
+ */
+static SDL_Texture* createTestTexture()
+{
+    return SDL_CreateTexture(Core::getRenderer(), SDL_PIXELFORMAT_RGBA32,
+                             SDL_TEXTUREACCESS_STATIC, 16, 16);
+}
+
+/**
+ * Saves a 16x16 image file at the given path.
+ */
+static void saveTestImage(const char* path)
+{
+    SDL_Surface* surface{SDL_CreateSurface(16, 16, SDL_PIXELFORMAT_RGBA32)};
+    REQUIRE(surface != nullptr);
+    REQUIRE(SDL_SaveBMP(surface, path));
+    SDL_DestroySurface(surface);
+}
+
+/**
+ * Processes async loads until the texture with the given ID is no longer
+ * pending, up to 5 seconds.
+ */
+static void waitForAsyncLoad(AssetCache& assetCache,
+                             const std::string& textureID)
+{
+    Uint64 startTimeMS{SDL_GetTicks()};
+    while (assetCache.isTextureLoadPending(textureID)
+           && ((SDL_GetTicks() - startTimeMS) < 5000)) {
+        assetCache.processAsyncLoads();
+        SDL_Delay(1);
+    }
+}
+
+TEST_CASE("TestAssetCache")
+{
+    SECTION("Requests are counted")
+    {
+        AssetCache assetCache{};
+        assetCache.addTexture(createTestTexture(), "Texture");
+
+        assetCache.requestTexture("Texture", SDL_SCALEMODE_NEAREST);
+        assetCache.requestTexture("Texture", SDL_SCALEMODE_NEAREST);
+        REQUIRE(assetCache.getStats().hitCount == 2);
+        REQUIRE(assetCache.getStats().residentBytes == (16 * 16 * 4));
+    }
+
+    SECTION("Replacing a texture updates the resident bytes")
+    {
+        AssetCache assetCache{};
+        assetCache.addTexture(createTestTexture(), "Texture");
+        assetCache.addTexture(createTestTexture(), "Texture");
+        REQUIRE(assetCache.getStats().residentBytes == (16 * 16 * 4));
+    }
+
+    SECTION("Added textures are never pruned")
+    {
+        AssetCache assetCache{};
+        assetCache.setMemoryBudget(1);
+        assetCache.setAutoPruneEnabled(true);
+        assetCache.addTexture(createTestTexture(), "Texture");
+
+        REQUIRE(assetCache.prune() == 0);
+        REQUIRE(assetCache.getStats().evictionCount == 0);
+        REQUIRE(assetCache.requestTexture("Texture", SDL_SCALEMODE_NEAREST)
+                != nullptr);
+    }
+
+    SECTION("Generated textures are shared and can be pruned")
+    {
+        AssetCache assetCache{};
+        int generateCount{0};
+        auto generateTexture{[&generateCount] {
+            generateCount++;
+            return createTestTexture();
+        }};
+
+        std::shared_ptr<SDL_Texture> texture1{
+            assetCache.requestGeneratedTexture("Generated", generateTexture)};
+        std::shared_ptr<SDL_Texture> texture2{
+            assetCache.requestGeneratedTexture("Generated", generateTexture)};
+        REQUIRE(generateCount == 1);
+        REQUIRE(texture1 == texture2);
+
+        // Generated textures are only pruned once nothing references them.
+        REQUIRE(assetCache.prune() == 0);
+        texture1 = nullptr;
+        texture2 = nullptr;
+        REQUIRE(assetCache.prune() == 1);
+        REQUIRE(assetCache.getStats().residentBytes == 0);
+    }
+
+    SECTION("Generated textures are kept within their budget")
+    {
+        AssetCache assetCache{};
+        assetCache.setGeneratedTextureBudget(0);
+
+        std::shared_ptr<SDL_Texture> texture1{
+            assetCache.requestGeneratedTexture("Generated1",
+                                               createTestTexture)};
+        REQUIRE(assetCache.getStats().evictionCount == 0);
+
+        // Unreferenced generated textures are evicted when another is
+        // generated, without needing to prune.
+        texture1 = nullptr;
+        std::shared_ptr<SDL_Texture> texture2{
+            assetCache.requestGeneratedTexture("Generated2",
+                                               createTestTexture)};
+        REQUIRE(assetCache.getStats().evictionCount == 1);
+        REQUIRE(assetCache.getStats().residentBytes == (16 * 16 * 4));
+    }
+
+    SECTION("Referenced generated textures are skipped when pruning")
+    {
+        AssetCache assetCache{};
+        assetCache.setGeneratedTextureBudget(0);
+
+        // Generate a few textures that stay in use.
+        std::vector<std::shared_ptr<SDL_Texture>> textures{};
+        for (int i = 0; i < 5; ++i) {
+            textures.push_back(assetCache.requestGeneratedTexture(
+                "Generated" + std::to_string(i), createTestTexture));
+        }
+        REQUIRE(assetCache.getStats().evictionCount == 0);
+
+        // Once one is released, it's found behind the others and evicted
+        // when another is generated.
+        textures[0] = nullptr;
+        std::shared_ptr<SDL_Texture> texture{
+            assetCache.requestGeneratedTexture("GeneratedLast",
+                                               createTestTexture)};
+        REQUIRE(assetCache.getStats().evictionCount == 1);
+        REQUIRE(assetCache.getStats().residentBytes == (5 * 16 * 16 * 4));
+    }
+
+    SECTION("Async requests for cached textures return immediately")
+    {
+        AssetCache assetCache{};
+        assetCache.addTexture(createTestTexture(), "Texture");
+
+        REQUIRE(assetCache.requestTextureAsync("Texture", SDL_SCALEMODE_NEAREST)
+                != nullptr);
+        REQUIRE(!(assetCache.isTextureLoadPending("Texture")));
+    }
+
+    SECTION("Async requests are uploaded by processAsyncLoads()")
+    {
+        const char* imagePath{"TestAssetCacheAsync.bmp"};
+        saveTestImage(imagePath);
+
+        AssetCache assetCache{};
+        REQUIRE(assetCache.requestTextureAsync(imagePath, SDL_SCALEMODE_NEAREST)
+                == nullptr);
+        REQUIRE(assetCache.isTextureLoadPending(imagePath));
+
+        // Re-requesting a pending texture shouldn't queue another load.
+        assetCache.requestTextureAsync(imagePath, SDL_SCALEMODE_NEAREST);
+        REQUIRE(assetCache.getStats().missCount == 1);
+
+        // Wait for the worker to decode the image.
+        waitForAsyncLoad(assetCache, imagePath);
+
+        REQUIRE(!(assetCache.isTextureLoadPending(imagePath)));
+        REQUIRE(!(assetCache.didTextureLoadFail(imagePath)));
+        REQUIRE(assetCache.requestTextureAsync(imagePath, SDL_SCALEMODE_NEAREST)
+                != nullptr);
+        REQUIRE(assetCache.getStats().residentBytes == (16 * 16 * 4));
+    }
+
+    SECTION("Failed async loads are reported")
+    {
+        const char* imagePath{"TestAssetCacheMissing.bmp"};
+
+        AssetCache assetCache{};
+        assetCache.requestTextureAsync(imagePath, SDL_SCALEMODE_NEAREST);
+        waitForAsyncLoad(assetCache, imagePath);
+
+        REQUIRE(!(assetCache.isTextureLoadPending(imagePath)));
+        REQUIRE(assetCache.didTextureLoadFail(imagePath));
+        REQUIRE(assetCache.getStats().residentBytes == 0);
+    }
+
+    SECTION("Async loads don't replace textures added while decoding")
+    {
+        const char* imagePath{"TestAssetCacheAsyncAdded.bmp"};
+        saveTestImage(imagePath);
+
+        AssetCache assetCache{};
+        assetCache.requestTextureAsync(imagePath, SDL_SCALEMODE_NEAREST);
+        std::shared_ptr<SDL_Texture> addedTexture{
+            assetCache.addTexture(createTestTexture(), imagePath)};
+        waitForAsyncLoad(assetCache, imagePath);
+
+        // The added texture should still be cached and pinned.
+        REQUIRE(assetCache.requestTextureAsync(imagePath, SDL_SCALEMODE_NEAREST)
+                == addedTexture);
+        addedTexture = nullptr;
+        REQUIRE(assetCache.prune() == 0);
+    }
+}
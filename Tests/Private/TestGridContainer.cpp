@@ -0,0 +1,163 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/Screen.h"
+#include "AUI/Window.h"
+#include "AUI/VerticalGridContainer.h"
+#include "AUI/HorizontalGridContainer.h"
+#include "AUI/Image.h"
+#include "AUI/Internal/Log.h"
+#include <memory>
+
+using namespace AUI;
+
+/**
+ * A window containing a vertical and a horizontal grid, each with many
+ * elements.
+ */
+class GridWindow : public Window
+{
+public:
+    GridWindow(std::size_t elementCount)
+    : Window({0, 0, 400, 400}, "GridWindow")
+    , verticalGrid{{0, 0, 400, 200}, "VerticalGrid"}
+    , horizontalGrid{{0, 200, 400, 200}, "HorizontalGrid"}
+    {
+        children.push_back(verticalGrid);
+        children.push_back(horizontalGrid);
+
+        // 4 cells fit across each grid, and 2 cells fit down.
+        verticalGrid.setNumColumns(4);
+        horizontalGrid.setNumRows(2);
+        for (std::size_t i = 0; i < elementCount; ++i) {
+            verticalGrid.push_back(std::make_unique<Image>(
+                SDL_FRect{0, 0, 100, 100}, "Element"));
+            horizontalGrid.push_back(std::make_unique<Image>(
+                SDL_FRect{0, 0, 100, 100}, "Element"));
+        }
+    }
+
+    VerticalGridContainer verticalGrid;
+    HorizontalGridContainer horizontalGrid;
+};
+
+TEST_CASE("TestGridContainer")
+{
+    Screen screen{"TestScreen"};
+
+    SECTION("Only visible cells are arranged")
+    {
+        GridWindow window{1000};
+        window.measure();
+        window.arrange();
+
+        // The first 2 rows (or columns) are visible.
+        REQUIRE(!(window.verticalGrid[7]->getIsArrangeDirty()));
+        REQUIRE(window.verticalGrid[8]->getIsArrangeDirty());
+        REQUIRE(!(window.horizontalGrid[7]->getIsArrangeDirty()));
+        REQUIRE(window.horizontalGrid[8]->getIsArrangeDirty());
+    }
+
+    SECTION("Grids with 0-sized cells don't arrange anything")
+    {
+        GridWindow window{10};
+        window.verticalGrid.setCellHeight(0);
+        window.horizontalGrid.setCellWidth(0);
+        window.measure();
+        window.arrange();
+
+        REQUIRE(window.verticalGrid[0]->getIsArrangeDirty());
+        REQUIRE(window.horizontalGrid[0]->getIsArrangeDirty());
+    }
+
+    SECTION("Offscreen elements are measured when scrolled into view")
+    {
+        GridWindow window{1000};
+        window.measure();
+        window.arrange();
+
+        // Invalidate an offscreen element. It shouldn't be measured until it
+        // becomes visible.
+        window.verticalGrid[8]->setLogicalExtent({0, 0, 50, 50});
+        window.measure();
+        window.arrange();
+        REQUIRE(window.verticalGrid[8]->getIsMeasureDirty());
+
+        window.verticalGrid.onMouseWheel(-1);
+        window.measure();
+        window.arrange();
+        REQUIRE(!(window.verticalGrid[8]->getIsMeasureDirty()));
+        REQUIRE(!(window.verticalGrid[8]->getIsArrangeDirty()));
+        REQUIRE(window.verticalGrid[8]->getScaledExtent().h
+                < window.verticalGrid[0]->getScaledExtent().h);
+    }
+
+    SECTION("Recycled items only construct enough widgets to fill the view")
+    {
+        GridWindow window{0};
+
+        std::size_t constructedCount{0};
+        std::size_t boundCount{0};
+        window.verticalGrid.setRecycledItems(
+            100000,
+            [&]() {
+                constructedCount++;
+                return std::make_unique<Image>(SDL_FRect{0, 0, 100, 100});
+            },
+            [&](Widget&, std::size_t) { boundCount++; });
+        window.measure();
+        window.arrange();
+
+        // 2 rows of 4 columns are visible.
+        REQUIRE(constructedCount == 8);
+        REQUIRE(boundCount == 8);
+        REQUIRE(window.verticalGrid.size() == 8);
+
+        // Scrolling down 1 row should only re-bind that row's widgets.
+        window.verticalGrid.onMouseWheel(-1);
+        window.measure();
+        window.arrange();
+        REQUIRE(constructedCount == 8);
+        REQUIRE(boundCount == 12);
+
+        // Refreshing should re-bind every visible widget.
+        window.verticalGrid.refreshItems();
+        window.measure();
+        window.arrange();
+        REQUIRE(boundCount == 20);
+    }
+
+    SECTION("Binding recycled items doesn't cause another layout pass")
+    {
+        GridWindow window{0};
+
+        // Bind each item by changing its widget's extent, which invalidates
+        // its layout.
+        window.verticalGrid.setRecycledItems(
+            100000,
+            [&]() {
+                return std::make_unique<Image>(SDL_FRect{0, 0, 100, 100});
+            },
+            [&](Widget& widget, std::size_t) {
+                widget.setLogicalExtent({0, 0, 100, 100});
+            });
+        window.measure();
+        window.arrange();
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(!(window.getIsArrangeDirty()));
+
+        // Scrolling binds the new row immediately, so a single layout pass
+        // should leave the window clean.
+        window.verticalGrid.onMouseWheel(-1);
+        REQUIRE(window.getIsMeasureDirty());
+        window.measure();
+        window.arrange();
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(!(window.getIsArrangeDirty()));
+
+        // Items that are bound during layout are measured in the same pass.
+        window.verticalGrid.refreshItems();
+        window.measure();
+        window.arrange();
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(!(window.getIsArrangeDirty()));
+    }
+}
@@ -0,0 +1,315 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/Screen.h"
+#include "AUI/Core.h"
+#include "AUI/Window.h"
+#include "AUI/VerticalListContainer.h"
+#include "AUI/Image.h"
+#include "AUI/Internal/Log.h"
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+using namespace AUI;
+
+/**
+ * A window containing an image and a list container, to use for testing.
+ */
+class TestWindow : public Window
+{
+public:
+    TestWindow()
+    : Window({0, 0, 400, 400}, "TestWindow")
+    , image{{0, 0, 100, 100}, "Image"}
+    , list{{0, 100, 400, 300}, "List"}
+    {
+        children.push_back(image);
+        children.push_back(list);
+    }
+
+    Image image;
+    VerticalListContainer list;
+};
+
+/**
+ * A screen with a window that's fully hidden by an opaque window above it.
+ */
+class OcclusionTestScreen : public Screen
+{
+public:
+    OcclusionTestScreen()
+    : Screen("OcclusionTestScreen")
+    , bottomWindow{}
+    , topWindow{}
+    {
+        windows.push_back(bottomWindow);
+        windows.push_back(topWindow);
+        topWindow.setOpaqueLogicalExtents({{0, 0, 400, 400}});
+    }
+
+    TestWindow bottomWindow;
+    TestWindow topWindow;
+};
+
+/**
+ * A panel holding a full-size background image.
+ */
+class TestPanel : public Widget
+{
+public:
+    TestPanel()
+    : Widget({0, 0, 400, 400}, "TestPanel")
+    , background{{0, 0, 400, 400}, "Background"}
+    {
+        children.push_back(background);
+    }
+
+    Image background;
+};
+
+/**
+ * A window whose background image is nested inside a panel.
+ */
+class PanelWindow : public Window
+{
+public:
+    PanelWindow()
+    : Window({0, 0, 400, 400}, "PanelWindow")
+    , panel{}
+    {
+        children.push_back(panel);
+    }
+
+    TestPanel panel;
+};
+
+TEST_CASE("TestLayoutInvalidation")
+{
+    Screen screen{"TestScreen"};
+
+    SECTION("New widgets start dirty")
+    {
+        TestWindow window{};
+        REQUIRE(window.getIsMeasureDirty());
+        REQUIRE(window.getIsArrangeDirty());
+    }
+
+    SECTION("Layout pass cleans the window")
+    {
+        TestWindow window{};
+        window.measure();
+        window.arrange();
+
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(!(window.getIsArrangeDirty()));
+        REQUIRE(!(window.image.getIsMeasureDirty()));
+        REQUIRE(!(window.list.getIsArrangeDirty()));
+    }
+
+    SECTION("Child setters invalidate the window")
+    {
+        TestWindow window{};
+        window.measure();
+        window.arrange();
+
+        window.image.setLogicalExtent({0, 0, 50, 50});
+        REQUIRE(window.image.getIsMeasureDirty());
+        REQUIRE(window.getIsMeasureDirty());
+        REQUIRE(window.getIsArrangeDirty());
+    }
+
+    SECTION("Visibility changes invalidate the window")
+    {
+        TestWindow window{};
+        window.measure();
+        window.arrange();
+
+        // Setting the same visibility shouldn't invalidate anything.
+        window.image.setIsVisible(true);
+        REQUIRE(!(window.getIsMeasureDirty()));
+
+        window.image.setIsVisible(false);
+        REQUIRE(window.getIsMeasureDirty());
+        window.measure();
+        window.arrange();
+
+        // Invisible widgets are skipped during layout, but must still be able
+        // to invalidate their parent when they're made visible again.
+        window.image.setIsVisible(true);
+        REQUIRE(window.getIsMeasureDirty());
+    }
+
+    SECTION("Container elements invalidate the window")
+    {
+        TestWindow window{};
+        window.measure();
+        window.arrange();
+
+        window.list.push_back(
+            std::make_unique<Image>(SDL_FRect{0, 0, 100, 50}, "Element"));
+        REQUIRE(window.getIsMeasureDirty());
+        window.measure();
+        window.arrange();
+
+        window.list[0]->setLogicalExtent({0, 0, 100, 60});
+        REQUIRE(window.list.getIsMeasureDirty());
+        REQUIRE(window.getIsMeasureDirty());
+    }
+
+    SECTION("Scrolling only invalidates the arrange pass")
+    {
+        TestWindow window{};
+        for (int i = 0; i < 10; ++i) {
+            window.list.push_back(std::make_unique<Image>(
+                SDL_FRect{0, 0, 100, 100}, "Element"));
+        }
+        window.measure();
+        window.arrange();
+
+        window.list.onMouseWheel(-1);
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(window.getIsArrangeDirty());
+    }
+
+    SECTION("Cached windows only re-render when invalidated")
+    {
+        TestWindow window{};
+        window.setIsRenderCached(true);
+        window.measure();
+        window.arrange();
+
+        // The first render fills the cache, the second re-uses it.
+        window.render();
+        window.render();
+        REQUIRE(window.getRenderCacheStats().rebuildCount == 1);
+        REQUIRE(window.getRenderCacheStats().cacheHitCount == 1);
+
+        // Visual-only changes invalidate the cache without affecting layout.
+        window.image.setAlphaMod(0.5f);
+        REQUIRE(!(window.getIsMeasureDirty()));
+        window.render();
+        REQUIRE(window.getRenderCacheStats().rebuildCount == 2);
+
+        // Layout changes invalidate it too.
+        window.image.setLogicalExtent({0, 0, 50, 50});
+        window.measure();
+        window.arrange();
+        window.render();
+        REQUIRE(window.getRenderCacheStats().rebuildCount == 3);
+    }
+
+    SECTION("Invalidation reports damage to the window")
+    {
+        TestWindow window{};
+        window.measure();
+        window.arrange();
+
+        // Clear the damage from the first layout pass.
+        std::vector<SDL_FRect> damage{};
+        window.takeDamage(damage);
+        damage.clear();
+
+        // Visual-only changes damage the widget's extent.
+        window.image.setAlphaMod(0.5f);
+        window.takeDamage(damage);
+        REQUIRE(damage.size() == 1);
+        REQUIRE(SDL_RectsEqualFloat(&(damage[0]),
+                                    &(window.image.getClippedExtent())));
+
+        // Taking the damage clears it.
+        damage.clear();
+        window.takeDamage(damage);
+        REQUIRE(damage.empty());
+
+        // Moving a widget damages its old and new extents.
+        SDL_FRect oldExtent{window.image.getClippedExtent()};
+        window.image.setLogicalExtent({50, 0, 50, 50});
+        window.measure();
+        window.arrange();
+        window.takeDamage(damage);
+        auto containsExtent = [&](const SDL_FRect& extent) {
+            return std::any_of(damage.begin(), damage.end(),
+                               [&](const SDL_FRect& damagedExtent) {
+                                   return SDL_RectsEqualFloat(&damagedExtent,
+                                                              &extent);
+                               });
+        };
+        REQUIRE(containsExtent(oldExtent));
+        REQUIRE(containsExtent(window.image.getClippedExtent()));
+    }
+
+    SECTION("Hidden windows skip their layout updates")
+    {
+        OcclusionTestScreen occlusionScreen{};
+        occlusionScreen.setOccludedLayoutSkippingEnabled(true);
+        occlusionScreen.render();
+
+        const Screen::OcclusionStats& stats{
+            occlusionScreen.getOcclusionStats()};
+        REQUIRE(stats.occludedWindowCount == 1);
+        REQUIRE(stats.skippedLayoutCount == 1);
+        REQUIRE(occlusionScreen.bottomWindow.getIsMeasureDirty());
+        REQUIRE(!(occlusionScreen.topWindow.getIsMeasureDirty()));
+
+        // Staying hidden doesn't count again.
+        std::size_t culledWidgetCount{stats.culledWidgetCount};
+        occlusionScreen.render();
+        REQUIRE(stats.occludedWindowCount == 1);
+        REQUIRE(stats.culledWidgetCount == culledWidgetCount);
+
+        // Once it's uncovered, it gets laid out.
+        occlusionScreen.topWindow.setIsVisible(false);
+        occlusionScreen.render();
+        REQUIRE(stats.occludedWindowCount == 1);
+        REQUIRE(!(occlusionScreen.bottomWindow.getIsMeasureDirty()));
+    }
+
+    SECTION("Nested images that are marked as opaque are reported")
+    {
+        PanelWindow window{};
+
+        // Give the background a texture with an alpha channel.
+        window.panel.background.setSimpleImage(
+            SDL_CreateTexture(Core::getRenderer(), SDL_PIXELFORMAT_RGBA32,
+                              SDL_TEXTUREACCESS_STATIC, 16, 16),
+            "TestLayoutInvalidationBackground");
+        window.measure();
+        window.arrange();
+
+        // Textures with an alpha channel are translucent by default.
+        std::vector<SDL_FRect> opaqueExtents{};
+        window.getOpaqueExtents(opaqueExtents);
+        REQUIRE(opaqueExtents.empty());
+
+        window.panel.background.setIsOpaque(true);
+        window.getOpaqueExtents(opaqueExtents);
+        REQUIRE(opaqueExtents.size() == 1);
+        REQUIRE(opaqueExtents[0].w == 400);
+        REQUIRE(opaqueExtents[0].h == 400);
+
+        // Changes to the image's opacity update the window's cached extents.
+        window.panel.background.setAlphaMod(0.5f);
+        opaqueExtents.clear();
+        window.getOpaqueExtents(opaqueExtents);
+        REQUIRE(opaqueExtents.empty());
+    }
+
+    SECTION("Dirty rect rendering keeps the app's draw color")
+    {
+        OcclusionTestScreen occlusionScreen{};
+        occlusionScreen.setDirtyRectRenderingEnabled(true);
+        occlusionScreen.setDirtyRectClearColor({255, 0, 0, 255});
+
+        SDL_Renderer* renderer{Core::getRenderer()};
+        SDL_SetRenderDrawColor(renderer, 10, 20, 30, 40);
+        occlusionScreen.render();
+        REQUIRE(occlusionScreen.getDamagedRects().size() == 1);
+
+        SDL_Color drawColor{};
+        SDL_GetRenderDrawColor(renderer, &drawColor.r, &drawColor.g,
+                               &drawColor.b, &drawColor.a);
+        REQUIRE(drawColor.r == 10);
+        REQUIRE(drawColor.g == 20);
+        REQUIRE(drawColor.b == 30);
+        REQUIRE(drawColor.a == 40);
+    }
+}
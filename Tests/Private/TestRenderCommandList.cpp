@@ -0,0 +1,208 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/RenderCommandList.h"
+#include "AUI/Core.h"
+#include "AUI/AssetCache.h"
+#include "AUI/Image.h"
+#include "AUI/ImageType/TiledImage.h"
+#include "AUI/Internal/Log.h"
+#include <memory>
+#include <vector>
+
+using namespace AUI;
+
+/**
+ * Returns a new 16x16 texture.
+ */
+static std::shared_ptr<SDL_Texture> createTestTexture()
+{
+    return std::shared_ptr<SDL_Texture>(
+        SDL_CreateTexture(Core::getRenderer(), SDL_PIXELFORMAT_RGBA32,
+                          SDL_TEXTUREACCESS_STATIC, 16, 16),
+        [](SDL_Texture* p) { SDL_DestroyTexture(p); });
+}
+
+TEST_CASE("TestRenderCommandList")
+{
+    std::shared_ptr<SDL_Texture> textureA{createTestTexture()};
+    std::shared_ptr<SDL_Texture> textureB{createTestTexture()};
+    SDL_FRect srcRect{0, 0, 16, 16};
+
+    SECTION("Commands are drawn immediately while batching is disabled")
+    {
+        RenderCommandList commandList{};
+        for (int i = 0; i < 10; ++i) {
+            SDL_FRect dstRect{i * 16.f, 0, 16, 16};
+            commandList.addTexturedQuad(textureA.get(), srcRect, dstRect);
+        }
+
+        REQUIRE(commandList.getStats().commandCount == 10);
+        REQUIRE(commandList.getStats().drawCallCount == 10);
+    }
+
+    SECTION("Quads that share a texture are batched")
+    {
+        RenderCommandList commandList{};
+        commandList.setBatchingEnabled(true);
+
+        // Alternate textures, without overlapping.
+        for (int i = 0; i < 100; ++i) {
+            SDL_FRect dstRect{i * 16.f, 0, 16, 16};
+            commandList.addTexturedQuad(
+                ((i % 2) == 0) ? textureA.get() : textureB.get(), srcRect,
+                dstRect);
+        }
+        commandList.addFilledRect({0, 32, 16, 16}, {255, 255, 255, 255});
+        REQUIRE(commandList.getStats().drawCallCount == 0);
+
+        commandList.flush();
+        REQUIRE(commandList.getStats().commandCount == 101);
+        REQUIRE(commandList.getStats().drawCallCount == 3);
+    }
+
+    SECTION("Overlapping quads keep their order")
+    {
+        RenderCommandList commandList{};
+        commandList.setBatchingEnabled(true);
+
+        // A, B, A all at the same position can't be merged.
+        SDL_FRect dstRect{0, 0, 16, 16};
+        commandList.addTexturedQuad(textureA.get(), srcRect, dstRect);
+        commandList.addTexturedQuad(textureB.get(), srcRect, dstRect);
+        commandList.addTexturedQuad(textureA.get(), srcRect, dstRect);
+
+        commandList.flush();
+        REQUIRE(commandList.getStats().drawCallCount == 3);
+    }
+
+    SECTION("Geometry with different clip rects isn't batched")
+    {
+        RenderCommandList commandList{};
+        commandList.setBatchingEnabled(true);
+
+        SDL_Vertex vertices[3]{{{0, 0}, {1, 1, 1, 1}, {0, 0}},
+                               {{16, 0}, {1, 1, 1, 1}, {1, 0}},
+                               {{0, 16}, {1, 1, 1, 1}, {0, 1}}};
+        int indices[3]{0, 1, 2};
+        SDL_Rect clipRectA{0, 0, 100, 100};
+        SDL_Rect clipRectB{0, 0, 50, 50};
+        commandList.addGeometry(textureA.get(), vertices, indices, {0, 0},
+                                &clipRectA);
+        commandList.addGeometry(textureA.get(), vertices, indices, {100, 0},
+                                &clipRectA);
+        commandList.addGeometry(textureA.get(), vertices, indices, {200, 0},
+                                &clipRectB);
+
+        commandList.flush();
+        REQUIRE(commandList.getStats().drawCallCount == 2);
+    }
+
+    SECTION("Culling skips extents outside the cull extent or occluded")
+    {
+        RenderCommandList commandList{};
+        SDL_FRect extent{100, 100, 50, 50};
+        REQUIRE(!(commandList.isCulled(extent)));
+
+        SDL_FRect cullExtent{0, 0, 80, 80};
+        commandList.setCullExtent(&cullExtent);
+        REQUIRE(commandList.isCulled(extent));
+        commandList.setCullExtent(nullptr);
+
+        // Only extents that are fully covered are occluded.
+        std::vector<SDL_FRect> occluders{{90, 90, 100, 100}};
+        commandList.setOccluders(occluders);
+        REQUIRE(commandList.isCulled(extent));
+        REQUIRE(!(commandList.isCulled({50, 50, 50, 50})));
+        REQUIRE(commandList.getStats().occludedCount == 1);
+
+        // Nothing is culled while culling is suspended.
+        commandList.setCullingSuspended(true);
+        REQUIRE(!(commandList.isCulled(extent)));
+    }
+
+    SECTION("Geometry nine slices are drawn as a single command")
+    {
+        Image image{{0, 0, 64, 64}};
+        image.setNineSliceImage(
+            SDL_CreateTexture(Core::getRenderer(), SDL_PIXELFORMAT_RGBA32,
+                              SDL_TEXTUREACCESS_STATIC, 16, 16),
+            "TestNineSlice", {4, 4, 4, 4},
+            NineSliceImage::RenderMode::Geometry);
+
+        // Resizing doesn't need to generate anything.
+        RenderCommandList& commandList{Core::getRenderCommandList()};
+        const AssetCache::Stats& cacheStats{Core::getAssetCache().getStats()};
+        std::size_t oldMissCount{cacheStats.missCount};
+        std::size_t oldResidentBytes{cacheStats.residentBytes};
+        for (float size : {64.f, 96.f, 128.f}) {
+            image.setLogicalExtent({0, 0, size, size});
+            image.measure({0, 0, -1, -1});
+            image.arrange({0, 0}, {0, 0, 1920, 1080}, nullptr);
+            REQUIRE(image.getCurrentTexture() == nullptr);
+            REQUIRE(cacheStats.missCount == oldMissCount);
+            REQUIRE(cacheStats.residentBytes == oldResidentBytes);
+
+            std::size_t oldCommandCount{commandList.getStats().commandCount};
+            image.render({0, 0});
+            REQUIRE(commandList.getStats().commandCount
+                    == (oldCommandCount + 1));
+        }
+    }
+
+    SECTION("Tiled images are drawn as a single command")
+    {
+        Image image{{0, 0, 1000, 1000}};
+        image.setTiledImage(
+            SDL_CreateTexture(Core::getRenderer(), SDL_PIXELFORMAT_RGBA32,
+                              SDL_TEXTUREACCESS_STATIC, 16, 16),
+            "TestTiled");
+
+        // Sizing the image doesn't need to generate anything.
+        const AssetCache::Stats& cacheStats{Core::getAssetCache().getStats()};
+        std::size_t oldMissCount{cacheStats.missCount};
+        std::size_t oldResidentBytes{cacheStats.residentBytes};
+        image.measure({0, 0, -1, -1});
+        REQUIRE(image.getCurrentTexture() == nullptr);
+        REQUIRE(cacheStats.missCount == oldMissCount);
+        REQUIRE(cacheStats.residentBytes == oldResidentBytes);
+
+        // Partially clip the image.
+        image.arrange({0, 0}, {100, 100, 50, 50}, nullptr);
+
+        RenderCommandList& commandList{Core::getRenderCommandList()};
+        std::size_t oldCommandCount{commandList.getStats().commandCount};
+        image.render({0, 0});
+        REQUIRE(commandList.getStats().commandCount == (oldCommandCount + 1));
+    }
+
+    SECTION("Tiled images only draw the visible tiles")
+    {
+        Core::getAssetCache().addTexture(
+            SDL_CreateTexture(Core::getRenderer(), SDL_PIXELFORMAT_RGBA32,
+                              SDL_TEXTUREACCESS_STATIC, 16, 16),
+            "TestTiledGeometry");
+        TiledImage tiledImage{};
+        tiledImage.set("TestTiledGeometry", {0, 0, 1000, 1000});
+
+        // The 50x50 region starts and ends partway through 16x16 tiles, so
+        // it should be covered by 4x4 tiles (4 vertices each).
+        tiledImage.render({0, 0, 1000, 1000}, {100, 100, 50, 50}, 1.f);
+        const std::vector<SDL_Vertex>& vertices{tiledImage.getVertices()};
+        REQUIRE(vertices.size() == (16 * 4));
+
+        // The top left tile starts at 96, so its first 4px are clipped.
+        REQUIRE(vertices[0].position.x == 100);
+        REQUIRE(vertices[0].position.y == 100);
+        REQUIRE(vertices[0].tex_coord.x == 0.25f);
+        REQUIRE(vertices[0].tex_coord.y == 0.25f);
+        REQUIRE(vertices[2].tex_coord.x == 1.f);
+        REQUIRE(vertices[2].tex_coord.y == 1.f);
+
+        // The bottom right tile starts at 144, so only its first 6px are
+        // drawn.
+        const SDL_Vertex& bottomRight{vertices[vertices.size() - 2]};
+        REQUIRE(bottomRight.position.x == 150);
+        REQUIRE(bottomRight.position.y == 150);
+        REQUIRE(bottomRight.tex_coord.x == (6.f / 16.f));
+        REQUIRE(bottomRight.tex_coord.y == (6.f / 16.f));
+    }
+}
@@ -0,0 +1,161 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/Screen.h"
+#include "AUI/Window.h"
+#include "AUI/Image.h"
+#include "AUI/Internal/Log.h"
+#include <vector>
+
+using namespace AUI;
+
+/**
+ * Returns a mouse motion event at the given position.
+ */
+static SDL_Event createMotionEvent(float x, float y, float xrel, float yrel)
+{
+    SDL_Event event{};
+    event.type = SDL_EVENT_MOUSE_MOTION;
+    event.motion.x = x;
+    event.motion.y = y;
+    event.motion.xrel = xrel;
+    event.motion.yrel = yrel;
+    return event;
+}
+
+/**
+ * A window containing 2 images, to use for hit testing.
+ */
+class HitTestWindow : public Window
+{
+public:
+    HitTestWindow()
+    : Window({0, 0, 400, 400}, "HitTestWindow")
+    , leftImage{{0, 0, 100, 100}, "LeftImage"}
+    , rightImage{{200, 0, 100, 100}, "RightImage"}
+    {
+        children.push_back(leftImage);
+        children.push_back(rightImage);
+    }
+
+    Image leftImage;
+    Image rightImage;
+};
+
+/**
+ * A screen containing a HitTestWindow.
+ */
+class HitTestScreen : public Screen
+{
+public:
+    HitTestScreen()
+    : Screen("HitTestScreen")
+    , window{}
+    {
+        windows.push_back(window);
+        window.measure();
+        window.arrange();
+    }
+
+    /**
+     * Moves the mouse to the given position and returns the number of full
+     * hit test lookups that it caused.
+     */
+    std::size_t moveMouse(float x, float y)
+    {
+        std::size_t lookupCount{getHitTestStats().fullLookupCount};
+        SDL_Event event{createMotionEvent(x, y, 0, 0)};
+        handleOSEvent(event);
+        return (getHitTestStats().fullLookupCount - lookupCount);
+    }
+
+    HitTestWindow window;
+};
+
+TEST_CASE("TestScreenEvents")
+{
+    Screen screen{"TestScreen"};
+
+    SECTION("Consecutive motion events are coalesced")
+    {
+        std::vector<SDL_Event> events{};
+        for (int i = 0; i < 5; ++i) {
+            events.push_back(createMotionEvent(i * 2.f, 0, 2, 0));
+        }
+
+        std::vector<SDL_Event> unconsumedEvents{};
+        screen.handleOSEvents(events, &unconsumedEvents);
+        REQUIRE(screen.getCoalescedEventCount() == 4);
+
+        // The last event should be handled, with the run's total motion.
+        REQUIRE(unconsumedEvents.size() == 1);
+        REQUIRE(unconsumedEvents[0].motion.x == 8);
+        REQUIRE(unconsumedEvents[0].motion.xrel == 10);
+    }
+
+    SECTION("Other events end a run of motion events")
+    {
+        std::vector<SDL_Event> events{};
+        events.push_back(createMotionEvent(0, 0, 0, 0));
+        events.push_back(createMotionEvent(1, 0, 1, 0));
+
+        SDL_Event wheelEvent{};
+        wheelEvent.type = SDL_EVENT_MOUSE_WHEEL;
+        events.push_back(wheelEvent);
+
+        events.push_back(createMotionEvent(2, 0, 1, 0));
+        events.push_back(createMotionEvent(3, 0, 1, 0));
+
+        std::vector<SDL_Event> unconsumedEvents{};
+        screen.handleOSEvents(events, &unconsumedEvents);
+        REQUIRE(screen.getCoalescedEventCount() == 2);
+
+        // Order should be kept.
+        REQUIRE(unconsumedEvents.size() == 3);
+        REQUIRE(unconsumedEvents[0].motion.x == 1);
+        REQUIRE(unconsumedEvents[1].type == SDL_EVENT_MOUSE_WHEEL);
+        REQUIRE(unconsumedEvents[2].motion.x == 3);
+    }
+
+    SECTION("Hit tests are cached while the hovered path can't change")
+    {
+        HitTestScreen hitTestScreen{};
+        REQUIRE(hitTestScreen.moveMouse(10, 10) == 1);
+
+        // Still within the left image.
+        REQUIRE(hitTestScreen.moveMouse(20, 20) == 0);
+        REQUIRE(hitTestScreen.getHitTestStats().cacheHitCount > 0);
+
+        // Leaving the left image requires a new lookup. After that, moving
+        // around in the gap between the images is cached.
+        REQUIRE(hitTestScreen.moveMouse(150, 10) == 1);
+        REQUIRE(hitTestScreen.moveMouse(160, 10) == 0);
+
+        // Entering the right image requires a new lookup.
+        REQUIRE(hitTestScreen.moveMouse(210, 10) == 1);
+    }
+
+    SECTION("Re-arranging an unchanged window keeps the hit test cache")
+    {
+        HitTestScreen hitTestScreen{};
+        REQUIRE(hitTestScreen.moveMouse(10, 10) == 1);
+
+        hitTestScreen.window.measure();
+        hitTestScreen.window.arrange();
+
+        std::size_t cacheHitCount{
+            hitTestScreen.getHitTestStats().cacheHitCount};
+        REQUIRE(hitTestScreen.moveMouse(20, 20) == 0);
+        REQUIRE(hitTestScreen.getHitTestStats().cacheHitCount
+                > cacheHitCount);
+    }
+
+    SECTION("Layout changes invalidate the hit test cache")
+    {
+        HitTestScreen hitTestScreen{};
+        REQUIRE(hitTestScreen.moveMouse(10, 10) == 1);
+
+        hitTestScreen.window.leftImage.setLogicalExtent({0, 0, 50, 50});
+        hitTestScreen.window.measure();
+        hitTestScreen.window.arrange();
+        REQUIRE(hitTestScreen.moveMouse(10, 10) == 1);
+    }
+}
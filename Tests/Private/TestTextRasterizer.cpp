@@ -0,0 +1,161 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/TextRasterizer.h"
+#include <SDL3/SDL_timer.h>
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+using namespace AUI;
+
+/**
+ * Waits for the given job to finish, up to 5 seconds.
+ */
+static void waitForJob(TextRasterizer& textRasterizer,
+                       TextRasterizer::JobID jobID)
+{
+    Uint64 startTimeMS{SDL_GetTicks()};
+    while (!(textRasterizer.isJobComplete(jobID))
+           && ((SDL_GetTicks() - startTimeMS) < 5000)) {
+        SDL_Delay(1);
+    }
+}
+
+/**
+ * Returns the number of pixels in the given surface that aren't fully
+ * transparent.
+ */
+static int countVisiblePixels(SDL_Surface* surface)
+{
+    int visibleCount{0};
+    for (int y = 0; y < surface->h; ++y) {
+        for (int x = 0; x < surface->w; ++x) {
+            Uint8 r{0};
+            Uint8 g{0};
+            Uint8 b{0};
+            Uint8 a{0};
+            REQUIRE(SDL_ReadSurfacePixel(surface, x, y, &r, &g, &b, &a));
+            if (a != 0) {
+                visibleCount++;
+            }
+        }
+    }
+
+    return visibleCount;
+}
+
+TEST_CASE("TestTextRasterizer")
+{
+    // Note: We don't have a font to test with, so these jobs all fail to
+    //       load their font. They should still finish.
+    std::mutex fontMutex{};
+    TextRasterizer textRasterizer{fontMutex};
+    TextRasterizer::Request request{};
+    request.fontPath = "TestTextRasterizerMissingFont.ttf";
+    request.fontSize = 12;
+    request.text = "Test";
+
+    SECTION("Jobs finish even if their font fails to load")
+    {
+        TextRasterizer::JobID jobID{
+            textRasterizer.requestRasterization(request)};
+        waitForJob(textRasterizer, jobID);
+
+        SDL_Surface* surface{nullptr};
+        REQUIRE(textRasterizer.takeResult(jobID, surface));
+        REQUIRE(surface == nullptr);
+
+        // Results can only be taken once.
+        REQUIRE(!(textRasterizer.takeResult(jobID, surface)));
+    }
+
+    SECTION("Cancelled jobs never produce a result")
+    {
+        TextRasterizer::JobID cancelledJobID{
+            textRasterizer.requestRasterization(request)};
+        textRasterizer.cancelJob(cancelledJobID);
+
+        TextRasterizer::JobID jobID{
+            textRasterizer.requestRasterization(request)};
+        waitForJob(textRasterizer, jobID);
+
+        REQUIRE(textRasterizer.isJobComplete(jobID));
+        REQUIRE(!(textRasterizer.isJobComplete(cancelledJobID)));
+    }
+
+    SECTION("Workers keep running after being told to close a font")
+    {
+        // Closing a font before the workers are started does nothing.
+        textRasterizer.closeFont(request.fontPath, request.fontSize);
+
+        TextRasterizer::JobID jobID{
+            textRasterizer.requestRasterization(request)};
+        waitForJob(textRasterizer, jobID);
+        REQUIRE(textRasterizer.isJobComplete(jobID));
+
+        // Wake the workers to close the font, then make sure they still
+        // pick up new jobs.
+        textRasterizer.closeFont(request.fontPath, request.fontSize);
+        jobID = textRasterizer.requestRasterization(request);
+        waitForJob(textRasterizer, jobID);
+        REQUIRE(textRasterizer.isJobComplete(jobID));
+    }
+}
+
+TEST_CASE("TestTextRasterizerWithFont")
+{
+    // Note: We don't ship a font, so one must be provided.
+    const char* fontPath{SDL_getenv("AUI_BENCHMARK_FONT")};
+    if (fontPath == nullptr) {
+        SKIP("Set AUI_BENCHMARK_FONT to the path of a font file to run this "
+             "test.");
+    }
+
+    std::mutex fontMutex{};
+    TextRasterizer textRasterizer{fontMutex};
+    TextRasterizer::Request request{};
+    request.fontPath = fontPath;
+    request.fontSize = 24;
+    request.text = "Test";
+    request.color = {255, 255, 255, 255};
+
+    TTF_Font* font{TTF_OpenFont(fontPath, request.fontSize)};
+    REQUIRE(font != nullptr);
+
+    // Render the text immediately.
+    SDL_Surface* surface{TextRasterizer::rasterize(request, font)};
+    REQUIRE(surface != nullptr);
+    REQUIRE(surface->w > 0);
+    REQUIRE(surface->h > 0);
+    int visibleCount{countVisiblePixels(surface)};
+    REQUIRE(visibleCount > 0);
+
+    SECTION("Outlines grow the surface and cover more pixels")
+    {
+        TextRasterizer::Request outlinedRequest{request};
+        outlinedRequest.fontOutlineSize = 2;
+        SDL_Surface* outlinedSurface{
+            TextRasterizer::rasterize(outlinedRequest, font)};
+        REQUIRE(outlinedSurface != nullptr);
+        REQUIRE(outlinedSurface->w == (surface->w + 4));
+        REQUIRE(outlinedSurface->h == (surface->h + 4));
+        REQUIRE(countVisiblePixels(outlinedSurface) > visibleCount);
+        SDL_DestroySurface(outlinedSurface);
+    }
+
+    SECTION("Async jobs match immediate rendering")
+    {
+        TextRasterizer::JobID jobID{
+            textRasterizer.requestRasterization(request)};
+        waitForJob(textRasterizer, jobID);
+
+        SDL_Surface* asyncSurface{nullptr};
+        REQUIRE(textRasterizer.takeResult(jobID, asyncSurface));
+        REQUIRE(asyncSurface != nullptr);
+        REQUIRE(asyncSurface->w == surface->w);
+        REQUIRE(asyncSurface->h == surface->h);
+        REQUIRE(countVisiblePixels(asyncSurface) == visibleCount);
+        SDL_DestroySurface(asyncSurface);
+    }
+
+    SDL_DestroySurface(surface);
+    TTF_CloseFont(font);
+}
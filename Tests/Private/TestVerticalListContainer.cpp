@@ -0,0 +1,223 @@
+#include "catch2/catch_all.hpp"
+#include "AUI/Screen.h"
+#include "AUI/Window.h"
+#include "AUI/VerticalListContainer.h"
+#include "AUI/Image.h"
+#include "AUI/Internal/Log.h"
+#include <memory>
+#include <algorithm>
+
+using namespace AUI;
+
+/**
+ * A window containing a virtualized list with many elements.
+ */
+class VirtualizedListWindow : public Window
+{
+public:
+    VirtualizedListWindow(std::size_t elementCount)
+    : Window({0, 0, 400, 400}, "VirtualizedListWindow")
+    , list{{0, 0, 400, 300}, "List"}
+    {
+        children.push_back(list);
+
+        list.setIsVirtualized(true);
+        for (std::size_t i = 0; i < elementCount; ++i) {
+            list.push_back(std::make_unique<Image>(SDL_FRect{0, 0, 100, 50},
+                                                   "Element"));
+        }
+    }
+
+    VerticalListContainer list;
+};
+
+TEST_CASE("TestVirtualizedVerticalListContainer")
+{
+    Screen screen{"TestScreen"};
+
+    SECTION("Only visible elements are arranged")
+    {
+        VirtualizedListWindow window{1000};
+        window.measure();
+        window.arrange();
+
+        // Every element gets measured once, so we know the content height.
+        REQUIRE(!(window.list[999]->getIsMeasureDirty()));
+
+        // Only the elements near the viewport get arranged.
+        REQUIRE(!(window.list[0]->getIsArrangeDirty()));
+        REQUIRE(window.list[500]->getIsArrangeDirty());
+        REQUIRE(window.list[999]->getIsArrangeDirty());
+    }
+
+    SECTION("Scrolling arranges newly visible elements")
+    {
+        VirtualizedListWindow window{1000};
+        window.measure();
+        window.arrange();
+
+        // Scroll down a bunch.
+        for (int i = 0; i < 100; ++i) {
+            window.list.onMouseWheel(-1);
+        }
+        window.arrange();
+
+        REQUIRE(window.list[999]->getIsArrangeDirty());
+        REQUIRE(!(window.list.getIsArrangeDirty()));
+    }
+
+    SECTION("Changed elements are re-measured")
+    {
+        VirtualizedListWindow window{1000};
+        window.measure();
+        window.arrange();
+
+        window.list[0]->setLogicalExtent({0, 0, 100, 80});
+        REQUIRE(window.getIsMeasureDirty());
+        window.measure();
+        REQUIRE(!(window.list[0]->getIsMeasureDirty()));
+
+        // Erasing elements shouldn't leave stale state behind.
+        window.list.erase(window.list.begin(), window.list.begin() + 500);
+        window.measure();
+        window.arrange();
+        REQUIRE(window.list.size() == 500);
+        REQUIRE(!(window.list[0]->getIsArrangeDirty()));
+    }
+}
+
+TEST_CASE("TestRecycledVerticalListContainer")
+{
+    Screen screen{"TestScreen"};
+
+    // Sets up the given window's list to recycle 50px tall items.
+    std::size_t constructedCount{0};
+    std::size_t boundCount{0};
+    auto setRecycledItems = [&](VirtualizedListWindow& window,
+                                std::size_t itemCount) {
+        window.list.setRecycledItems(
+            itemCount, 50,
+            [&]() {
+                constructedCount++;
+                return std::make_unique<Image>(SDL_FRect{0, 0, 100, 50});
+            },
+            [&](Widget& widget, std::size_t) {
+                boundCount++;
+                widget.setLogicalExtent({0, 0, 100, 50});
+            });
+    };
+
+    SECTION("Recycled items only construct enough widgets to fill the view")
+    {
+        VirtualizedListWindow window{0};
+        setRecycledItems(window, 100000);
+        window.measure();
+        window.arrange();
+
+        // 6 items fit in the viewport. We construct 1 extra for partial
+        // items, plus the overscan at each end.
+        REQUIRE(constructedCount == 11);
+        REQUIRE(window.list.size() == 11);
+
+        // The 6 visible items plus the overscan below them are bound.
+        REQUIRE(boundCount == 8);
+
+        // Scrolling down 150px should only bind the newly visible items.
+        for (int i = 0; i < 10; ++i) {
+            window.list.onMouseWheel(-1);
+        }
+        window.measure();
+        window.arrange();
+        REQUIRE(constructedCount == 11);
+        REQUIRE(boundCount == 11);
+    }
+
+    SECTION("Binding recycled items doesn't cause another layout pass")
+    {
+        VirtualizedListWindow window{0};
+        setRecycledItems(window, 100000);
+        window.measure();
+        window.arrange();
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(!(window.getIsArrangeDirty()));
+
+        // Scrolling binds the new items immediately, so a single layout pass
+        // should leave the window clean.
+        for (int i = 0; i < 10; ++i) {
+            window.list.onMouseWheel(-1);
+        }
+        REQUIRE(window.getIsMeasureDirty());
+        window.measure();
+        window.arrange();
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(!(window.getIsArrangeDirty()));
+    }
+
+    SECTION("Items that are shorter than the estimate still fill the view")
+    {
+        // Items are 25px tall, but are estimated at 50px. The binder doesn't
+        // invalidate the widgets, so we rely on binding to measure them.
+        VirtualizedListWindow window{0};
+        window.list.setRecycledItems(
+            100000, 50,
+            [&]() {
+                constructedCount++;
+                return std::make_unique<Image>(SDL_FRect{0, 0, 100, 25});
+            },
+            [&](Widget&, std::size_t) { boundCount++; });
+
+        // Returns the bottom of the lowest element that was just arranged.
+        auto calcArrangedBottom = [&]() {
+            float bottom{0};
+            for (std::unique_ptr<Widget>& element : window.list) {
+                if (!(element->getIsArrangeDirty())) {
+                    const SDL_FRect& extent{element->getFullExtent()};
+                    bottom = std::max(bottom, (extent.y + extent.h));
+                }
+            }
+            return bottom;
+        };
+
+        // 12 items fit in the viewport, so the pool should grow to hold them
+        // and the overscan below them.
+        window.measure();
+        window.arrange();
+        REQUIRE(window.list.size() >= 14);
+        REQUIRE(calcArrangedBottom() >= 300);
+
+        // Scrolling re-binds widgets to items that haven't been measured.
+        for (int i = 0; i < 20; ++i) {
+            window.list.onMouseWheel(-1);
+        }
+        window.measure();
+        window.arrange();
+        REQUIRE(calcArrangedBottom() >= 300);
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(!(window.getIsArrangeDirty()));
+    }
+
+    SECTION("Changing the item count re-binds the visible items")
+    {
+        VirtualizedListWindow window{0};
+        setRecycledItems(window, 100000);
+        window.measure();
+        window.arrange();
+
+        for (int i = 0; i < 10; ++i) {
+            window.list.onMouseWheel(-1);
+        }
+        window.measure();
+        window.arrange();
+
+        // Shrink the list so it no longer fills the viewport. The scroll
+        // should be reset and only the remaining items should be bound.
+        std::size_t oldBoundCount{boundCount};
+        window.list.setItemCount(2);
+        window.measure();
+        window.arrange();
+        REQUIRE(window.list.getItemCount() == 2);
+        REQUIRE(boundCount == (oldBoundCount + 2));
+        REQUIRE(!(window.getIsMeasureDirty()));
+        REQUIRE(!(window.getIsArrangeDirty()));
+    }
+}
@@ -4,7 +4,9 @@
 #include "AUI/VerticalGridContainer.h"
 #include "AUI/Image.h"
 #include "AUI/WidgetLocator.h"
+#include "AUI/GridLocatorBackend.h"
 #include "AUI/Internal/Log.h"
+#include <vector>
 #include <memory>
 
 using namespace AUI;
@@ -15,7 +17,7 @@ extern int SCREEN_HEIGHT;
 class TestWidget : public Widget
 {
 public:
-    TestWidget(const SDL_Rect& inLogicalExtent,
+    TestWidget(const SDL_FRect& inLogicalExtent,
                const std::string& inDebugName = "")
     : Widget(inLogicalExtent, inDebugName)
     , image{{0, 0, (inLogicalExtent.w / 2), (inLogicalExtent.h / 2)},
@@ -44,7 +46,7 @@ class TestWidgetParent : public Widget
 {
 public:
     TestWidgetParent()
-    : Widget({200, 200, 400, 400}, "TestWidgetParent")
+    : Widget({0, 0, 400, 400}, "TestWidgetParent")
     , widgetContainer({0, 0, 200, 200}, "GridContainer")
     {
         children.push_back(widgetContainer);
@@ -54,11 +56,11 @@ public:
         widgetContainer.setNumColumns(3);
 
         widgetContainer.push_back(std::make_unique<TestWidget>(
-            SDL_Rect{0, 0, 100, 100}, "Widget1"));
+            SDL_FRect{0, 0, 100, 100}, "Widget1"));
         widgetContainer.push_back(std::make_unique<TestWidget>(
-            SDL_Rect{0, 0, 100, 100}, "Widget2"));
+            SDL_FRect{0, 0, 100, 100}, "Widget2"));
         widgetContainer.push_back(std::make_unique<TestWidget>(
-            SDL_Rect{0, 0, 100, 100}, "Widget3"));
+            SDL_FRect{0, 0, 100, 100}, "Widget3"));
     }
 
     virtual ~TestWidgetParent() {}
@@ -66,17 +68,82 @@ public:
     VerticalGridContainer widgetContainer;
 };
 
+/**
+ * Runs a layout pass on the given widget, adding it to the given locator.
+ *
+ * @param availableExtent The window-relative extent to lay the widget out in.
+ */
+static void layOutWidget(Widget& widget, const SDL_FRect& availableExtent,
+                         WidgetLocator& widgetLocator)
+{
+    widget.measure(availableExtent);
+    widget.arrange({0, 0}, availableExtent, &widgetLocator);
+}
+
+/**
+ * A set of small images laid out in rows, used to test incremental locator
+ * updates.
+ */
+struct LocatorTestImages {
+    LocatorTestImages(std::size_t imageCount)
+    {
+        // Lay the images out in rows of 32x32 images.
+        const int imagesPerRow{SCREEN_WIDTH / 32};
+        for (std::size_t i = 0; i < imageCount; ++i) {
+            float x{static_cast<float>((i % imagesPerRow) * 32)};
+            float y{static_cast<float>(((i / imagesPerRow) * 32)
+                                       % (SCREEN_HEIGHT - 64))};
+            widgets.push_back(
+                std::make_unique<Image>(SDL_FRect{x, y, 32, 32}, "Image"));
+            widgets.back()->measure(screenExtent);
+        }
+    }
+
+    /**
+     * Runs a locator update, moving the first movedCount images into a
+     * different locator cell (or back to their original cell, if they were
+     * moved by the last update).
+     */
+    void update(WidgetLocator& locator, std::size_t movedCount)
+    {
+        if (movedCount > 0) {
+            isOffset = !isOffset;
+        }
+
+        locator.beginUpdate();
+        for (std::size_t i = 0; i < widgets.size(); ++i) {
+            SDL_FPoint startPosition{0, 0};
+            if ((i < movedCount) && isOffset) {
+                startPosition.y = 256;
+            }
+            widgets[i]->arrange(startPosition, screenExtent, &locator);
+        }
+        locator.endUpdate();
+    }
+
+    SDL_FRect screenExtent{0, 0, static_cast<float>(SCREEN_WIDTH),
+                           static_cast<float>(SCREEN_HEIGHT)};
+    std::vector<std::unique_ptr<Image>> widgets;
+    bool isOffset{false};
+};
+
 TEST_CASE("TestWidgetLocator")
 {
     Screen screen{"TestScreen"};
 
+    // Note: Widget extents are relative to the locator's window, while hit
+    //       test points are in screen space.
+    SDL_FRect windowExtent{0, 0, 400, 400};
+
     SECTION("Grid cell extent")
     {
         WidgetLocator widgetLocator({200, 200, 400, 400});
 
-        SDL_Rect gridCellExtent{widgetLocator.getGridCellExtent()};
-        REQUIRE(gridCellExtent.x == 1);
-        REQUIRE(gridCellExtent.y == 1);
+        GridLocatorBackend& backend{
+            static_cast<GridLocatorBackend&>(widgetLocator.getBackend())};
+        SDL_Rect gridCellExtent{backend.getGridCellExtent()};
+        REQUIRE(gridCellExtent.x == 0);
+        REQUIRE(gridCellExtent.y == 0);
         REQUIRE(gridCellExtent.w == 4);
         REQUIRE(gridCellExtent.h == 4);
     }
@@ -85,40 +152,36 @@ TEST_CASE("TestWidgetLocator")
     {
         WidgetLocator widgetLocator({200, 200, 400, 400});
 
-        Image image1{{200, 200, 400, 400}, "Image1"};
-        Image image2{{200, 200, 200, 200}, "Image2"};
-        Image image3{{200, 200, 100, 100}, "Image3"};
+        Image image1{{0, 0, 400, 400}, "Image1"};
+        Image image2{{0, 0, 200, 200}, "Image2"};
+        Image image3{{0, 0, 100, 100}, "Image3"};
 
-        // Lay out the widgets to set their renderExtent and have them add
+        // Lay out the widgets to set their clippedExtent and have them add
         // themselves to the locator.
-        image1.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
-        image2.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
-        image3.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
+        layOutWidget(image1, windowExtent, widgetLocator);
+        layOutWidget(image2, windowExtent, widgetLocator);
+        layOutWidget(image3, windowExtent, widgetLocator);
+        REQUIRE(widgetLocator.getWidgetCount() == 3);
 
         widgetLocator.removeWidget(&image1);
         widgetLocator.removeWidget(&image2);
         widgetLocator.removeWidget(&image3);
+        REQUIRE(widgetLocator.getWidgetCount() == 0);
     }
 
     SECTION("Basic widget path")
     {
         WidgetLocator widgetLocator({200, 200, 400, 400});
 
-        Image image1{{200, 200, 400, 400}, "Image1"};
-        Image image2{{200, 200, 200, 200}, "Image2"};
-        Image image3{{200, 200, 100, 100}, "Image3"};
+        Image image1{{0, 0, 400, 400}, "Image1"};
+        Image image2{{0, 0, 200, 200}, "Image2"};
+        Image image3{{0, 0, 100, 100}, "Image3"};
 
-        // Lay out the widgets to set their renderExtent and have them add
+        // Lay out the widgets to set their clippedExtent and have them add
         // themselves to the locator.
-        image1.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
-        image2.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
-        image3.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
+        layOutWidget(image1, windowExtent, widgetLocator);
+        layOutWidget(image2, windowExtent, widgetLocator);
+        layOutWidget(image3, windowExtent, widgetLocator);
 
         WidgetPath widgetPath{widgetLocator.getPathUnderPoint({210, 210})};
         REQUIRE(widgetPath.size() == 3);
@@ -130,10 +193,9 @@ TEST_CASE("TestWidgetLocator")
 
         TestWidgetParent widget{};
 
-        // Lay out the widgets to set their renderExtent and have them add
+        // Lay out the widgets to set their clippedExtent and have them add
         // themselves to the locator.
-        widget.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
+        layOutWidget(widget, windowExtent, widgetLocator);
 
         {
             WidgetPath widgetPath{widgetLocator.getPathUnderPoint({210, 210})};
@@ -151,26 +213,23 @@ TEST_CASE("TestWidgetLocator")
 
     SECTION("Widgets in 4 corners")
     {
-        WidgetLocator widgetLocator({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT});
+        SDL_FRect screenExtent{0, 0, static_cast<float>(SCREEN_WIDTH),
+                               static_cast<float>(SCREEN_HEIGHT)};
+        WidgetLocator widgetLocator(screenExtent);
 
+        float right{screenExtent.w - 200};
+        float bottom{screenExtent.h - 200};
         Image topLeft{{0, 0, 200, 200}, "TopLeft"};
-        Image topRight{{(SCREEN_WIDTH - 200), 0, 200, 200}, "TopRight"};
-        Image bottomLeft{{0, (SCREEN_HEIGHT - 200), 200, 200},
-                         "BottomLeft"};
-        Image bottomRight{
-            {(SCREEN_WIDTH - 200), (SCREEN_HEIGHT - 200), 200, 200},
-            "BottomRight"};
-
-        // Lay out the widgets to set their renderExtent and have them add
+        Image topRight{{right, 0, 200, 200}, "TopRight"};
+        Image bottomLeft{{0, bottom, 200, 200}, "BottomLeft"};
+        Image bottomRight{{right, bottom, 200, 200}, "BottomRight"};
+
+        // Lay out the widgets to set their clippedExtent and have them add
         // themselves to the locator.
-        topLeft.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                             &widgetLocator);
-        topRight.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                              &widgetLocator);
-        bottomLeft.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                                &widgetLocator);
-        bottomRight.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                                 &widgetLocator);
+        layOutWidget(topLeft, screenExtent, widgetLocator);
+        layOutWidget(topRight, screenExtent, widgetLocator);
+        layOutWidget(bottomLeft, screenExtent, widgetLocator);
+        layOutWidget(bottomRight, screenExtent, widgetLocator);
 
         {
             WidgetPath widgetPath{widgetLocator.getPathUnderPoint({50, 50})};
@@ -180,21 +239,21 @@ TEST_CASE("TestWidgetLocator")
 
         {
             WidgetPath widgetPath{
-                widgetLocator.getPathUnderPoint({(SCREEN_WIDTH - 50), 50})};
+                widgetLocator.getPathUnderPoint({(screenExtent.w - 50), 50})};
             REQUIRE(widgetPath.size() == 1);
             REQUIRE(&(widgetPath.back().get()) == &topRight);
         }
 
         {
             WidgetPath widgetPath{
-                widgetLocator.getPathUnderPoint({50, (SCREEN_HEIGHT - 50)})};
+                widgetLocator.getPathUnderPoint({50, (screenExtent.h - 50)})};
             REQUIRE(widgetPath.size() == 1);
             REQUIRE(&(widgetPath.back().get()) == &bottomLeft);
         }
 
         {
             WidgetPath widgetPath{widgetLocator.getPathUnderPoint(
-                {(SCREEN_WIDTH - 50), (SCREEN_HEIGHT - 50)})};
+                {(screenExtent.w - 50), (screenExtent.h - 50)})};
             REQUIRE(widgetPath.size() == 1);
             REQUIRE(&(widgetPath.back().get()) == &bottomRight);
         }
@@ -204,18 +263,15 @@ TEST_CASE("TestWidgetLocator")
     {
         WidgetLocator widgetLocator({200, 200, 400, 400});
 
-        Image image1{{200, 200, 400, 400}, "Image1"};
-        Image image2{{200, 200, 200, 200}, "Image2"};
-        Image image3{{200, 200, 100, 100}, "Image3"};
+        Image image1{{0, 0, 400, 400}, "Image1"};
+        Image image2{{0, 0, 200, 200}, "Image2"};
+        Image image3{{0, 0, 100, 100}, "Image3"};
 
-        // Lay out the widgets to set their renderExtent and have them add
+        // Lay out the widgets to set their clippedExtent and have them add
         // themselves to the locator.
-        image1.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
-        image2.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
-        image3.updateLayout({0, 0, SCREEN_WIDTH, SCREEN_HEIGHT},
-                            &widgetLocator);
+        layOutWidget(image1, windowExtent, widgetLocator);
+        layOutWidget(image2, windowExtent, widgetLocator);
+        layOutWidget(image3, windowExtent, widgetLocator);
 
         WidgetPath widgetPath{widgetLocator.getPathUnderPoint({210, 210})};
         REQUIRE(widgetPath.size() == 3);
@@ -228,3 +284,54 @@ TEST_CASE("TestWidgetLocator")
         REQUIRE(widgetPath2.size() == 0);
     }
 }
+
+TEST_CASE("TestWidgetLocatorIncrementalUpdate")
+{
+    Screen screen{"TestScreen"};
+
+    SECTION("Unchanged widgets aren't relocated")
+    {
+        WidgetLocator locator({0, 0, static_cast<float>(SCREEN_WIDTH),
+                               static_cast<float>(SCREEN_HEIGHT)});
+        LocatorTestImages images{1000};
+
+        // The first update adds every widget.
+        images.update(locator, 0);
+        REQUIRE(locator.getUpdateStats().addedCount == 1000);
+
+        // The second update shouldn't need to touch the images.
+        images.update(locator, 0);
+        REQUIRE(locator.getUpdateStats().addedCount == 0);
+        REQUIRE(locator.getUpdateStats().movedCount == 0);
+        REQUIRE(locator.getUpdateStats().unchangedCount == 1000);
+    }
+
+    SECTION("Only moved widgets are relocated")
+    {
+        WidgetLocator locator({0, 0, static_cast<float>(SCREEN_WIDTH),
+                               static_cast<float>(SCREEN_HEIGHT)});
+        LocatorTestImages images{1000};
+        images.update(locator, 0);
+
+        images.update(locator, 10);
+        REQUIRE(locator.getUpdateStats().movedCount == 10);
+        REQUIRE(locator.getUpdateStats().unchangedCount == 990);
+
+        // The moved widgets should be hit at their new position.
+        SDL_FPoint movedCenter{16, 256 + 16};
+        WidgetPath path{locator.getPathUnderPoint(movedCenter)};
+        REQUIRE(path.contains(images.widgets[0].get()));
+    }
+
+    SECTION("Widgets that aren't re-added are removed")
+    {
+        WidgetLocator locator({0, 0, static_cast<float>(SCREEN_WIDTH),
+                               static_cast<float>(SCREEN_HEIGHT)});
+        LocatorTestImages images{100};
+        images.update(locator, 0);
+
+        images.widgets.pop_back();
+        images.update(locator, 0);
+        REQUIRE(locator.getUpdateStats().removedCount == 1);
+    }
+}
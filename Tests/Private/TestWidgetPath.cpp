@@ -4,6 +4,7 @@
 #include "AUI/WidgetPath.h"
 #include "AUI/Internal/Log.h"
 #include <memory>
+#include <vector>
 
 using namespace AUI;
 
@@ -13,36 +14,29 @@ TEST_CASE("TestWidgetPath")
 
     // Note: We skip testing any functions that just forward to std::vector,
     //       unless there's some interesting interaction to test.
-    SECTION("Ref count updates properly.")
+    SECTION("Elements update properly.")
     {
         Button widget1{{}};
         std::unique_ptr<Widget> widget2{
-            std::make_unique<Button>(SDL_Rect{})};
+            std::make_unique<Button>(SDL_FRect{})};
         Button widget3{{}};
 
-        {
-            WidgetPath path;
-            path.push_back(widget1);
-            path.push_back(*widget2.get());
-            path.insert(path.begin() + 1, widget3);
-            REQUIRE(widget1.getRefCount() == 1);
-            REQUIRE(widget2->getRefCount() == 1);
-            REQUIRE(widget3.getRefCount() == 1);
-
-            path.erase(path.begin() + 1);
-            REQUIRE(widget1.getRefCount() == 1);
-            REQUIRE(widget2->getRefCount() == 1);
-            REQUIRE(widget3.getRefCount() == 0);
-
-            path.erase(path.end() - 1);
-            REQUIRE(widget1.getRefCount() == 1);
-            REQUIRE(widget2->getRefCount() == 0);
-            REQUIRE(widget3.getRefCount() == 0);
-        }
+        WidgetPath path;
+        path.push_back(widget1);
+        path.push_back(*widget2.get());
+        path.insert(path.begin() + 1, widget3);
+        REQUIRE(path.size() == 3);
+        REQUIRE(&(path[1].get()) == &widget3);
 
-        REQUIRE(widget1.getRefCount() == 0);
-        REQUIRE(widget2->getRefCount() == 0);
-        REQUIRE(widget3.getRefCount() == 0);
+        path.erase(path.begin() + 1);
+        REQUIRE(path.contains(&widget1));
+        REQUIRE(path.contains(widget2.get()));
+        REQUIRE(!(path.contains(&widget3)));
+
+        path.erase(path.end() - 1);
+        REQUIRE(path.contains(&widget1));
+        REQUIRE(!(path.contains(widget2.get())));
+        REQUIRE(path.size() == 1);
     }
 
     SECTION("Ref validity updates properly")
@@ -238,4 +232,29 @@ TEST_CASE("TestWidgetPath")
         path.erase(path.begin());
         REQUIRE(!(path.contains(&widget1)));
     }
+
+    SECTION("Paths can grow past their inline capacity")
+    {
+        std::vector<std::unique_ptr<Widget>> widgets;
+        WidgetPath path;
+        for (std::size_t i = 0; i < (WidgetPath::INLINE_CAPACITY * 2); ++i) {
+            widgets.push_back(std::make_unique<Button>(SDL_FRect{}));
+            path.push_back(*(widgets.back()));
+        }
+
+        // Insert at the front, then erase it.
+        Button frontWidget{{}};
+        path.insert(path.begin(), frontWidget);
+        REQUIRE(&(path.front().get()) == &frontWidget);
+        path.erase(path.begin());
+
+        // Copies and moves should keep the contents and order.
+        WidgetPath copiedPath{path};
+        WidgetPath movedPath{std::move(copiedPath)};
+        REQUIRE(movedPath.size() == widgets.size());
+        REQUIRE(copiedPath.empty());
+        for (std::size_t i = 0; i < widgets.size(); ++i) {
+            REQUIRE(&(movedPath[i].get()) == widgets[i].get());
+        }
+    }
 }
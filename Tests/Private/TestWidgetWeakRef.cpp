@@ -4,6 +4,7 @@
 #include "AUI/WidgetWeakRef.h"
 #include "AUI/Internal/Log.h"
 #include <memory>
+#include <type_traits>
 
 using namespace AUI;
 
@@ -15,80 +16,50 @@ TEST_CASE("TestWidgetWeakRef")
     {
         Button widget1{{}};
         std::unique_ptr<Widget> widget2{
-            std::make_unique<Button>(SDL_Rect{})};
-        Button widget3{{}};
-        {
-            WidgetWeakRef ref1(widget1);
-            WidgetWeakRef ref2(*widget2);
-            WidgetWeakRef ref3(widget3);
-            REQUIRE(widget1.getRefCount() == 1);
-            REQUIRE(widget2->getRefCount() == 1);
-            REQUIRE(widget3.getRefCount() == 1);
-        }
-        REQUIRE(widget1.getRefCount() == 0);
-        REQUIRE(widget2->getRefCount() == 0);
-        REQUIRE(widget3.getRefCount() == 0);
+            std::make_unique<Button>(SDL_FRect{})};
+        WidgetWeakRef ref1(widget1);
+        WidgetWeakRef ref2(*widget2);
+        REQUIRE(ref1.isValid());
+        REQUIRE(ref2.isValid());
+        REQUIRE(&(ref1.get()) == &widget1);
+        REQUIRE(&(ref2.get()) == widget2.get());
+        REQUIRE(!(ref1 == ref2));
     }
 
     SECTION("Copy construction")
     {
         Button widget1{{}};
-        {
-            WidgetWeakRef ref1(widget1);
-            REQUIRE(widget1.getRefCount() == 1);
-
-            WidgetWeakRef ref11(ref1);
-            REQUIRE(widget1.getRefCount() == 2);
-        }
-        REQUIRE(widget1.getRefCount() == 0);
-    }
-
-    SECTION("Move construction")
-    {
-        Button widget1{{}};
-        {
-            WidgetWeakRef ref1(widget1);
-            REQUIRE(widget1.getRefCount() == 1);
-
-            WidgetWeakRef ref2(std::move(ref1));
-            REQUIRE(widget1.getRefCount() == 1);
-        }
-        REQUIRE(widget1.getRefCount() == 0);
+        WidgetWeakRef ref1(widget1);
+        WidgetWeakRef ref11(ref1);
+        REQUIRE(ref11.isValid());
+        REQUIRE(ref11 == ref1);
+        REQUIRE(&(ref11.get()) == &widget1);
     }
 
     SECTION("Copy assignment")
     {
         Button widget1{{}};
+        Button widget2{{}};
         WidgetWeakRef ref1{widget1};
-        REQUIRE(widget1.getRefCount() == 1);
-
-        {
-            WidgetWeakRef ref2 = ref1;
-            WidgetWeakRef ref3 = ref2;
-            REQUIRE(widget1.getRefCount() == 3);
-        }
-        REQUIRE(widget1.getRefCount() == 1);
+        WidgetWeakRef ref2{widget2};
+
+        ref2 = ref1;
+        REQUIRE(ref2 == ref1);
+        REQUIRE(&(ref2.get()) == &widget1);
     }
 
-    SECTION("Move assignment")
+    SECTION("Refs are trivially copyable handles")
     {
-        Button widget1{{}};
-        WidgetWeakRef ref1{widget1};
-        REQUIRE(widget1.getRefCount() == 1);
-
-        {
-            WidgetWeakRef ref2 = std::move(ref1);
-            REQUIRE(widget1.getRefCount() == 1);
-        }
-        REQUIRE(widget1.getRefCount() == 0);
+        STATIC_REQUIRE(std::is_trivially_copyable_v<WidgetWeakRef>);
+        STATIC_REQUIRE(sizeof(WidgetWeakRef) == 8);
     }
 
     SECTION("Invalidate single ref")
     {
         std::unique_ptr<Widget> widget1{
-            std::make_unique<Button>(SDL_Rect{})};
+            std::make_unique<Button>(SDL_FRect{})};
         std::unique_ptr<Widget> widget2{
-            std::make_unique<Button>(SDL_Rect{})};
+            std::make_unique<Button>(SDL_FRect{})};
 
         WidgetWeakRef ref1{*widget1};
         WidgetWeakRef ref2{*widget2};
@@ -107,7 +78,7 @@ TEST_CASE("TestWidgetWeakRef")
     SECTION("Invalidate multiple refs")
     {
         std::unique_ptr<Widget> widget1{
-            std::make_unique<Button>(SDL_Rect{})};
+            std::make_unique<Button>(SDL_FRect{})};
 
         WidgetWeakRef ref1{*widget1};
         WidgetWeakRef ref2{*widget1};
@@ -121,4 +92,20 @@ TEST_CASE("TestWidgetWeakRef")
         REQUIRE(!ref2.isValid());
         REQUIRE(!ref3.isValid());
     }
+
+    SECTION("Refs to a destructed widget stay invalid when its slot is reused")
+    {
+        std::unique_ptr<Widget> widget1{
+            std::make_unique<Button>(SDL_FRect{})};
+        WidgetWeakRef ref1{*widget1};
+        widget1 = nullptr;
+
+        // The new widget will reuse widget1's registry slot.
+        std::unique_ptr<Widget> widget2{
+            std::make_unique<Button>(SDL_FRect{})};
+        WidgetWeakRef ref2{*widget2};
+        REQUIRE(!ref1.isValid());
+        REQUIRE(ref2.isValid());
+        REQUIRE(!(ref1 == ref2));
+    }
 }